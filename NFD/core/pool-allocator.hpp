@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_POOL_ALLOCATOR_HPP
+#define NFD_CORE_POOL_ALLOCATOR_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+namespace detail {
+
+/** \brief a free list of fixed-size blocks, carved from chunks that are never released
+ */
+class BlockPool : noncopyable
+{
+public:
+  explicit
+  BlockPool(size_t blockSize, size_t nBlocksPerChunk = 256)
+    : m_blockSize(std::max(blockSize, sizeof(FreeBlock)))
+    , m_nBlocksPerChunk(nBlocksPerChunk)
+    , m_freeList(nullptr)
+  {
+  }
+
+  void*
+  allocate()
+  {
+    if (m_freeList == nullptr) {
+      this->addChunk();
+    }
+    FreeBlock* block = m_freeList;
+    m_freeList = block->next;
+    return block;
+  }
+
+  void
+  deallocate(void* p)
+  {
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = m_freeList;
+    m_freeList = block;
+  }
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  void
+  addChunk()
+  {
+    char* chunk = static_cast<char*>(::operator new(m_blockSize * m_nBlocksPerChunk));
+    for (size_t i = 0; i < m_nBlocksPerChunk; ++i) {
+      this->deallocate(chunk + i * m_blockSize);
+    }
+  }
+
+private:
+  size_t m_blockSize;
+  size_t m_nBlocksPerChunk;
+  FreeBlock* m_freeList;
+};
+
+} // namespace detail
+
+/** \brief an allocator that takes single objects from a per-type pool
+ *
+ *  Freed objects go back to the pool, which never returns memory to the system, so the
+ *  pool stays as large as the peak number of live objects. Arrays use operator new.
+ *  Meant for use with allocate_shared, on objects created and destroyed at a high rate
+ *  from one thread. The pool block size is rounded up to alignof(std::max_align_t).
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+  typedef T value_type;
+
+  PoolAllocator() = default;
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U>&)
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    if (n != 1) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(getPool().allocate());
+  }
+
+  void
+  deallocate(T* p, size_t n)
+  {
+    if (n != 1) {
+      ::operator delete(p);
+      return;
+    }
+    getPool().deallocate(p);
+  }
+
+  template<typename U>
+  bool
+  operator==(const PoolAllocator<U>&) const
+  {
+    return true;
+  }
+
+  template<typename U>
+  bool
+  operator!=(const PoolAllocator<U>&) const
+  {
+    return false;
+  }
+
+private:
+  static detail::BlockPool&
+  getPool()
+  {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+    static const size_t ALIGN = alignof(std::max_align_t);
+    // never destroyed, because objects may outlive static destruction
+    static detail::BlockPool* pool =
+      new detail::BlockPool((sizeof(T) + ALIGN - 1) / ALIGN * ALIGN);
+    return *pool;
+  }
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_POOL_ALLOCATOR_HPP
@@ -0,0 +1,270 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_SMALL_VECTOR_HPP
+#define NFD_CORE_SMALL_VECTOR_HPP
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace nfd {
+
+/** \brief a sequence container that stores up to N elements inside itself
+ *  \tparam T element type, must be MoveConstructible and MoveAssignable
+ *  \tparam N number of elements stored without a heap allocation
+ *
+ *  Elements are contiguous. When more than N elements are inserted, they move to a
+ *  heap array, which grows like std::vector and is kept until the container is destroyed.
+ *  Insertions and erasures invalidate all iterators.
+ */
+template<typename T, size_t N>
+class SmallVector : noncopyable
+{
+  static_assert(N > 0, "N must be positive");
+
+public:
+  typedef T value_type;
+  typedef size_t size_type;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef T* iterator;
+  typedef const T* const_iterator;
+
+  SmallVector()
+    : m_data(reinterpret_cast<T*>(m_inline))
+    , m_size(0)
+    , m_capacity(N)
+  {
+  }
+
+  ~SmallVector()
+  {
+    this->clear();
+    if (!this->isInline()) {
+      ::operator delete(m_data);
+    }
+  }
+
+  iterator
+  begin()
+  {
+    return m_data;
+  }
+
+  const_iterator
+  begin() const
+  {
+    return m_data;
+  }
+
+  iterator
+  end()
+  {
+    return m_data + m_size;
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_data + m_size;
+  }
+
+  size_type
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  size_type
+  capacity() const
+  {
+    return m_capacity;
+  }
+
+  /** \return whether the elements are stored inside the container
+   */
+  bool
+  isInline() const
+  {
+    return m_data == reinterpret_cast<const T*>(m_inline);
+  }
+
+  reference
+  operator[](size_type i)
+  {
+    return m_data[i];
+  }
+
+  const_reference
+  operator[](size_type i) const
+  {
+    return m_data[i];
+  }
+
+  /** \brief constructs an element before pos
+   *  \return an iterator to the new element
+   */
+  template<typename ...A>
+  iterator
+  emplace(const_iterator pos, A&&... args)
+  {
+    size_type index = pos - m_data;
+    BOOST_ASSERT(index <= m_size);
+
+    if (m_size == m_capacity) {
+      return this->emplaceReallocating(index, std::forward<A>(args)...);
+    }
+
+    T* p = m_data + index;
+    if (index == m_size) {
+      new (p) T(std::forward<A>(args)...);
+    }
+    else {
+      // args may refer to an element that is about to move
+      T value(std::forward<A>(args)...);
+      new (m_data + m_size) T(std::move(m_data[m_size - 1]));
+      std::move_backward(p, m_data + m_size - 1, m_data + m_size);
+      *p = std::move(value);
+    }
+    ++m_size;
+    return p;
+  }
+
+  template<typename ...A>
+  void
+  emplace_front(A&&... args)
+  {
+    this->emplace(this->begin(), std::forward<A>(args)...);
+  }
+
+  template<typename ...A>
+  void
+  emplace_back(A&&... args)
+  {
+    this->emplace(this->end(), std::forward<A>(args)...);
+  }
+
+  /** \brief erases the element at pos
+   *  \return an iterator to the element that followed the erased element
+   */
+  iterator
+  erase(const_iterator pos)
+  {
+    T* p = m_data + (pos - m_data);
+    BOOST_ASSERT(p < this->end());
+
+    std::move(p + 1, this->end(), p);
+    m_data[--m_size].~T();
+    return p;
+  }
+
+  /** \brief erases all elements, keeping the storage
+   */
+  void
+  clear()
+  {
+    for (size_type i = 0; i < m_size; ++i) {
+      m_data[i].~T();
+    }
+    m_size = 0;
+  }
+
+  void
+  reserve(size_type capacity)
+  {
+    if (capacity <= m_capacity) {
+      return;
+    }
+
+    T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    this->moveTo(data, 0, m_size);
+    this->replaceStorage(data, capacity);
+  }
+
+private:
+  /** \brief constructs an element at index in a larger heap array and moves the others there
+   *
+   *  The new element is constructed before the old storage is released, because args may
+   *  refer to an element of this container.
+   */
+  template<typename ...A>
+  iterator
+  emplaceReallocating(size_type index, A&&... args)
+  {
+    size_type capacity = m_capacity * 2;
+    T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    try {
+      new (data + index) T(std::forward<A>(args)...);
+    }
+    catch (...) {
+      ::operator delete(data);
+      throw;
+    }
+    this->moveTo(data, 0, index);
+    this->moveTo(data + index + 1, index, m_size - index);
+    this->replaceStorage(data, capacity);
+    ++m_size;
+    return data + index;
+  }
+
+  /** \brief move-constructs n elements starting at index into dest, destroying the originals
+   */
+  void
+  moveTo(T* dest, size_type index, size_type n)
+  {
+    for (size_type i = 0; i < n; ++i) {
+      new (dest + i) T(std::move(m_data[index + i]));
+      m_data[index + i].~T();
+    }
+  }
+
+  void
+  replaceStorage(T* data, size_type capacity)
+  {
+    if (!this->isInline()) {
+      ::operator delete(m_data);
+    }
+    m_data = data;
+    m_capacity = capacity;
+  }
+
+private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_inline[N];
+  T* m_data;
+  size_type m_size;
+  size_type m_capacity;
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_SMALL_VECTOR_HPP
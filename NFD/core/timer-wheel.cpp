@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+
+namespace nfd {
+
+static_assert(TimerWheel::N_LEVELS * TimerWheel::N_SLOTS <= 0xFFFF,
+              "Timer::m_slot cannot hold all slots");
+
+const int TimerWheel::SLOT_BITS;
+const int TimerWheel::N_SLOTS;
+const int TimerWheel::N_LEVELS;
+
+static const uint64_t SLOT_MASK = TimerWheel::N_SLOTS - 1;
+static const uint64_t MAX_DELAY_TICKS = (uint64_t(1) << (TimerWheel::SLOT_BITS *
+                                                         TimerWheel::N_LEVELS)) - 1;
+
+TimerWheel::Timer::Timer()
+  : m_wheel(nullptr)
+  , m_prev(nullptr)
+  , m_next(nullptr)
+  , m_expiry(0)
+  , m_slot(0)
+{
+}
+
+TimerWheel::Timer::~Timer()
+{
+  this->cancel();
+}
+
+void
+TimerWheel::Timer::cancel()
+{
+  if (m_wheel != nullptr) {
+    m_wheel->cancel(*this);
+  }
+}
+
+TimerWheel::TimerWheel(const time::nanoseconds& tick, const ExpireCallback& expireCallback)
+  : m_tick(tick)
+  , m_expireCallback(expireCallback)
+  , m_currentTick(0)
+  , m_size(0)
+  , m_occupied()
+  , m_eventTick(0)
+  , m_nEvents(0)
+  , m_isInEvent(false)
+{
+  BOOST_ASSERT(tick >= time::microseconds(1));
+  std::fill(&m_slots[0][0], &m_slots[0][0] + N_LEVELS * N_SLOTS, nullptr);
+  m_currentTick = this->getNowTick();
+}
+
+TimerWheel::~TimerWheel()
+{
+  scheduler::cancel(m_event);
+  for (int level = 0; level < N_LEVELS; ++level) {
+    for (int slot = 0; slot < N_SLOTS; ++slot) {
+      for (Timer* timer = m_slots[level][slot]; timer != nullptr; timer = timer->m_next) {
+        timer->m_wheel = nullptr;
+      }
+    }
+  }
+}
+
+uint64_t
+TimerWheel::getNowTick() const
+{
+  return time::steady_clock::now().time_since_epoch().count() / m_tick.count();
+}
+
+void
+TimerWheel::schedule(Timer& timer, const time::nanoseconds& delay)
+{
+  timer.cancel();
+
+  uint64_t deadline = time::steady_clock::now().time_since_epoch().count() +
+                      std::max<int64_t>(delay.count(), 0);
+  uint64_t tick = m_tick.count();
+  timer.m_expiry = std::min((deadline + tick - 1) / tick, m_currentTick + MAX_DELAY_TICKS);
+  timer.m_wheel = this;
+  this->link(timer);
+  ++m_size;
+
+  // onEvent schedules the next event when it is done
+  if (!m_isInEvent && (m_event == nullptr || timer.m_expiry < m_eventTick)) {
+    this->scheduleEvent();
+  }
+}
+
+void
+TimerWheel::cancel(Timer& timer)
+{
+  if (timer.m_wheel != this) {
+    BOOST_ASSERT(timer.m_wheel == nullptr);
+    return;
+  }
+
+  this->unlink(timer);
+  timer.m_wheel = nullptr;
+  --m_size;
+
+  // an event without timers is harmless, but keeps the simulation running
+  if (m_size == 0) {
+    scheduler::cancel(m_event);
+  }
+}
+
+void
+TimerWheel::link(Timer& timer)
+{
+  int level = 0;
+  while (level < N_LEVELS - 1 &&
+         (timer.m_expiry >> (SLOT_BITS * (level + 1))) !=
+         (m_currentTick >> (SLOT_BITS * (level + 1)))) {
+    ++level;
+  }
+  int slot = static_cast<int>((timer.m_expiry >> (SLOT_BITS * level)) & SLOT_MASK);
+
+  Timer*& head = m_slots[level][slot];
+  timer.m_slot = static_cast<uint16_t>(level * N_SLOTS + slot);
+  timer.m_prev = nullptr;
+  timer.m_next = head;
+  if (head != nullptr) {
+    head->m_prev = &timer;
+  }
+  head = &timer;
+  m_occupied[level] |= uint64_t(1) << slot;
+}
+
+void
+TimerWheel::unlink(Timer& timer)
+{
+  int level = timer.m_slot / N_SLOTS;
+  int slot = timer.m_slot % N_SLOTS;
+
+  if (timer.m_prev != nullptr) {
+    timer.m_prev->m_next = timer.m_next;
+  }
+  else {
+    m_slots[level][slot] = timer.m_next;
+    if (timer.m_next == nullptr) {
+      m_occupied[level] &= ~(uint64_t(1) << slot);
+    }
+  }
+  if (timer.m_next != nullptr) {
+    timer.m_next->m_prev = timer.m_prev;
+  }
+  timer.m_prev = timer.m_next = nullptr;
+}
+
+bool
+TimerWheel::findNextTick(uint64_t& tick) const
+{
+  for (int level = 0; level < N_LEVELS; ++level) {
+    int shift = SLOT_BITS * level;
+    int current = static_cast<int>((m_currentTick >> shift) & SLOT_MASK);
+    uint64_t candidates = m_occupied[level] & (~uint64_t(0) << current);
+    if (candidates == 0) {
+      continue;
+    }
+
+    uint64_t slot = __builtin_ctzll(candidates);
+    uint64_t blockMask = (level == N_LEVELS - 1) ? 0 : ~uint64_t(0) << (shift + SLOT_BITS);
+    tick = (m_currentTick & blockMask) | (slot << shift);
+    // a timer on a lower level is due before everything above it
+    return true;
+  }
+  BOOST_ASSERT(m_size == 0);
+  return false;
+}
+
+void
+TimerWheel::scheduleEvent()
+{
+  scheduler::cancel(m_event);
+
+  uint64_t tick = 0;
+  if (!this->findNextTick(tick)) {
+    return;
+  }
+
+  m_eventTick = std::max(tick, m_currentTick);
+  time::nanoseconds eventTime(static_cast<int64_t>(m_eventTick) * m_tick.count());
+  time::nanoseconds delay = std::max(eventTime - time::steady_clock::now().time_since_epoch(),
+                                     time::nanoseconds::zero());
+  m_event = scheduler::schedule(delay, bind(&TimerWheel::onEvent, this));
+}
+
+void
+TimerWheel::onEvent()
+{
+  m_event.reset();
+  ++m_nEvents;
+  m_isInEvent = true;
+
+  m_currentTick = std::max(m_currentTick, this->getNowTick());
+
+  // move timers of the slots just reached down the levels, from the top
+  for (int level = N_LEVELS - 1; level > 0; --level) {
+    int slot = static_cast<int>((m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK);
+    while (m_slots[level][slot] != nullptr) {
+      Timer& timer = *m_slots[level][slot];
+      this->unlink(timer);
+      this->link(timer);
+    }
+  }
+
+  // expire one timer at a time: the callback may schedule or cancel any timer
+  int slot = static_cast<int>(m_currentTick & SLOT_MASK);
+  while (m_slots[0][slot] != nullptr) {
+    Timer& timer = *m_slots[0][slot];
+    BOOST_ASSERT(timer.m_expiry == m_currentTick);
+    this->unlink(timer);
+    timer.m_wheel = nullptr;
+    --m_size;
+    m_expireCallback(timer);
+  }
+
+  m_isInEvent = false;
+  this->scheduleEvent();
+}
+
+} // namespace nfd
@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_TIMER_WHEEL_HPP
+#define NFD_CORE_TIMER_WHEEL_HPP
+
+#include "common.hpp"
+#include "scheduler.hpp"
+
+namespace nfd {
+
+/** \brief a hierarchical timing wheel on top of the scheduler
+ *
+ *  Timers are intrusive: the caller embeds a Timer in the object it belongs to, so
+ *  scheduling and cancelling a timer allocates nothing. Expiry times are rounded up to a
+ *  multiple of the tick. The wheel keeps at most one scheduler event, for the earliest
+ *  tick that has work, instead of one event per timer.
+ *
+ *  Each of N_LEVELS levels has N_SLOTS slots; a timer is placed on the lowest level whose
+ *  slot range covers its expiry, and moves down a level whenever the wheel reaches its slot.
+ */
+class TimerWheel : noncopyable
+{
+public:
+  class Timer : noncopyable
+  {
+  public:
+    Timer();
+
+    /** \brief cancels the timer
+     */
+    ~Timer();
+
+    /** \return whether the timer is scheduled and has not expired
+     */
+    bool
+    isPending() const;
+
+    /** \brief cancels the timer if pending
+     */
+    void
+    cancel();
+
+  private:
+    TimerWheel* m_wheel; // null when not pending
+    Timer* m_prev;
+    Timer* m_next;
+    uint64_t m_expiry; // in ticks
+    uint16_t m_slot;   // level * N_SLOTS + slot
+
+    friend class TimerWheel;
+  };
+
+  /** \brief called when timer expires; timer is no longer pending and may be rescheduled
+   */
+  typedef function<void(Timer& timer)> ExpireCallback;
+
+  /** \param tick granularity of expiry times, at least one microsecond
+   *  \param expireCallback called for every expiring timer
+   */
+  TimerWheel(const time::nanoseconds& tick, const ExpireCallback& expireCallback);
+
+  /** \brief cancels all pending timers without invoking the callback
+   */
+  ~TimerWheel();
+
+  /** \brief schedules timer to expire after delay, rounded up to the next tick
+   *
+   *  If timer is pending on any wheel, it is rescheduled.
+   */
+  void
+  schedule(Timer& timer, const time::nanoseconds& delay);
+
+  /** \brief cancels timer if pending
+   */
+  void
+  cancel(Timer& timer);
+
+  /** \return number of pending timers
+   */
+  size_t
+  size() const;
+
+  time::nanoseconds
+  getTick() const;
+
+  /** \return number of scheduler events this wheel has run
+   */
+  uint64_t
+  getNEvents() const;
+
+public:
+  static const int SLOT_BITS = 6;
+  static const int N_SLOTS = 1 << SLOT_BITS;
+  static const int N_LEVELS = 8; // 2^48 ticks, that is 8.9 years of 1 microsecond ticks
+
+private:
+  /** \return the current tick, rounded down
+   */
+  uint64_t
+  getNowTick() const;
+
+  void
+  link(Timer& timer);
+
+  void
+  unlink(Timer& timer);
+
+  /** \brief finds the earliest tick at which a timer expires or moves down a level
+   *  \return false if no timer is pending
+   */
+  bool
+  findNextTick(uint64_t& tick) const;
+
+  /** \brief ensures the scheduler event runs at the earliest tick that has work
+   */
+  void
+  scheduleEvent();
+
+  void
+  onEvent();
+
+private:
+  time::nanoseconds m_tick;
+  ExpireCallback m_expireCallback;
+  uint64_t m_currentTick; // ticks before this one have been processed
+  size_t m_size;
+
+  Timer* m_slots[N_LEVELS][N_SLOTS];
+  uint64_t m_occupied[N_LEVELS]; // bitmap of non-empty slots
+
+  scheduler::EventId m_event;
+  uint64_t m_eventTick;
+  uint64_t m_nEvents;
+  bool m_isInEvent;
+};
+
+inline bool
+TimerWheel::Timer::isPending() const
+{
+  return m_wheel != nullptr;
+}
+
+inline size_t
+TimerWheel::size() const
+{
+  return m_size;
+}
+
+inline time::nanoseconds
+TimerWheel::getTick() const
+{
+  return m_tick;
+}
+
+inline uint64_t
+TimerWheel::getNEvents() const
+{
+  return m_nEvents;
+}
+
+} // namespace nfd
+
+#endif // NFD_CORE_TIMER_WHEEL_HPP
@@ -26,10 +26,12 @@
 #include "forwarder.hpp"
 #include "core/logger.hpp"
 #include "core/random.hpp"
+#include "core/small-vector.hpp"
 #include "strategy.hpp"
 #include "face/null-face.hpp"
 
 #include "utils/ndn-ns3-packet-tag.hpp"
+#include "utils/tracers/ndn-sit-event-log.hpp"
 
 #include <boost/random/uniform_int_distribution.hpp>
 
@@ -42,10 +44,14 @@ namespace nfd {
 
 NFD_LOG_INIT("Forwarder");
 
+using ns3::ndn::SitEventLog;
+
 using fw::Strategy;
 
 const Name Forwarder::LOCALHOST_NAME("ndn:/localhost");
 
+time::nanoseconds Forwarder::s_defaultPitTimerTick = time::nanoseconds::zero();
+
 Forwarder::Forwarder()
   : m_faceTable(*this)
   , m_fib(m_nameTree)
@@ -57,6 +63,23 @@ Forwarder::Forwarder()
 {
   fw::installStrategies(*this);
   getFaceTable().addReserved(m_csFace, FACEID_CONTENT_STORE);
+
+  if (s_defaultPitTimerTick > time::nanoseconds::zero()) {
+    m_pitTimerWheel.reset(new TimerWheel(s_defaultPitTimerTick,
+                                         bind(&Forwarder::onPitTimer, this, _1)));
+  }
+}
+
+time::nanoseconds
+Forwarder::getDefaultPitTimerTick()
+{
+  return s_defaultPitTimerTick;
+}
+
+void
+Forwarder::setDefaultPitTimerTick(const time::nanoseconds& tick)
+{
+  s_defaultPitTimerTick = std::max(tick, time::nanoseconds::zero());
 }
 
 Forwarder::~Forwarder()
@@ -117,7 +140,7 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
                 bind(&Forwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
     }
     else {
-      shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
+      shared_ptr<const Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
       if (match != nullptr) {
         this->onContentStoreHit(inFace, pitEntry, interest, *match);
       }
@@ -141,6 +164,8 @@ Forwarder::onContentStoreMiss(const Face& inFace,
   {
     NFD_LOG_DEBUG("CS Miss "<<interest.getName().at(-2).toNumber()<<"/"<<interest.getName().at(-1).toSequenceNumber()<< " DF "<<interest.getDestinationFlag());
   }
+  SitEventLog::Record(SitEventLog::CS_MISS, interest.getName(), inFace.getId(),
+                      inFace.isLocal(), interest.getDestinationFlag(), interest.getFloodFlag());
   unsigned int sdc; //scoped downstream count
 
   shared_ptr<Face> face = const_pointer_cast<Face>(inFace.shared_from_this());
@@ -204,12 +229,16 @@ Forwarder::onContentStoreHit(const Face& inFace,
   {
     NFD_LOG_INFO("CS Hit "<<interest.getName().at(-2).toNumber()<<"/"<<interest.getName().at(-1).toSequenceNumber()<< " DF 0");
   }
+  SitEventLog::Record(SitEventLog::CS_HIT, interest.getName(), inFace.getId(),
+                      inFace.isLocal(), interest.getDestinationFlag(), interest.getFloodFlag());
 
   beforeSatisfyInterest(*pitEntry, *m_csFace, data);
   this->dispatchToStrategy(pitEntry, bind(&Strategy::beforeSatisfyInterest, _1,
                                           pitEntry, cref(*m_csFace), cref(data)));
 
-  const_pointer_cast<Data>(data.shared_from_this())->setIncomingFaceId(FACEID_CONTENT_STORE);
+  // data is the cached packet itself, shared by all hits; IncomingFaceId is the only field
+  // written here, and every hit writes the same value
+  const_cast<Data&>(data).setIncomingFaceId(FACEID_CONTENT_STORE);
   // XXX should we lookup PIT for other Interests that also match csMatch?
 
   // set PIT straggler timer
@@ -395,25 +424,9 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     return;
   }
 
-  // Remove Ptr<Packet> from the Data before inserting into cache, serving two purposes
-  // - reduce amount of memory used by cached entries
-  // - remove all tags that (e.g., hop count tag) that could have been associated with Ptr<Packet>
-  //
-  // Copying of Data is relatively cheap operation, as it copies (mostly) a collection of Blocks
-  // pointing to the same underlying memory buffer.
-  shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>(data);
-  dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
-
-  // CS insert
-  //if(data.getName().size() == 3) 
-  { //don't cache mgmt data (e.g. FIB Manager)
-    if (m_csFromNdnSim == nullptr)
-      m_cs.insert(*dataCopyWithoutPacket);
-    else
-      m_csFromNdnSim->Add(dataCopyWithoutPacket);
-  }
-  std::set<shared_ptr<Face> > pendingDownstreams;
   // foreach PitEntry
+  // pending downstreams are kept sorted by FaceId, without duplicates
+  SmallVector<FaceId, 8> pendingDownstreams;
   for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
     NFD_LOG_DEBUG("onIncomingData matching=" << pitEntry->getName());
 
@@ -425,7 +438,12 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     for (pit::InRecordCollection::const_iterator it = inRecords.begin();
                                                  it != inRecords.end(); ++it) {
       if (it->getExpiry() > time::steady_clock::now()) {
-        pendingDownstreams.insert(it->getFace());
+        FaceId faceId = it->getFace()->getId();
+        FaceId* pos = std::lower_bound(pendingDownstreams.begin(), pendingDownstreams.end(),
+                                       faceId);
+        if (pos == pendingDownstreams.end() || *pos != faceId) {
+          pendingDownstreams.emplace(pos, faceId);
+        }
       }
     }
 
@@ -446,16 +464,49 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
   }
 
   // foreach pending downstream
-  for (std::set<shared_ptr<Face> >::iterator it = pendingDownstreams.begin();
-    it != pendingDownstreams.end(); ++it) 
-  {
-    shared_ptr<Face> pendingDownstream = getFace((*it)->getId());
-    if (pendingDownstream.get() == &inFace) {
+  // local faces (applications) may keep the Data after this pipeline returns
+  bool isKeptByLocalFace = inFace.isLocal();
+  for (FaceId faceId : pendingDownstreams) {
+    if (faceId == inFace.getId()) {
       continue;
     }
-      // goto outgoing Data pipeline
+    shared_ptr<Face> pendingDownstream = getFace(faceId);
+    if (pendingDownstream == nullptr) {
+      continue;
+    }
+    isKeptByLocalFace = isKeptByLocalFace || pendingDownstream->isLocal();
+    // goto outgoing Data pipeline
     this->onOutgoingData(data, *pendingDownstream);
   }
+
+  // CS insert
+  // The cached Data must not carry Ptr<Packet>, serving two purposes
+  // - reduce amount of memory used by cached entries
+  // - remove all tags that (e.g., hop count tag) that could have been associated with Ptr<Packet>
+  //
+  // Non-local faces have converted the Data to their own packets by now, so when the Data
+  // came from and went to non-local faces only, the packet is removed in place and the cache
+  // shares the received Data and its wire buffer. An application may read the packet tags
+  // after delivery (e.g., hop count), so when a local face is involved the cache gets a copy.
+  shared_ptr<const Data> dataToCache = data.shared_from_this();
+  if (data.getTag<ns3::ndn::Ns3PacketTag>() != nullptr) {
+    if (!isKeptByLocalFace) {
+      const_cast<Data&>(data).removeTag<ns3::ndn::Ns3PacketTag>();
+    }
+    else {
+      shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>(data);
+      dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
+      dataToCache = dataCopyWithoutPacket;
+    }
+  }
+
+  //if(data.getName().size() == 3)
+  { //don't cache mgmt data (e.g. FIB Manager)
+    if (m_csFromNdnSim == nullptr)
+      m_cs.insert(*dataToCache);
+    else
+      m_csFromNdnSim->Add(dataToCache);
+  }
 }
 
 void
@@ -498,6 +549,8 @@ Forwarder::onOutgoingData(const Data& data, Face& outFace)
   { 
     NFD_LOG_INFO("Data out " << data.getName().at(-2).toNumber()<<"/"<<data.getName().at(-1).toSequenceNumber());
   }
+  SitEventLog::Record(SitEventLog::DATA_OUT, data.getName(), outFace.getId(),
+                      outFace.isLocal(), false, 0);
 
   // /localhost scope control
   bool isViolatingLocalhost = !outFace.isLocal() &&
@@ -508,22 +561,12 @@ Forwarder::onOutgoingData(const Data& data, Face& outFace)
     // (drop)
     return;
   }
-  // insert SIT enrty: first lookup the name
+  // insert or refresh SIT entry
   if(data.getName().size() == 3 && !outFace.isLocal() && m_sit.getCapacity()>0)
   {
-    shared_ptr<fib::Entry> sitEntry;
-    sitEntry = m_sit.findExactMatch(data.getName());
-    if(!static_cast<bool>(sitEntry))
-    {
-      //std::cout<<"Inserting sitEntry: "<<data.getName()<<"\n";
-      sitEntry = m_sit.insert(data.getName()).first;
-    }
-    else if(static_cast<bool>(sitEntry) && !sitEntry->hasNextHops())
-    {
-      sitEntry = m_sit.insert(data.getName()).first;
-    }
-    sitEntry->addNextHop(getFace(outFace.getId()), 0);
-  }//*/
+    m_sit.recordDownstream(data.getName(), name_tree::getHashSet(data),
+                           outFace.shared_from_this());
+  }
 
   // TODO traffic manager
 
@@ -552,6 +595,11 @@ Forwarder::setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry)
     // TODO all InRecords are already expired; will this happen?
   }
 
+  if (m_pitTimerWheel != nullptr) {
+    m_pitTimerWheel->schedule(pitEntry->m_unsatisfyWheelTimer, lastExpiryFromNow);
+    return;
+  }
+
   scheduler::cancel(pitEntry->m_unsatisfyTimer);
   pitEntry->m_unsatisfyTimer = scheduler::schedule(lastExpiryFromNow,
     bind(&Forwarder::onInterestUnsatisfied, this, pitEntry));
@@ -563,6 +611,14 @@ Forwarder::setStragglerTimer(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
 {
   time::nanoseconds stragglerTime = time::milliseconds(100);
 
+  if (m_pitTimerWheel != nullptr) {
+    pit::EntryTimer& timer = pitEntry->m_stragglerWheelTimer;
+    timer.isSatisfied = isSatisfied;
+    timer.dataFreshnessPeriod = dataFreshnessPeriod;
+    m_pitTimerWheel->schedule(timer, stragglerTime);
+    return;
+  }
+
   scheduler::cancel(pitEntry->m_stragglerTimer);
   pitEntry->m_stragglerTimer = scheduler::schedule(stragglerTime,
     bind(&Forwarder::onInterestFinalize, this, pitEntry, isSatisfied, dataFreshnessPeriod));
@@ -573,6 +629,22 @@ Forwarder::cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry)
 {
   scheduler::cancel(pitEntry->m_unsatisfyTimer);
   scheduler::cancel(pitEntry->m_stragglerTimer);
+  pitEntry->m_unsatisfyWheelTimer.cancel();
+  pitEntry->m_stragglerWheelTimer.cancel();
+}
+
+void
+Forwarder::onPitTimer(TimerWheel::Timer& timer)
+{
+  pit::EntryTimer& entryTimer = static_cast<pit::EntryTimer&>(timer);
+  shared_ptr<pit::Entry> pitEntry = entryTimer.entry.shared_from_this();
+
+  if (entryTimer.isStraggler) {
+    this->onInterestFinalize(pitEntry, entryTimer.isSatisfied, entryTimer.dataFreshnessPeriod);
+  }
+  else {
+    this->onInterestUnsatisfied(pitEntry);
+  }
 }
 
 static inline void
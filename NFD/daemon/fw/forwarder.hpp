@@ -28,6 +28,7 @@
 
 #include "common.hpp"
 #include "core/scheduler.hpp"
+#include "core/timer-wheel.hpp"
 #include "forwarder-counters.hpp"
 #include "face-table.hpp"
 #include "table/fib.hpp"
@@ -68,6 +69,32 @@ public:
     m_sit.setCapacity(capacity);
   }
 
+  /// limits the number of next hops per SIT entry, 0 for no limit
+  void setSitMaxNextHops(size_t maxNextHops)
+  {
+    m_sit.setMaxNextHops(maxNextHops);
+  }
+
+  /** \brief get the PIT timer tick of Forwarders constructed afterwards
+   *  \sa setDefaultPitTimerTick
+   */
+  static time::nanoseconds
+  getDefaultPitTimerTick();
+
+  /** \brief set the PIT timer tick of Forwarders constructed afterwards
+   *
+   *  If tick is positive, unsatisfy and straggler timers of PIT entries run on a TimerWheel
+   *  of this granularity, and expire up to one tick late. If zero (the default), each timer
+   *  is a scheduler event of its own.
+   */
+  static void
+  setDefaultPitTimerTick(const time::nanoseconds& tick);
+
+  /** \return the TimerWheel of PIT timers, or nullptr if timers are scheduler events
+   */
+  const TimerWheel*
+  getPitTimerWheel() const;
+
 
 public: // faces
   FaceTable&
@@ -97,6 +124,10 @@ public: // forwarding entrypoints and tables
   NameTree&
   getNameTree();
 
+  /// NameTree that holds the SIT entries
+  NameTree&
+  getSitNameTree();
+
   Fib&
   getFib();
   
@@ -209,6 +240,11 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   VIRTUAL_WITH_TESTS void
   cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry);
 
+  /** \brief called when a PIT timer expires on the TimerWheel
+   */
+  void
+  onPitTimer(TimerWheel::Timer& timer);
+
   /** \brief insert Nonce to Dead Nonce List if necessary
    *  \param upstream if null, insert Nonces from all OutRecords;
    *                  if not null, insert Nonce only on the OutRecord of this face
@@ -247,7 +283,10 @@ private:
 
   ns3::Ptr<ns3::ndn::ContentStore> m_csFromNdnSim;
 
+  unique_ptr<TimerWheel> m_pitTimerWheel;
+
   static const Name LOCALHOST_NAME;
+  static time::nanoseconds s_defaultPitTimerTick;
 
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
@@ -259,6 +298,12 @@ Forwarder::getCounters() const
   return m_counters;
 }
 
+inline const TimerWheel*
+Forwarder::getPitTimerWheel() const
+{
+  return m_pitTimerWheel.get();
+}
+
 inline FaceTable&
 Forwarder::getFaceTable()
 {
@@ -295,6 +340,12 @@ Forwarder::getNameTree()
   return m_nameTree;
 }
 
+inline NameTree&
+Forwarder::getSitNameTree()
+{
+  return m_nameTree_sit;
+}
+
 inline Fib&
 Forwarder::getFib()
 {
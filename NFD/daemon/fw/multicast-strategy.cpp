@@ -24,6 +24,7 @@
  */
 
 #include "multicast-strategy.hpp"
+#include "utils/tracers/ndn-sit-event-log.hpp"
 #include <boost/random/uniform_int_distribution.hpp>
 #include <ndn-cxx/util/random.hpp>
 
@@ -31,6 +32,8 @@ namespace nfd {
 namespace fw {
 NFD_LOG_INIT("MulticastStrategy");
 
+using ns3::ndn::SitEventLog;
+
 const Name MulticastStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/multicast");
 NFD_REGISTER_STRATEGY(MulticastStrategy);
 
@@ -120,6 +123,9 @@ MulticastStrategy::afterReceiveInterest(const Face& inFace,
         }
       } while (!canForwardToNextHop(pitEntry, *selected));
       sent = true;
+      SitEventLog::Record(SitEventLog::FORWARD_SIT, interest.getName(), selected->getFace()->getId(),
+                          selected->getFace()->isLocal(), pitEntry->getDestinationFlag(),
+                          pitEntry->getFloodFlag());
       this->sendInterest(pitEntry, selected->getFace());
     }
 
@@ -162,6 +168,9 @@ MulticastStrategy::afterReceiveInterest(const Face& inFace,
         (*pitEntry).setFloodFlag(sdc);
         NFD_LOG_INFO("Forwarding DF 0 using SIT " << interest.getName());
         sent = true;
+        SitEventLog::Record(SitEventLog::FORWARD_SIT, interest.getName(), outFace->getId(),
+                            outFace->isLocal(), pitEntry->getDestinationFlag(),
+                            pitEntry->getFloodFlag());
         this->sendInterest(pitEntry, outFace);
 	     (*pitEntry).clearDestinationFlag(); 
         if(0 == sdc)
@@ -182,6 +191,9 @@ MulticastStrategy::afterReceiveInterest(const Face& inFace,
     if (it == nexthops.end()) {
       NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
       NFD_LOG_INFO("Reject DF 0 (no eligible FIB next hop) interest=" << interest.getName());
+      SitEventLog::Record(SitEventLog::REJECT, interest.getName(), inFace.getId(),
+                          inFace.isLocal(), pitEntry->getDestinationFlag(),
+                          pitEntry->getFloodFlag());
     }
     else
     {
@@ -190,6 +202,9 @@ MulticastStrategy::afterReceiveInterest(const Face& inFace,
       (*pitEntry).setFloodFlag(sdc);
       NFD_LOG_INFO("Forwarding DF 0 using FIB interest=" << interest.getName());
       sent = true;
+      SitEventLog::Record(SitEventLog::FORWARD_FIB, interest.getName(), outFace->getId(),
+                          outFace->isLocal(), pitEntry->getDestinationFlag(),
+                          pitEntry->getFloodFlag());
       this->sendInterest(pitEntry, outFace);
       NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                          << " newPitEntry-to=" << outFace->getId());
@@ -1,9 +1,12 @@
 
 #include "pick-latest-one-strategy.hpp"
+#include "utils/tracers/ndn-sit-event-log.hpp"
 namespace nfd {
 namespace fw {
 NFD_LOG_INIT("PickLatestOneStrategy");
 
+using ns3::ndn::SitEventLog;
+
 const Name PickLatestOneStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/picklatestone");
 NFD_REGISTER_STRATEGY(PickLatestOneStrategy);
 
@@ -77,6 +80,9 @@ PickLatestOneStrategy::afterReceiveInterest(const Face& inFace,
       (*pitEntry).setFloodFlag(sdc);
       NFD_LOG_INFO("Forwarding DF 0 using SIT interest=" << interest.getName());
       sent = true;
+      SitEventLog::Record(SitEventLog::FORWARD_SIT, interest.getName(), outFace->getId(),
+                          outFace->isLocal(), pitEntry->getDestinationFlag(),
+                          pitEntry->getFloodFlag());
       this->sendInterest(pitEntry, outFace);
       NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                              << " newPitEntry-to=" << outFace->getId());
@@ -100,6 +106,9 @@ PickLatestOneStrategy::afterReceiveInterest(const Face& inFace,
 	   (*pitEntry).setDestinationFlag(); 
       sdc--;
       (*pitEntry).setFloodFlag(sdc);
+      SitEventLog::Record(SitEventLog::FORWARD_SIT, interest.getName(), outFace->getId(),
+                          outFace->isLocal(), pitEntry->getDestinationFlag(),
+                          pitEntry->getFloodFlag());
       this->sendInterest(pitEntry, outFace);
       NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                              << " newPitEntry-to=" << outFace->getId());
@@ -118,6 +127,9 @@ PickLatestOneStrategy::afterReceiveInterest(const Face& inFace,
     if (it == nexthops.end()) {
         NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
         NFD_LOG_INFO("Reject DF 0 (no eligible FIB next hop) interest=" << interest.getName());
+        SitEventLog::Record(SitEventLog::REJECT, interest.getName(), inFace.getId(),
+                            inFace.isLocal(), pitEntry->getDestinationFlag(),
+                            pitEntry->getFloodFlag());
     }
     else
     {
@@ -126,6 +138,9 @@ PickLatestOneStrategy::afterReceiveInterest(const Face& inFace,
       (*pitEntry).setFloodFlag(sdc);
       NFD_LOG_INFO("Forwarding DF 0 using FIB interest=" << interest.getName());
       sent = true;
+      SitEventLog::Record(SitEventLog::FORWARD_FIB, interest.getName(), outFace->getId(),
+                          outFace->isLocal(), pitEntry->getDestinationFlag(),
+                          pitEntry->getFloodFlag());
       this->sendInterest(pitEntry, outFace);
       NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                           << " newPitEntry-to=" << outFace->getId());
@@ -1,4 +1,5 @@
 #include "pick-one-strategy.hpp"
+#include "utils/tracers/ndn-sit-event-log.hpp"
 #include <boost/random/uniform_int_distribution.hpp>
 #include <ndn-cxx/util/random.hpp>
 
@@ -6,6 +7,8 @@ namespace nfd {
 namespace fw {
 NFD_LOG_INIT("PickOneStrategy");
 
+using ns3::ndn::SitEventLog;
+
 
 const Name PickOneStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/pickone");
 NFD_REGISTER_STRATEGY(PickOneStrategy);
@@ -96,6 +99,9 @@ PickOneStrategy::afterReceiveInterest(const Face& inFace,
         }
       } while (!canForwardToNextHop(pitEntry, *selected));
       sent = true;
+      SitEventLog::Record(SitEventLog::FORWARD_SIT, interest.getName(), selected->getFace()->getId(),
+                          selected->getFace()->isLocal(), pitEntry->getDestinationFlag(),
+                          pitEntry->getFloodFlag());
       this->sendInterest(pitEntry, selected->getFace());
     }
   } 
@@ -121,6 +127,9 @@ PickOneStrategy::afterReceiveInterest(const Face& inFace,
       pitEntry->setFloodFlag(sdc);
       sent = true;
 	   (*pitEntry).setDestinationFlag(); 
+      SitEventLog::Record(SitEventLog::FORWARD_SIT, interest.getName(), selected->getFace()->getId(),
+                          selected->getFace()->isLocal(), pitEntry->getDestinationFlag(),
+                          pitEntry->getFloodFlag());
       this->sendInterest(pitEntry, selected->getFace());
 	   (*pitEntry).clearDestinationFlag(); 
     }
@@ -137,6 +146,9 @@ PickOneStrategy::afterReceiveInterest(const Face& inFace,
     if (it == nexthops.end()) {
         NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
         NFD_LOG_INFO("Reject DF 0 (no eligible FIB next hop) interest=" << interest.getName());
+        SitEventLog::Record(SitEventLog::REJECT, interest.getName(), inFace.getId(),
+                            inFace.isLocal(), pitEntry->getDestinationFlag(),
+                            pitEntry->getFloodFlag());
     }
     else
     {
@@ -145,6 +157,9 @@ PickOneStrategy::afterReceiveInterest(const Face& inFace,
       (*pitEntry).setFloodFlag(sdc);
       NFD_LOG_INFO("Forwarding DF 0 using FIB interest=" << interest.getName());
       sent = true;
+      SitEventLog::Record(SitEventLog::FORWARD_FIB, interest.getName(), outFace->getId(),
+                          outFace->isLocal(), pitEntry->getDestinationFlag(),
+                          pitEntry->getFloodFlag());
       this->sendInterest(pitEntry, outFace);
       NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                           << " newPitEntry-to=" << outFace->getId());
@@ -192,10 +192,19 @@ FibManager::addNextHop(ControlParameters& parameters,
       return;
     }
 
-  const Name& prefix = parameters.getName();
-  FaceId faceId = parameters.getFaceId();
-  uint64_t cost = parameters.getCost();
+  if (applyAddNextHop(parameters.getName(), parameters.getFaceId(), parameters.getCost()) == 200)
+    {
+      setResponse(response, 200, "Success", parameters.wireEncode());
+    }
+  else
+    {
+      setResponse(response, 410, "Face not found");
+    }
+}
 
+uint32_t
+FibManager::applyAddNextHop(const Name& prefix, FaceId faceId, uint64_t cost)
+{
   NFD_LOG_TRACE("add-nexthop prefix: " << prefix
                 << " faceid: " << faceId
                 << " cost: " << cost);
@@ -211,13 +220,12 @@ FibManager::addNextHop(ControlParameters& parameters,
                     << " prefix:" << prefix
                     << " faceid: " << faceId
                     << " cost: " << cost);
-
-      setResponse(response, 200, "Success", parameters.wireEncode());
+      return 200;
     }
   else
     {
       NFD_LOG_DEBUG("add-nexthop result: FAIL reason: unknown-faceid: " << faceId);
-      setResponse(response, 410, "Face not found");
+      return 410;
     }
 }
 
@@ -233,50 +241,55 @@ FibManager::removeNextHop(ControlParameters& parameters,
       return;
     }
 
-  NFD_LOG_TRACE("remove-nexthop prefix: " << parameters.getName()
-                << " faceid: " << parameters.getFaceId());
+  applyRemoveNextHop(parameters.getName(), parameters.getFaceId());
+  setResponse(response, 200, "Success", parameters.wireEncode());
+}
+
+uint32_t
+FibManager::applyRemoveNextHop(const Name& prefix, FaceId faceId)
+{
+  NFD_LOG_TRACE("remove-nexthop prefix: " << prefix
+                << " faceid: " << faceId);
 
-  if(parameters.getFaceId() == 999) //This is an ugly  hack TODO change this
+  if(faceId == 999) //This is an ugly  hack TODO change this
   {
     //std::cout<<"Removing SIT entry in fib-manager\n";
-    shared_ptr<fib::Entry> sitentry = m_managedSit.findExactMatch(parameters.getName());
+    shared_ptr<fib::Entry> sitentry = m_managedSit.findExactMatch(prefix);
     if (static_cast<bool>(sitentry))
       { //erase the entry
-        NFD_LOG_DEBUG("Removed_SIT entry for "<<parameters.getName().at(-1).toSequenceNumber());
+        NFD_LOG_DEBUG("Removed_SIT entry for "<<prefix.at(-1).toSequenceNumber());
         m_managedSit.erase(*sitentry);
       }
     
     else
       {
         NFD_LOG_DEBUG("remove-nexthop result: OK, but sit entry for name "
-                    << parameters.getName() << " not found");
+                    << prefix << " not found");
       }
-   shared_ptr<fib::Entry> fibentry = m_managedFib.findExactMatch(parameters.getName());
+   shared_ptr<fib::Entry> fibentry = m_managedFib.findExactMatch(prefix);
     if (static_cast<bool>(fibentry))
      {
-       NFD_LOG_INFO("Removed_FIB entry for "<<parameters.getName());
+       NFD_LOG_INFO("Removed_FIB entry for "<<prefix);
        m_managedFib.erase(*fibentry);
      }
     else
       {
         NFD_LOG_DEBUG("remove-nexthop result: OK, but fib entry for name "
-                    << parameters.getName() << " not found");
+                    << prefix << " not found");
       }
-	 
-	 setResponse(response, 200, "Success", parameters.wireEncode());
   }
   else
   {
-    shared_ptr<Face> faceToRemove = m_getFace(parameters.getFaceId());
+    shared_ptr<Face> faceToRemove = m_getFace(faceId);
     if (static_cast<bool>(faceToRemove))
       {
-        shared_ptr<fib::Entry> entry = m_managedFib.findExactMatch(parameters.getName());
+        shared_ptr<fib::Entry> entry = m_managedFib.findExactMatch(prefix);
         if (static_cast<bool>(entry))
           {
             entry->removeNextHop(faceToRemove);
-            NFD_LOG_INFO("Removed_FIB entry for "<<parameters.getName());
-            NFD_LOG_DEBUG("remove-nexthop result: OK prefix: " << parameters.getName()
-                        << " faceid: " << parameters.getFaceId());
+            NFD_LOG_INFO("Removed_FIB entry for "<<prefix);
+            NFD_LOG_DEBUG("remove-nexthop result: OK prefix: " << prefix
+                        << " faceid: " << faceId);
 
             if (!entry->hasNextHops())
               {
@@ -286,18 +299,18 @@ FibManager::removeNextHop(ControlParameters& parameters,
         else
           {
             NFD_LOG_DEBUG("remove-nexthop result: OK, but entry for face id "
-                        << parameters.getFaceId() << " not found in FIB");
+                        << faceId << " not found in FIB");
           }
         //Remove SIT entry   
-        shared_ptr<fib::Entry> sitentry = m_managedSit.findExactMatch(parameters.getName());
+        shared_ptr<fib::Entry> sitentry = m_managedSit.findExactMatch(prefix);
         if (static_cast<bool>(sitentry))
           {
             if(sitentry->removeNextHop(faceToRemove))
             {
-              NFD_LOG_INFO("Removed_SIT entry for "<<parameters.getName().at(-1).toSequenceNumber());
+              NFD_LOG_INFO("Removed_SIT entry for "<<prefix.at(-1).toSequenceNumber());
             }
-            NFD_LOG_DEBUG("remove-nexthop result: OK prefix: " << parameters.getName()
-                          << " faceid: " << parameters.getFaceId());
+            NFD_LOG_DEBUG("remove-nexthop result: OK prefix: " << prefix
+                          << " faceid: " << faceId);
 
             if (!sitentry->hasNextHops())
               {
@@ -307,17 +320,17 @@ FibManager::removeNextHop(ControlParameters& parameters,
         else
           {
             NFD_LOG_DEBUG("remove-nexthop result: OK, but entry for face id "
-                        << parameters.getFaceId() << " not found in SIT");
+                        << faceId << " not found in SIT");
           }
       }
     else
       {
         NFD_LOG_DEBUG("remove-nexthop result: OK, but face id "
-                      << parameters.getFaceId() << " not found");
+                      << faceId << " not found");
       }
-
-    setResponse(response, 200, "Success", parameters.wireEncode());
   }
+
+  return 200;
 }
 
 void
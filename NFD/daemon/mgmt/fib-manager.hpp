@@ -57,6 +57,18 @@ public:
   void
   onFibRequest(const Interest& request);
 
+  /** \brief adds a next hop as the add-nexthop command does, without a command Interest
+   *  \return status code of the command: 200, or 410 if the face does not exist
+   */
+  uint32_t
+  applyAddNextHop(const Name& prefix, FaceId faceId, uint64_t cost);
+
+  /** \brief removes a next hop as the remove-nexthop command does, without a command Interest
+   *  \return status code of the command, which is always 200
+   */
+  uint32_t
+  applyRemoveNextHop(const Name& prefix, FaceId faceId);
+
 private:
 
   void
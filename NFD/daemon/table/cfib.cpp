@@ -7,8 +7,11 @@ NFD_LOG_INIT("Cfib");
 
 Cfib::Cfib(NameTree& nameTree, size_t capacity)
   : Fib(nameTree)
-  , m_cache(capacity)
+  , m_head(nullptr)
+  , m_tail(nullptr)
+  , m_nCached(0)
   , m_limit(capacity)
+  , m_maxNextHops(0)
 {
 }
 
@@ -20,22 +23,19 @@ shared_ptr<fib::Entry>
 Cfib::findLongestPrefixMatch(const Name& prefix)
 {
   shared_ptr<fib::Entry> fibEntry = Fib::findLongestPrefixMatch(prefix);
-  if(!Fib::isEmpty(fibEntry))
+  if(!Fib::isEmpty(fibEntry) && fibEntry->m_isLruLinked)
   {
     //update usage in the cache
-    if(!m_cache.get(prefix))
-    {
-      std::cout << "This should not happen in Cfib findLongestPrefixMatch\n";
-    }
+    this->touch(*fibEntry);
   }
   return fibEntry;
 }
 
-void 
+void
 Cfib::setCapacity(size_t capacity)
 {
-  m_cache.setCap(capacity);
   m_limit = capacity;
+  this->evictToCapacity();
 }
 
 size_t
@@ -44,17 +44,20 @@ Cfib::getCapacity()
   return m_limit;
 }
 
+void
+Cfib::setMaxNextHops(size_t maxNextHops)
+{
+  m_maxNextHops = maxNextHops;
+}
+
 shared_ptr<fib::Entry>
 Cfib::findExactMatch(const Name& prefix)
 {
   shared_ptr<fib::Entry> fibEntry = Fib::findExactMatch(prefix);
-  if(static_cast<bool> (fibEntry) && fibEntry->hasNextHops())
+  if(static_cast<bool> (fibEntry) && fibEntry->hasNextHops() && fibEntry->m_isLruLinked)
   {
     //update usage in the cache
-    if(!m_cache.get(prefix))
-    {
-      std::cout << "This should not happen in Cfib findExactMatch\n";
-    }
+    this->touch(*fibEntry);
   }
 
   return fibEntry;
@@ -66,32 +69,110 @@ Cfib::insert(const Name& prefix)
   std::pair<shared_ptr<fib::Entry>, bool> p = Fib::insert(prefix); //returns true for a new nametable entry
   if(!p.first->hasNextHops())
   {
-    std::pair<shared_ptr<fib::Entry>, bool> e = m_cache.put(prefix, p.first); 
-    if(e.second)
+    if(p.first->m_isLruLinked)
+      this->touch(*p.first);
+    else
     {
-      //NFD_LOG_INFO("Removed_SIT entry for "<<(e.first)->getPrefix().at(-1).toSequenceNumber()<<" due to space");
-      //NFD_LOG_INFO("Removed_SIT entry for "<<(e.first)->getPrefix()<<" due to space");
-      //e.first.reset();
-      Cfib::erase(*(e.first));  
+      this->attach(*p.first);
+      this->evictToCapacity();
     }
   }
   return p;
 }
 
-//void
-//Cfib::erase(const fib::Entry& entry)
+shared_ptr<fib::Entry>
+Cfib::recordDownstream(const Name& name, shared_ptr<Face> face)
+{
+  return this->recordDownstream(name, name_tree::computeHashSet(name), face);
+}
+
+shared_ptr<fib::Entry>
+Cfib::recordDownstream(const Name& name, const std::vector<size_t>& hashSet,
+                       shared_ptr<Face> face)
+{
+  shared_ptr<fib::Entry> entry;
+  // a name still in the SIT is found without creating a NameTree entry
+  shared_ptr<name_tree::Entry> nameTreeEntry = getNameTree().findExactMatch(name, hashSet.back());
+  if(static_cast<bool>(nameTreeEntry))
+    entry = nameTreeEntry->getFibEntry();
+  if(!static_cast<bool>(entry))
+    entry = Fib::insert(name, hashSet).first;
+
+  if(entry->m_isLruLinked)
+    this->touch(*entry);
+  else
+  {
+    this->attach(*entry);
+    this->evictToCapacity();
+  }
+
+  if(m_maxNextHops > 0)
+  {
+    entry->addLatestNextHop(face, 0);
+    entry->truncateNextHops(m_maxNextHops);
+  }
+  else
+    entry->addNextHop(face, 0);
+  return entry;
+}
+
 void
 Cfib::erase(fib::Entry& entry)
 {
   entry.clearNextHops();
-  //m_cache.remove(entry.getPrefix()); //no need put() already removes the entry
-/*
-  shared_ptr<name_tree::Entry> nameTreeEntry = getNameTree().get(entry);
-  if (static_cast<bool>(nameTreeEntry)) { 
-    //NFD_LOG_INFO("Removed_SIT entry for "<<nameTreeEntry->getPrefix().at(-1).toSequenceNumber());
-    m_cache.remove(nameTreeEntry->getPrefix());
+  if(entry.m_isLruLinked)
+    this->detach(entry);
+  Fib::erase(entry);
+}
+
+void
+Cfib::touch(fib::Entry& entry)
+{
+  if(m_head == &entry)
+    return;
+  this->detach(entry);
+  this->attach(entry);
+}
+
+void
+Cfib::attach(fib::Entry& entry)
+{
+  BOOST_ASSERT(!entry.m_isLruLinked);
+  entry.m_lruPrev = nullptr;
+  entry.m_lruNext = m_head;
+  if(m_head != nullptr)
+    m_head->m_lruPrev = &entry;
+  else
+    m_tail = &entry;
+  m_head = &entry;
+  entry.m_isLruLinked = true;
+  ++m_nCached;
+}
+
+void
+Cfib::detach(fib::Entry& entry)
+{
+  BOOST_ASSERT(entry.m_isLruLinked);
+  if(entry.m_lruPrev != nullptr)
+    entry.m_lruPrev->m_lruNext = entry.m_lruNext;
+  else
+    m_head = entry.m_lruNext;
+  if(entry.m_lruNext != nullptr)
+    entry.m_lruNext->m_lruPrev = entry.m_lruPrev;
+  else
+    m_tail = entry.m_lruPrev;
+  entry.m_lruPrev = entry.m_lruNext = nullptr;
+  entry.m_isLruLinked = false;
+  --m_nCached;
+}
+
+void
+Cfib::evictToCapacity()
+{
+  while(m_nCached > m_limit)
+  {
+    this->erase(*m_tail);
   }
-  Fib::erase(entry);*/
 }
 
 } //namespace nfd
@@ -1,4 +1,3 @@
-
 #ifndef NFD_DAEMON_TABLE_CFIB_HPP
 #define NFD_DAEMON_TABLE_CFIB_HPP
 
@@ -6,14 +5,25 @@
 
 namespace nfd {
 
+/** \class Cfib
+ *  \brief represents the SIT, a capacity-bounded FIB with LRU replacement
+ *
+ *  The replacement order is kept in an intrusive doubly-linked list whose links
+ *  live in fib::Entry itself. An entry is located through the NameTree (one hash
+ *  computation), after which touching, inserting and evicting it are O(1) and
+ *  do not allocate or copy the Name.
+ *
+ *  Evicting an entry unlinks it from the replacement index and erases it from
+ *  the NameTree, so a fib::Entry is never destroyed while still linked.
+ */
 class Cfib : public Fib
 {
 public:
   explicit
   Cfib(NameTree& nameTree, size_t capacity);
-  
+
   ~Cfib();
-  
+
   std::pair<shared_ptr<fib::Entry>, bool>
   insert(const Name& prefix);
 
@@ -24,156 +34,84 @@ public:
   shared_ptr<fib::Entry>
   findExactMatch(const Name& prefix);
 
-  //void
-  //erase(const fib::Entry& entry);
+  /** \brief removes the entry from the replacement index and the NameTree
+   */
   void
   erase(fib::Entry& entry);
 
-  void 
+  /** \brief records that Data under \p name was sent towards \p face
+   *
+   *  Finds or creates the SIT entry, marks it most recently used and adds
+   *  \p face to the front of its next hops.
+   *  \return the SIT entry
+   */
+  shared_ptr<fib::Entry>
+  recordDownstream(const Name& name, shared_ptr<Face> face);
+
+  /** \brief records that Data under \p name was sent towards \p face,
+   *         using hash values computed beforehand
+   *  \param hashSet computeHashSet() of \p name
+   */
+  shared_ptr<fib::Entry>
+  recordDownstream(const Name& name, const std::vector<size_t>& hashSet,
+                   shared_ptr<Face> face);
+
+  void
   setCapacity(size_t capacity);
 
   size_t
   getCapacity();
 
+  /** \brief limits the number of next hops kept per SIT entry
+   *  \param maxNextHops the limit, or 0 for no limit
+   */
+  void
+  setMaxNextHops(size_t maxNextHops);
+
+  size_t
+  getMaxNextHops() const;
+
+  /// \return number of entries in the replacement index
+  size_t
+  getNCachedEntries() const;
+
 private:
-  template<class K, class T>
-  struct LRUCacheEntry
-  {
-    K key;
-    T data;
-    LRUCacheEntry* prev;
-    LRUCacheEntry* next;
-  };
-
-  template<class K, class T>
-  class LRUCache
-  {
-  private:
-    std::unordered_map< K, LRUCacheEntry<K,T>*, std::hash<ndn::Name>> m_mapping;
-    std::vector< LRUCacheEntry<K,T>* >      m_freeEntries;
-    LRUCacheEntry<K,T> *         m_head;
-    LRUCacheEntry<K,T> *         m_tail;
-    LRUCacheEntry<K,T> *         m_entries;
-  public:
-    LRUCache(size_t size)
-    {
-      m_entries = new LRUCacheEntry<K,T>[size];
-      for (int i=0; i<size; i++)
-        m_freeEntries.push_back(m_entries+i);
-      m_head = new LRUCacheEntry<K,T>;
-      m_tail = new LRUCacheEntry<K,T>;
-      m_head->prev = NULL;
-      m_head->next = m_tail;
-      m_tail->next = NULL;
-      m_tail->prev = m_head;
-    }
-    ~LRUCache()
-    {
-      delete m_head;
-      delete m_tail;
-      delete [] m_entries;
-    }
-    void setCap (size_t size)
-    {
-      //delete m_head;
-      //delete m_tail;
-      //delete m_entries;
-      m_freeEntries.clear();
-      m_entries = new LRUCacheEntry<K,T>[size];
-      for (int i=0; i<size; i++)
-        m_freeEntries.push_back(m_entries+i);
-      m_head = new LRUCacheEntry<K,T>;
-      m_tail = new LRUCacheEntry<K,T>;
-      m_head->prev = NULL;
-      m_head->next = m_tail;
-      m_tail->next = NULL;
-      m_tail->prev = m_head;
-    }
-    std::pair<T, bool> 
-    put(K key, T data)
-    {
-       LRUCacheEntry<K,T>* node =m_mapping[key];
-       if(node)
-       {
-         // refresh the link list
-         detach(node);
-         node->data = data;
-         attach(node);
-         return std::make_pair(data, false);
-       }
-       else
-       {
-         if ( m_freeEntries.empty() )
-         {
-            node = m_tail->prev;
-            T entry = node->data;
-            detach(node);
-            m_mapping.erase(node->key);
-            node->data = data;
-            node->key = key;
-            m_mapping[key] = node;
-            attach(node);
-            return std::make_pair(entry, true);
-         }
-         else
-         {
-           node = m_freeEntries.back();
-           m_freeEntries.pop_back();
-           node->key = key;
-           node->data = data;
-           m_mapping[key] = node;
-           attach(node);
-           return std::make_pair(data, false);
-         }
-       }
-    }
-
-    T remove (K const key)
-    {
-      LRUCacheEntry<K,T>* node = m_mapping[key];
-      if(node)
-      {
-         detach(node);
-         m_mapping.erase(node->key);
-         m_freeEntries.push_back(node); 
-         return node->data;
-      }
-      else 
-        return NULL;
-    }
-
-    T get(K const key) 
-    {
-      LRUCacheEntry<K,T>* node = m_mapping[key];
-      if(node)
-      {
-         detach(node);
-         attach(node);
-         return node->data;
-      }
-      else 
-        return NULL;
-    }
-
-    private:
-      void detach(LRUCacheEntry<K,T>* node)
-      {
-        node->prev->next = node->next;
-        node->next->prev = node->prev;
-      }
-      void attach(LRUCacheEntry<K,T>* node)
-      {
-        node->next = m_head->next;
-        node->prev = m_head;        m_head->next = node;
-        node->next->prev = node;
-      }
-  }; //LRUCache
+  /// moves a linked entry to the most-recently-used end
+  void
+  touch(fib::Entry& entry);
+
+  /// links entry at the most-recently-used end
+  void
+  attach(fib::Entry& entry);
+
+  /// unlinks entry from the replacement index
+  void
+  detach(fib::Entry& entry);
+
+  /// evicts least-recently-used entries until the index fits the capacity
+  void
+  evictToCapacity();
 
 private:
-  LRUCache<Name, shared_ptr<fib::Entry>> m_cache; // cache of FIB table m_entries
-  size_t m_limit; // capacity of the FIB table 
+  fib::Entry* m_head; // most recently used
+  fib::Entry* m_tail; // least recently used
+  size_t m_nCached;   // number of linked entries
+  size_t m_limit;     // capacity of the SIT
+  size_t m_maxNextHops; // next hops kept per entry, 0 for unbounded
 };
 
+inline size_t
+Cfib::getMaxNextHops() const
+{
+  return m_maxNextHops;
+}
+
+inline size_t
+Cfib::getNCachedEntries() const
+{
+  return m_nCached;
+}
+
 } //namespace nfd
 
 #endif
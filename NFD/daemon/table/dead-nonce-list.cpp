@@ -42,13 +42,29 @@ const double DeadNonceList::CAPACITY_UP = 1.2;
 const double DeadNonceList::CAPACITY_DOWN = 0.9;
 const size_t DeadNonceList::EVICT_LIMIT = (1 << 6);
 
-DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
+DeadNonceList::Mode DeadNonceList::s_defaultMode = DeadNonceList::MODE_SCHEDULED;
+
+DeadNonceList::Mode
+DeadNonceList::getDefaultMode()
+{
+  return s_defaultMode;
+}
+
+void
+DeadNonceList::setDefaultMode(Mode mode)
+{
+  s_defaultMode = mode;
+}
+
+DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime, Mode mode)
   : m_lifetime(lifetime)
+  , m_mode(mode)
   , m_queue(m_index.get<0>())
   , m_ht(m_index.get<1>())
   , m_capacity(INITIAL_CAPACITY)
   , m_markInterval(m_lifetime / EXPECTED_MARK_COUNT)
   , m_adjustCapacityInterval(m_lifetime)
+  , m_nEvents(0)
 {
   if (m_lifetime < MIN_LIFETIME) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
@@ -58,6 +74,13 @@ DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
     m_queue.push_back(MARK);
   }
 
+  if (m_mode == MODE_LAZY) {
+    time::steady_clock::TimePoint now = time::steady_clock::now();
+    m_nextMark = now + m_markInterval;
+    m_nextAdjustCapacity = now + m_adjustCapacityInterval;
+    return;
+  }
+
   m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
   m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
                                               bind(&DeadNonceList::adjustCapacity, this));
@@ -83,12 +106,16 @@ DeadNonceList::~DeadNonceList()
 size_t
 DeadNonceList::size() const
 {
+  const_cast<DeadNonceList*>(this)->update();
   return m_queue.size() - this->countMarks();
 }
 
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
+  // MARKs and capacity adjustments do not change the table, but evictions may
+  const_cast<DeadNonceList*>(this)->update();
+
   Entry entry = DeadNonceList::makeEntry(name, nonce);
   return m_ht.find(entry) != m_ht.end();
 }
@@ -96,6 +123,8 @@ DeadNonceList::has(const Name& name, uint32_t nonce) const
 void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
+  this->update();
+
   Entry entry = DeadNonceList::makeEntry(name, nonce);
   m_queue.push_back(entry);
 
@@ -125,7 +154,10 @@ DeadNonceList::mark()
 
   NFD_LOG_TRACE("mark nMarks=" << nMarks);
 
-  scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  if (m_mode == MODE_SCHEDULED) {
+    ++m_nEvents;
+    m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  }
 }
 
 void
@@ -151,8 +183,11 @@ DeadNonceList::adjustCapacity()
 
   this->evictEntries();
 
-  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
-                                              bind(&DeadNonceList::adjustCapacity, this));
+  if (m_mode == MODE_SCHEDULED) {
+    ++m_nEvents;
+    m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
+                                                bind(&DeadNonceList::adjustCapacity, this));
+  }
 }
 
 void
@@ -168,4 +203,37 @@ DeadNonceList::evictEntries()
   BOOST_ASSERT(m_queue.size() >= m_capacity);
 }
 
+void
+DeadNonceList::update()
+{
+  if (m_mode != MODE_LAZY)
+    return;
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  while (m_nextMark <= now || m_nextAdjustCapacity <= now) {
+    // when both are due at the same time, the scheduler runs adjustCapacity first because
+    // its event was scheduled earlier
+    if (m_nextAdjustCapacity > m_nextMark) {
+      this->mark();
+      m_nextMark += m_markInterval;
+      continue;
+    }
+
+    this->adjustCapacity();
+    m_nextAdjustCapacity += m_adjustCapacityInterval;
+
+    // An idle list ends up holding MIN_CAPACITY MARKs right after an adjustment. Each
+    // following cycle of EXPECTED_MARK_COUNT MARKs and one adjustment brings it back to
+    // that state, so whole cycles until now can be skipped.
+    bool isIdle = m_capacity == MIN_CAPACITY && m_queue.size() == MIN_CAPACITY &&
+                  this->countMarks() == MIN_CAPACITY;
+    if (isIdle && m_markInterval * EXPECTED_MARK_COUNT == m_adjustCapacityInterval &&
+        m_nextAdjustCapacity <= now) {
+      auto nCycles = (now - m_nextAdjustCapacity) / m_adjustCapacityInterval;
+      m_nextMark += m_adjustCapacityInterval * nCycles;
+      m_nextAdjustCapacity += m_adjustCapacityInterval * nCycles;
+    }
+  }
+}
+
 } // namespace nfd
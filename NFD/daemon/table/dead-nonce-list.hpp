@@ -50,19 +50,46 @@ namespace nfd {
  *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
  *  The number of MARKs stored in the container reflects the lifetime of entries,
  *  because MARKs are inserted at fixed intervals.
+ *
+ *  In MODE_LAZY, MARKs and capacity adjustments are not scheduled. Instead, every operation
+ *  first applies those whose time has passed, in the order the scheduler would have run them,
+ *  so a Dead Nonce List nobody touches costs no events.
  */
 class DeadNonceList : noncopyable
 {
 public:
+  /** \brief how MARKs and capacity adjustments are timed
+   */
+  enum Mode {
+    /** \brief scheduler events at fixed intervals
+     */
+    MODE_SCHEDULED,
+    /** \brief computed from the current time when the list is used
+     */
+    MODE_LAZY
+  };
+
   /** \brief constructs the Dead Nonce List
    *  \param lifetime duration of the expected lifetime of each nonce,
    *         must be no less than MIN_LIFETIME.
    *         This should be set to the duration in which most loops would have occured.
    *         A loop cannot be detected if delay of the cycle is greater than lifetime.
+   *  \param mode how MARKs and capacity adjustments are timed
    *  \throw std::invalid_argument if lifetime is less than MIN_LIFETIME
    */
   explicit
-  DeadNonceList(const time::nanoseconds& lifetime = DEFAULT_LIFETIME);
+  DeadNonceList(const time::nanoseconds& lifetime = DEFAULT_LIFETIME,
+                Mode mode = getDefaultMode());
+
+  /** \brief get the mode of Dead Nonce Lists that do not choose one
+   */
+  static Mode
+  getDefaultMode();
+
+  /** \brief set the mode of Dead Nonce Lists constructed afterwards without choosing one
+   */
+  static void
+  setDefaultMode(Mode mode);
 
   ~DeadNonceList();
 
@@ -88,6 +115,15 @@ public:
   const time::nanoseconds&
   getLifetime() const;
 
+  Mode
+  getMode() const;
+
+  /** \return number of scheduler events this list has run
+   *  \note This stays zero in MODE_LAZY.
+   */
+  size_t
+  getNEvents() const;
+
 private: // Entry and Index
   typedef uint64_t Entry;
 
@@ -131,6 +167,11 @@ private: // actual lifetime estimation and capacity control
   void
   evictEntries();
 
+  /** \brief in MODE_LAZY, apply the MARKs and capacity adjustments that are due
+   */
+  void
+  update();
+
 public:
   /// default entry lifetime
   static const time::nanoseconds DEFAULT_LIFETIME;
@@ -140,10 +181,13 @@ public:
 
 private:
   time::nanoseconds m_lifetime;
+  Mode m_mode;
   Index m_index;
   Queue& m_queue;
   Hashtable& m_ht;
 
+  static Mode s_defaultMode;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
 
   // ---- current capacity and hard limits
@@ -206,6 +250,14 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity contr
 
   scheduler::EventId m_adjustCapacityEvent;
 
+  // ---- MODE_LAZY
+
+  time::steady_clock::TimePoint m_nextMark;
+
+  time::steady_clock::TimePoint m_nextAdjustCapacity;
+
+  size_t m_nEvents;
+
   /** \brief maximum number of entries to evict at each operation if index is over capacity
    */
   static const size_t EVICT_LIMIT;
@@ -217,6 +269,18 @@ DeadNonceList::getLifetime() const
   return m_lifetime;
 }
 
+inline DeadNonceList::Mode
+DeadNonceList::getMode() const
+{
+  return m_mode;
+}
+
+inline size_t
+DeadNonceList::getNEvents() const
+{
+  return m_nEvents;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
@@ -31,6 +31,9 @@ namespace fib {
 
 Entry::Entry(const Name& prefix)
   : m_prefix(prefix)
+  , m_lruPrev(nullptr)
+  , m_lruNext(nullptr)
+  , m_isLruLinked(false)
 {
 }
 
@@ -70,6 +73,20 @@ Entry::addNextHop(shared_ptr<Face> face, uint64_t cost)
   //this->sortNextHops();
 }
 
+void
+Entry::addLatestNextHop(shared_ptr<Face> face, uint64_t cost)
+{
+  auto it = this->findNextHop(*face);
+  if (it == m_nextHops.end()) {
+    m_nextHops.push_back(fib::NextHop(face));
+    it = m_nextHops.end();
+    --it;
+  }
+
+  it->setCost(cost);
+  std::rotate(m_nextHops.begin(), it, it + 1);
+}
+
 bool
 Entry::removeNextHop(shared_ptr<Face> face)
 {
@@ -88,6 +105,14 @@ void Entry::clearNextHops()
 
 }
 
+void
+Entry::truncateNextHops(size_t nMax)
+{
+  if (nMax > 0 && m_nextHops.size() > nMax) {
+    m_nextHops.erase(m_nextHops.begin() + nMax, m_nextHops.end());
+  }
+}
+
 void
 Entry::sortNextHops()
 {
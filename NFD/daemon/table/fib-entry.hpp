@@ -31,6 +31,7 @@
 namespace nfd {
 
 class NameTree;
+class Cfib;
 namespace name_tree {
 class Entry;
 }
@@ -82,6 +83,15 @@ public:
   void
   addNextHop(shared_ptr<Face> face, uint64_t cost);
 
+  /** \brief adds a NextHop record at the front, keeping the others in their order
+   *
+   *  If a NextHop record for face already exists, its cost is updated and it is moved
+   *  to the front. Used by the SIT when it limits the number of next hops, so that
+   *  records stay ordered from most to least recent and truncateNextHops drops the oldest.
+   */
+  void
+  addLatestNextHop(shared_ptr<Face> face, uint64_t cost);
+
   /** \brief removes a NextHop record
    *
    *  If no NextHop record for face exists, do nothing.
@@ -93,6 +103,13 @@ public:
 
   void clearNextHops(); 
 
+  /** \brief removes NextHop records beyond the first \p nMax
+   *
+   *  If \p nMax is 0, do nothing.
+   */
+  void
+  truncateNextHops(size_t nMax);
+
 private:
   /** @note This method is non-const because normal iterator is needed by callers.
    */
@@ -110,6 +127,12 @@ private:
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
   friend class nfd::NameTree;
   friend class nfd::name_tree::Entry;
+
+  // links of the SIT replacement index, maintained by Cfib
+  Entry* m_lruPrev;
+  Entry* m_lruNext;
+  bool m_isLruLinked;
+  friend class nfd::Cfib;
 };
 
 
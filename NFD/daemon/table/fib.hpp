@@ -80,6 +80,12 @@ public: // mutation
   std::pair<shared_ptr<fib::Entry>, bool>
   insert(const Name& prefix);
 
+  /** \brief inserts a FIB entry for prefix, using hash values computed beforehand
+   *  \param hashSet computeHashSet() of \p prefix
+   */
+  std::pair<shared_ptr<fib::Entry>, bool>
+  insert(const Name& prefix, const std::vector<size_t>& hashSet);
+
   void
   erase(const Name& prefix);
 
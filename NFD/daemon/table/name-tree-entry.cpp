@@ -47,6 +47,10 @@ Node::~Node()
 Entry::Entry(const Name& name)
   : m_hash(0)
   , m_prefix(name)
+  , m_node(0)
+  , m_slot(0)
+  , m_enumPrev(0)
+  , m_enumNext(0)
 {
 }
 
@@ -59,6 +59,17 @@ public:
   Node* m_next; // Next Name Tree Node (to resolve hash collision)
 };
 
+/**
+ * \brief Slot of the open-addressing Name Tree hash table
+ * \details The hash is kept next to the entry pointer, so that probing
+ * does not touch the Entry until the hash matches.
+ */
+struct Slot
+{
+  shared_ptr<Entry> m_entry; // null if the slot is free
+  size_t m_hash;
+};
+
 /**
  * \brief Name Tree Entry Class
  */
@@ -141,6 +152,14 @@ private:
   // get the Name Tree Node that is associated with this Name Tree Entry
   Node* m_node;
 
+  // index of the Slot holding this Entry in the open-addressing table
+  size_t m_slot;
+
+  // neighbours in the enumeration order of the open-addressing table, which
+  // unlike the Slots do not move when other entries are inserted or erased
+  Entry* m_enumPrev;
+  Entry* m_enumNext;
+
   // Make private members accessible by Name Tree
   friend class nfd::NameTree;
 };
@@ -29,6 +29,7 @@
 
 #include <boost/concept/assert.hpp>
 #include <boost/concept_check.hpp>
+#include <algorithm>
 #include <type_traits>
 
 namespace nfd {
@@ -113,7 +114,30 @@ computeHashSet(const Name& prefix)
 
 } // namespace name_tree
 
-NameTree::NameTree(size_t nBuckets)
+NameTree::Backend NameTree::s_defaultBackend = NameTree::BACKEND_CHAINED;
+
+NameTree::Backend
+NameTree::getDefaultBackend()
+{
+  return s_defaultBackend;
+}
+
+void
+NameTree::setDefaultBackend(Backend backend)
+{
+  s_defaultBackend = backend;
+}
+
+static size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t p = 1;
+  while (p < n)
+    p <<= 1;
+  return p;
+}
+
+NameTree::NameTree(size_t nBuckets, Backend backend)
   : m_nItems(0)
   , m_nBuckets(nBuckets)
   , m_minNBuckets(nBuckets)
@@ -121,14 +145,34 @@ NameTree::NameTree(size_t nBuckets)
   , m_enlargeFactor(2)       // double the hash table size
   , m_shrinkLoadFactor(0.1) // less than 10% buckets loaded
   , m_shrinkFactor(0.5)     // reduce the number of buckets by half
+  , m_backend(backend)
+  , m_buckets(0)
+  , m_enumFirst(0)
+  , m_enumLast(0)
+  , m_nProbes(0)
   , m_endIterator(FULL_ENUMERATE_TYPE, *this, m_end)
 {
+  if (m_backend == BACKEND_OPEN_ADDRESSING)
+    {
+      // probing masks the hash, and Robin Hood displacement keeps probe
+      // sequences short up to a high load
+      m_nBuckets = roundUpToPowerOfTwo(std::max<size_t>(nBuckets, 2));
+      m_minNBuckets = m_nBuckets;
+      m_enlargeLoadFactor = 0.8;
+    }
+
   m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
                                           static_cast<double>(m_nBuckets));
 
   m_shrinkThreshold = static_cast<size_t>(m_shrinkLoadFactor *
                                           static_cast<double>(m_nBuckets));
 
+  if (m_backend == BACKEND_OPEN_ADDRESSING)
+    {
+      m_slots.resize(m_nBuckets);
+      return;
+    }
+
   // array of node pointers
   m_buckets = new name_tree::Node*[m_nBuckets];
   // Initialize the pointer array
@@ -138,6 +182,9 @@ NameTree::NameTree(size_t nBuckets)
 
 NameTree::~NameTree()
 {
+  if (m_buckets == 0)
+    return;
+
   for (size_t i = 0; i < m_nBuckets; i++)
     {
       if (m_buckets[i] != 0) {
@@ -148,38 +195,102 @@ NameTree::~NameTree()
   delete [] m_buckets;
 }
 
-// insert() is a private function, and called by only lookup()
-std::pair<shared_ptr<name_tree::Entry>, bool>
-NameTree::insert(const Name& prefix)
+shared_ptr<name_tree::Entry>
+NameTree::findInTable(const Name& prefix, size_t prefixLen, size_t hash) const
 {
-  NFD_LOG_TRACE("insert " << prefix);
+  ++m_nProbes;
 
-  size_t hashValue = name_tree::computeHash(prefix);
-  size_t loc = hashValue % m_nBuckets;
+  // an entry matches if it holds exactly the first prefixLen components of prefix;
+  // isPrefixOf() is used to avoid making a copy of the name
+  auto isMatch = [&] (const name_tree::Entry& entry) {
+    return entry.getPrefix().size() == prefixLen && entry.getPrefix().isPrefixOf(prefix);
+  };
 
-  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue << "  location = " << loc);
-
-  // Check if this Name has been stored
-  name_tree::Node* node = m_buckets[loc];
-  name_tree::Node* nodePrev = node;  // initialize nodePrev to node
-
-  for (node = m_buckets[loc]; node != 0; node = node->m_next)
+  if (m_backend == BACKEND_OPEN_ADDRESSING)
     {
-      if (static_cast<bool>(node->m_entry))
+      size_t mask = m_nBuckets - 1;
+      for (size_t i = hash & mask, distance = 0; ; i = (i + 1) & mask, distance++)
         {
-          if (prefix == node->m_entry->m_prefix)
+          const name_tree::Slot& slot = m_slots[i];
+          // an entry displaced less than we are would have been swapped out on insert
+          if (!static_cast<bool>(slot.m_entry) ||
+              ((i - (slot.m_hash & mask)) & mask) < distance)
             {
-              return std::make_pair(node->m_entry, false); // false: old entry
+              return shared_ptr<name_tree::Entry>();
+            }
+          if (slot.m_hash == hash && isMatch(*slot.m_entry))
+            {
+              return slot.m_entry;
             }
         }
-      nodePrev = node;
     }
 
-  NFD_LOG_TRACE("Did not find " << prefix << ", need to insert it to the table");
+  for (name_tree::Node* node = m_buckets[hash % m_nBuckets]; node != 0; node = node->m_next)
+    {
+      if (static_cast<bool>(node->m_entry) && node->m_entry->getHash() == hash &&
+          isMatch(*node->m_entry))
+        {
+          return node->m_entry;
+        }
+    }
+  return shared_ptr<name_tree::Entry>();
+}
+
+void
+NameTree::placeInSlots(shared_ptr<name_tree::Entry> entry)
+{
+  // Robin Hood insertion: take the slot of any entry that is closer to its
+  // home slot than the one being placed, and go on placing that entry instead
+  size_t mask = m_nBuckets - 1;
+  name_tree::Slot carried{std::move(entry), 0};
+  carried.m_hash = carried.m_entry->getHash();
+  for (size_t i = carried.m_hash & mask, distance = 0; ; i = (i + 1) & mask, distance++)
+    {
+      name_tree::Slot& slot = m_slots[i];
+      if (!static_cast<bool>(slot.m_entry))
+        {
+          slot = std::move(carried);
+          slot.m_entry->m_slot = i;
+          return;
+        }
+      size_t slotDistance = (i - (slot.m_hash & mask)) & mask;
+      if (slotDistance < distance)
+        {
+          std::swap(slot, carried);
+          slot.m_entry->m_slot = i;
+          distance = slotDistance;
+        }
+    }
+}
+
+void
+NameTree::addToTable(shared_ptr<name_tree::Entry> entry)
+{
+  if (m_backend == BACKEND_OPEN_ADDRESSING)
+    {
+      // new entries are enumerated last
+      entry->m_enumPrev = m_enumLast;
+      entry->m_enumNext = 0;
+      if (m_enumLast != 0)
+        m_enumLast->m_enumNext = entry.get();
+      else
+        m_enumFirst = entry.get();
+      m_enumLast = entry.get();
+
+      placeInSlots(std::move(entry));
+      return;
+    }
+
+  size_t loc = entry->getHash() % m_nBuckets;
 
-  // If no bucket is empty occupied, we need to create a new node, and it is
-  // linked from nodePrev
-  node = new name_tree::Node();
+  // the new node is appended to the chain of its bucket
+  name_tree::Node* nodePrev = 0;
+  for (name_tree::Node* node = m_buckets[loc]; node != 0; node = node->m_next)
+    {
+      nodePrev = node;
+    }
+
+  name_tree::Node* node = new name_tree::Node();
   node->m_prev = nodePrev;
 
   if (nodePrev == 0)
@@ -191,11 +302,86 @@ NameTree::insert(const Name& prefix)
       nodePrev->m_next = node;
     }
 
-  // Create a new Entry
-  shared_ptr<name_tree::Entry> entry(make_shared<name_tree::Entry>(prefix));
-  entry->setHash(hashValue);
   node->m_entry = entry; // link the Entry to its Node
   entry->m_node = node; // link the node to Entry. Used in eraseEntryIfEmpty.
+}
+
+void
+NameTree::removeFromTable(name_tree::Entry& entry)
+{
+  if (m_backend == BACKEND_OPEN_ADDRESSING)
+    {
+      // backward shift deletion: pull the following displaced entries one slot back
+      size_t mask = m_nBuckets - 1;
+      size_t i = entry.m_slot;
+      BOOST_ASSERT(m_slots[i].m_entry.get() == &entry);
+      for (size_t next = (i + 1) & mask;
+           static_cast<bool>(m_slots[next].m_entry) && (m_slots[next].m_hash & mask) != next;
+           i = next, next = (next + 1) & mask)
+        {
+          m_slots[i] = std::move(m_slots[next]);
+          m_slots[i].m_entry->m_slot = i;
+        }
+      m_slots[i].m_entry.reset();
+
+      if (entry.m_enumPrev != 0)
+        entry.m_enumPrev->m_enumNext = entry.m_enumNext;
+      else
+        m_enumFirst = entry.m_enumNext;
+      if (entry.m_enumNext != 0)
+        entry.m_enumNext->m_enumPrev = entry.m_enumPrev;
+      else
+        m_enumLast = entry.m_enumPrev;
+      return;
+    }
+
+  // remove this Entry and its Name Tree Node
+  name_tree::Node* node = entry.m_node;
+  name_tree::Node* nodePrev = node->m_prev;
+
+  // configure the previous node
+  if (nodePrev != 0)
+    {
+      // link the previous node to the next node
+      nodePrev->m_next = node->m_next;
+    }
+  else
+    {
+      m_buckets[entry.getHash() % m_nBuckets] = node->m_next;
+    }
+
+  // link the previous node with the next node (skip the erased one)
+  if (node->m_next != 0)
+    {
+      node->m_next->m_prev = nodePrev;
+      node->m_next = 0;
+    }
+
+  BOOST_ASSERT(node->m_next == 0);
+
+  entry.m_node = 0;
+  delete node;
+}
+
+// insert() is a private function, and called by only lookup()
+std::pair<shared_ptr<name_tree::Entry>, bool>
+NameTree::insert(const Name& prefix, size_t prefixLen, size_t hash)
+{
+  NFD_LOG_TRACE("insert " << prefix << " length " << prefixLen << " hash value = " << hash);
+
+  // Check if this Name has been stored
+  shared_ptr<name_tree::Entry> entry = findInTable(prefix, prefixLen, hash);
+  if (static_cast<bool>(entry))
+    {
+      return std::make_pair(entry, false); // false: old entry
+    }
+
+  NFD_LOG_TRACE("Did not find " << prefix.getPrefix(prefixLen) << ", need to insert it to the table");
+
+  // Create a new Entry
+  entry = make_shared<name_tree::Entry>(prefix.getPrefix(prefixLen));
+  entry->setHash(hash);
+  addToTable(entry);
 
   return std::make_pair(entry, true); // true: new entry
 }
@@ -203,18 +389,23 @@ NameTree::insert(const Name& prefix)
 // Name Prefix Lookup. Create Name Tree Entry if not found
 shared_ptr<name_tree::Entry>
 NameTree::lookup(const Name& prefix)
+{
+  return lookup(prefix, name_tree::computeHashSet(prefix));
+}
+
+shared_ptr<name_tree::Entry>
+NameTree::lookup(const Name& prefix, const std::vector<size_t>& hashSet)
 {
   NFD_LOG_TRACE("lookup " << prefix);
+  BOOST_ASSERT(hashSet.size() == prefix.size() + 1);
 
   shared_ptr<name_tree::Entry> entry;
   shared_ptr<name_tree::Entry> parent;
 
   for (size_t i = 0; i <= prefix.size(); i++)
     {
-      Name temp = prefix.getPrefix(i);
-
       // insert() will create the entry if it does not exist.
-      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(temp);
+      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(prefix, i, hashSet[i]);
       entry = ret.first;
 
       if (ret.second == true)
@@ -242,71 +433,42 @@ NameTree::lookup(const Name& prefix)
 shared_ptr<name_tree::Entry>
 NameTree::findExactMatch(const Name& prefix) const
 {
-  NFD_LOG_TRACE("findExactMatch " << prefix);
-
-  size_t hashValue = name_tree::computeHash(prefix);
-  size_t loc = hashValue % m_nBuckets;
-
-  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue <<
-                "  location = " << loc);
-
-  shared_ptr<name_tree::Entry> entry;
-  name_tree::Node* node = 0;
+  return findExactMatch(prefix, name_tree::computeHash(prefix));
+}
 
-  for (node = m_buckets[loc]; node != 0; node = node->m_next)
-    {
-      entry = node->m_entry;
-      if (static_cast<bool>(entry))
-        {
-          if (hashValue == entry->getHash() && prefix == entry->getPrefix())
-            {
-              return entry;
-            }
-        } // if entry
-    } // for node
+shared_ptr<name_tree::Entry>
+NameTree::findExactMatch(const Name& prefix, size_t hash) const
+{
+  NFD_LOG_TRACE("findExactMatch " << prefix << " hash value = " << hash);
 
-  // if not found, the default value of entry (null pointer) will be returned
-  entry.reset();
-  return entry;
+  return findInTable(prefix, prefix.size(), hash);
 }
 
 // Longest Prefix Match
 shared_ptr<name_tree::Entry>
 NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::EntrySelector& entrySelector) const
 {
-  NFD_LOG_TRACE("findLongestPrefixMatch " << prefix);
-
-  shared_ptr<name_tree::Entry> entry;
-  std::vector<size_t> hashValueSet = name_tree::computeHashSet(prefix);
+  return findLongestPrefixMatch(prefix, name_tree::computeHashSet(prefix), entrySelector);
+}
 
-  size_t hashValue = 0;
-  size_t loc = 0;
+shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatch(const Name& prefix, const std::vector<size_t>& hashSet,
+                                 const name_tree::EntrySelector& entrySelector) const
+{
+  NFD_LOG_TRACE("findLongestPrefixMatch " << prefix);
+  BOOST_ASSERT(hashSet.size() == prefix.size() + 1);
 
   for (int i = static_cast<int>(prefix.size()); i >= 0; i--)
     {
-      hashValue = hashValueSet[i];
-      loc = hashValue % m_nBuckets;
-
-      name_tree::Node* node = 0;
-      for (node = m_buckets[loc]; node != 0; node = node->m_next)
+      shared_ptr<name_tree::Entry> entry = findInTable(prefix, i, hashSet[i]);
+      if (static_cast<bool>(entry) && entrySelector(*entry))
         {
-          entry = node->m_entry;
-          if (static_cast<bool>(entry))
-            {
-              // isPrefixOf() is used to avoid making a copy of the name
-              if (hashValue == entry->getHash() &&
-                  entry->getPrefix().isPrefixOf(prefix) &&
-                  entrySelector(*entry))
-                {
-                  return entry;
-                }
-            } // if entry
-        } // for node
+          return entry;
+        }
     }
 
-  // if not found, the default value of entry (null pointer) will be returned
-  entry.reset();
-  return entry;
+  // if not found, return a null pointer
+  return shared_ptr<name_tree::Entry>();
 }
 
 shared_ptr<name_tree::Entry>
@@ -357,32 +519,8 @@ NameTree::eraseEntryIfEmpty(shared_ptr<name_tree::Entry> entry)
           BOOST_VERIFY(isFound == true);
         }
 
-      // remove this Entry and its Name Tree Node
-      name_tree::Node* node = entry->m_node;
-      name_tree::Node* nodePrev = node->m_prev;
-
-      // configure the previous node
-      if (nodePrev != 0)
-        {
-          // link the previous node to the next node
-          nodePrev->m_next = node->m_next;
-        }
-      else
-        {
-          m_buckets[entry->getHash() % m_nBuckets] = node->m_next;
-        }
-
-      // link the previous node with the next node (skip the erased one)
-      if (node->m_next != 0)
-        {
-          node->m_next->m_prev = nodePrev;
-          node->m_next = 0;
-        }
-
-      BOOST_ASSERT(node->m_next == 0);
-
+      removeFromTable(*entry);
       m_nItems--;
-      delete node;
 
       if (static_cast<bool>(parent))
         eraseEntryIfEmpty(parent);
@@ -408,13 +546,10 @@ NameTree::fullEnumerate(const name_tree::EntrySelector& entrySelector) const
   NFD_LOG_TRACE("fullEnumerate");
 
   // find the first eligible entry
-  for (size_t i = 0; i < m_nBuckets; i++) {
-    for (name_tree::Node* node = m_buckets[i]; node != 0; node = node->m_next) {
-      if (static_cast<bool>(node->m_entry) && entrySelector(*node->m_entry)) {
-        const_iterator it(FULL_ENUMERATE_TYPE, *this, node->m_entry, entrySelector);
-        return {it, end()};
-      }
-    }
+  shared_ptr<name_tree::Entry> entry = findNextInTable(nullptr, entrySelector);
+  if (static_cast<bool>(entry)) {
+    const_iterator it(FULL_ENUMERATE_TYPE, *this, entry, entrySelector);
+    return {it, end()};
   }
 
   // If none of the entry satisfies the requirements, then return the end() iterator.
@@ -462,7 +597,14 @@ NameTree::findAllMatches(const Name& prefix,
   // For trie-like design, it could be more efficient by walking down the
   // trie from the root node.
 
-  shared_ptr<name_tree::Entry> entry = findLongestPrefixMatch(prefix, entrySelector);
+  return findAllMatches(prefix, name_tree::computeHashSet(prefix), entrySelector);
+}
+
+boost::iterator_range<NameTree::const_iterator>
+NameTree::findAllMatches(const Name& prefix, const std::vector<size_t>& hashSet,
+                         const name_tree::EntrySelector& entrySelector) const
+{
+  shared_ptr<name_tree::Entry> entry = findLongestPrefixMatch(prefix, hashSet, entrySelector);
 
   if (static_cast<bool>(entry)) {
     const_iterator begin(FIND_ALL_MATCHES_TYPE, *this, entry, entrySelector);
@@ -472,12 +614,56 @@ NameTree::findAllMatches(const Name& prefix,
   return {end(), end()};
 }
 
+shared_ptr<name_tree::Entry>
+NameTree::findNextInTable(const name_tree::Entry* entry,
+                          const name_tree::EntrySelector& entrySelector) const
+{
+  if (m_backend == BACKEND_OPEN_ADDRESSING)
+    {
+      for (name_tree::Entry* next = entry == nullptr ? m_enumFirst : entry->m_enumNext;
+           next != 0; next = next->m_enumNext)
+        {
+          if (entrySelector(*next))
+            {
+              return next->shared_from_this();
+            }
+        }
+      return shared_ptr<name_tree::Entry>();
+    }
+
+  // process the entries in the same bucket first, then other buckets
+  size_t loc = entry == nullptr ? 0 : entry->getHash() % m_nBuckets;
+  name_tree::Node* node = entry == nullptr ? m_buckets[0] : entry->m_node->m_next;
+  while (true)
+    {
+      for (; node != 0; node = node->m_next)
+        {
+          if (static_cast<bool>(node->m_entry) && entrySelector(*node->m_entry))
+            {
+              return node->m_entry;
+            }
+        }
+
+      if (++loc >= m_nBuckets)
+        {
+          return shared_ptr<name_tree::Entry>();
+        }
+      node = m_buckets[loc];
+    }
+}
+
 // Hash Table Resize
 void
 NameTree::resize(size_t newNBuckets)
 {
   NFD_LOG_TRACE("resize");
 
+  if (m_backend == BACKEND_OPEN_ADDRESSING)
+    {
+      resizeSlots(newNBuckets);
+      return;
+    }
+
   name_tree::Node** newBuckets = new name_tree::Node*[newNBuckets];
   size_t count = 0;
 
@@ -530,54 +716,68 @@ NameTree::resize(size_t newNBuckets)
                                               static_cast<double>(m_nBuckets));
 }
 
-// For debugging
 void
-NameTree::dump(std::ostream& output) const
+NameTree::resizeSlots(size_t newNSlots)
 {
-  NFD_LOG_TRACE("dump()");
+  BOOST_ASSERT(newNSlots > m_nItems);
+  BOOST_ASSERT((newNSlots & (newNSlots - 1)) == 0);
 
-  name_tree::Node* node = 0;
-  shared_ptr<name_tree::Entry> entry;
+  std::vector<name_tree::Slot> oldSlots(newNSlots);
+  m_slots.swap(oldSlots);
+  m_nBuckets = newNSlots;
 
-  using std::endl;
-
-  for (size_t i = 0; i < m_nBuckets; i++)
+  for (name_tree::Slot& slot : oldSlots)
     {
-      for (node = m_buckets[i]; node != 0; node = node->m_next)
+      if (static_cast<bool>(slot.m_entry))
         {
-          entry = node->m_entry;
+          placeInSlots(std::move(slot.m_entry));
+        }
+    }
 
-          // if the Entry exist, dump its information
-          if (static_cast<bool>(entry))
-            {
-              output << "Bucket" << i << "\t" << entry->m_prefix.toUri() << endl;
-              output << "\t\tHash " << entry->m_hash << endl;
+  m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
+                                              static_cast<double>(m_nBuckets));
+  m_shrinkThreshold = static_cast<size_t>(m_shrinkLoadFactor *
+                                              static_cast<double>(m_nBuckets));
+}
 
-              if (static_cast<bool>(entry->m_parent))
-                {
-                  output << "\t\tparent->" << entry->m_parent->m_prefix.toUri();
-                }
-              else
-                {
-                  output << "\t\tROOT";
-                }
-              output << endl;
+// For debugging
+void
+NameTree::dump(std::ostream& output) const
+{
+  NFD_LOG_TRACE("dump()");
 
-              if (entry->m_children.size() != 0)
-                {
-                  output << "\t\tchildren = " << entry->m_children.size() << endl;
+  using std::endl;
 
-                  for (size_t j = 0; j < entry->m_children.size(); j++)
-                    {
-                      output << "\t\t\tChild " << j << " " <<
-                        entry->m_children[j]->getPrefix() << endl;
-                    }
-                }
+  for (shared_ptr<name_tree::Entry> entry = findNextInTable(nullptr, name_tree::AnyEntry());
+       static_cast<bool>(entry);
+       entry = findNextInTable(entry.get(), name_tree::AnyEntry()))
+    {
+      size_t i = m_backend == BACKEND_OPEN_ADDRESSING ? entry->m_slot :
+                                                        entry->m_hash % m_nBuckets;
+      output << "Bucket" << i << "\t" << entry->m_prefix.toUri() << endl;
+      output << "\t\tHash " << entry->m_hash << endl;
+
+      if (static_cast<bool>(entry->m_parent))
+        {
+          output << "\t\tparent->" << entry->m_parent->m_prefix.toUri();
+        }
+      else
+        {
+          output << "\t\tROOT";
+        }
+      output << endl;
 
-            } // if (static_cast<bool>(entry))
+      if (entry->m_children.size() != 0)
+        {
+          output << "\t\tchildren = " << entry->m_children.size() << endl;
 
-        } // for node
-    } // for int i
+          for (size_t j = 0; j < entry->m_children.size(); j++)
+            {
+              output << "\t\t\tChild " << j << " " <<
+                entry->m_children[j]->getPrefix() << endl;
+            }
+        }
+    } // for entry
 
   output << "Bucket count = " << m_nBuckets << endl;
   output << "Stored item = " << m_nItems << endl;
@@ -614,37 +814,12 @@ NameTree::const_iterator::operator++()
 
   if (m_type == FULL_ENUMERATE_TYPE) // fullEnumerate
     {
-      // process the entries in the same bucket first
-      while (m_entry->m_node->m_next != 0)
+      m_entry = m_nameTree->findNextInTable(m_entry.get(), *m_entrySelector);
+      if (!static_cast<bool>(m_entry))
         {
-          m_entry = m_entry->m_node->m_next->m_entry;
-          if ((*m_entrySelector)(*m_entry))
-            {
-              return *this;
-            }
+          // Reach the end()
+          m_entry = m_nameTree->m_end;
         }
-
-      // process other buckets
-
-      for (int newLocation = m_entry->m_hash % m_nameTree->m_nBuckets + 1;
-           newLocation < static_cast<int>(m_nameTree->m_nBuckets);
-           ++newLocation)
-        {
-          // process each bucket
-          name_tree::Node* node = m_nameTree->m_buckets[newLocation];
-          while (node != 0)
-            {
-              m_entry = node->m_entry;
-              if ((*m_entrySelector)(*m_entry))
-                {
-                  return *this;
-                }
-              node = node->m_next;
-            }
-        }
-
-      // Reach the end()
-      m_entry = m_nameTree->m_end;
       return *this;
     }
 
@@ -45,6 +45,52 @@ computeHash(const Name& prefix);
 std::vector<size_t>
 computeHashSet(const Name& prefix);
 
+/**
+ * \brief caches computeHashSet() of a packet's Name on the packet
+ */
+class HashSetTag : public ndn::Tag
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 0x4e540001;
+  }
+
+  explicit
+  HashSetTag(std::vector<size_t> hashSet)
+    : m_hashSet(std::move(hashSet))
+  {
+  }
+
+  const std::vector<size_t>&
+  get() const
+  {
+    return m_hashSet;
+  }
+
+private:
+  std::vector<size_t> m_hashSet;
+};
+
+/**
+ * \brief Get the hash values of all prefixes of an Interest or Data Name
+ * \details The values are computed on first use and kept in a HashSetTag on the
+ * packet, so every table consulted for the same packet reuses them.
+ * \note The Name of \p packet must not change afterwards.
+ */
+template<typename Packet>
+const std::vector<size_t>&
+getHashSet(const Packet& packet)
+{
+  shared_ptr<HashSetTag> tag = packet.template getTag<HashSetTag>();
+  if (tag == nullptr) {
+    tag = make_shared<HashSetTag>(computeHashSet(packet.getName()));
+    packet.setTag(tag);
+  }
+  return tag->get();
+}
+
 /// a predicate to accept or reject an Entry in find operations
 typedef function<bool (const Entry& entry)> EntrySelector;
 
@@ -81,8 +127,32 @@ class NameTree : noncopyable
 public:
   class const_iterator;
 
+  /**
+   * \brief hash table layouts
+   */
+  enum Backend {
+    /** \brief separately allocated Nodes chained from each bucket
+     */
+    BACKEND_CHAINED,
+    /** \brief a flat array of Slots probed linearly with Robin Hood displacement
+     */
+    BACKEND_OPEN_ADDRESSING
+  };
+
   explicit
-  NameTree(size_t nBuckets = 1024);
+  NameTree(size_t nBuckets = 1024, Backend backend = getDefaultBackend());
+
+  /**
+   * \brief Get the backend of NameTrees that do not choose one
+   */
+  static Backend
+  getDefaultBackend();
+
+  /**
+   * \brief Set the backend of NameTrees constructed afterwards without choosing one
+   */
+  static void
+  setDefaultBackend(Backend backend);
 
   ~NameTree();
 
@@ -101,6 +171,17 @@ public: // information
   size_t
   getNBuckets() const;
 
+  Backend
+  getBackend() const;
+
+  /**
+   * \brief Get the number of hash bucket probes made so far
+   * \details Every exact match, every inserted or found prefix during lookup()
+   * and every prefix tried by findLongestPrefixMatch() counts as one probe.
+   */
+  size_t
+  getNProbes() const;
+
   /**
    * \brief Dump all the information stored in the Name Tree for debugging.
    */
@@ -121,6 +202,13 @@ public: // mutation
   shared_ptr<name_tree::Entry>
   lookup(const Name& prefix);
 
+  /**
+   * \brief Look for the Name Tree Entry, using hash values computed beforehand
+   * \param hashSet computeHashSet() of \p prefix
+   */
+  shared_ptr<name_tree::Entry>
+  lookup(const Name& prefix, const std::vector<size_t>& hashSet);
+
   /**
    * \brief Delete a Name Tree Entry if this entry is empty.
    * \param entry The entry to be deleted if empty.
@@ -158,6 +246,13 @@ public: // matching
   shared_ptr<name_tree::Entry>
   findExactMatch(const Name& prefix) const;
 
+  /**
+   * \brief Exact match lookup, using a hash value computed beforehand
+   * \param hash computeHash() of \p prefix
+   */
+  shared_ptr<name_tree::Entry>
+  findExactMatch(const Name& prefix, size_t hash) const;
+
   /**
    * \brief Longest prefix matching for the given name
    * \details Starts from the full name string, reduce the number of name component
@@ -168,6 +263,15 @@ public: // matching
                          const name_tree::EntrySelector& entrySelector =
                          name_tree::AnyEntry()) const;
 
+  /**
+   * \brief Longest prefix matching, using hash values computed beforehand
+   * \param hashSet computeHashSet() of \p prefix
+   */
+  shared_ptr<name_tree::Entry>
+  findLongestPrefixMatch(const Name& prefix, const std::vector<size_t>& hashSet,
+                         const name_tree::EntrySelector& entrySelector =
+                         name_tree::AnyEntry()) const;
+
   shared_ptr<name_tree::Entry>
   findLongestPrefixMatch(shared_ptr<name_tree::Entry> entry,
                          const name_tree::EntrySelector& entrySelector =
@@ -191,6 +295,14 @@ public: // matching
   findAllMatches(const Name& prefix,
                  const name_tree::EntrySelector& entrySelector = name_tree::AnyEntry()) const;
 
+  /** \brief Enumerate all the name prefixes that satisfy the prefix and entrySelector,
+   *         using hash values computed beforehand
+   *  \param hashSet computeHashSet() of \p prefix
+   */
+  boost::iterator_range<const_iterator>
+  findAllMatches(const Name& prefix, const std::vector<size_t>& hashSet,
+                 const name_tree::EntrySelector& entrySelector = name_tree::AnyEntry()) const;
+
 public: // enumeration
   /** \brief Enumerate all entries, optionally filtered by an EntrySelector.
    *  \return an unspecified type that have .begin() and .end() methods
@@ -302,6 +414,43 @@ private:
   void
   resize(size_t newNBuckets);
 
+  void
+  resizeSlots(size_t newNSlots);
+
+  /**
+   * \brief Put an entry into a free Slot of the open-addressing table
+   */
+  void
+  placeInSlots(shared_ptr<name_tree::Entry> entry);
+
+  /**
+   * \brief Find the entry of the first \p prefixLen components of \p prefix
+   * \param hash computeHash() of that prefix
+   */
+  shared_ptr<name_tree::Entry>
+  findInTable(const Name& prefix, size_t prefixLen, size_t hash) const;
+
+  /**
+   * \brief Link a new entry into the hash table
+   */
+  void
+  addToTable(shared_ptr<name_tree::Entry> entry);
+
+  /**
+   * \brief Unlink an entry from the hash table
+   */
+  void
+  removeFromTable(name_tree::Entry& entry);
+
+  /**
+   * \brief Get the entry that follows \p entry in table order and satisfies \p entrySelector
+   * \param entry the entry to start after, or nullptr to start from the beginning
+   * \return the entry, or nullptr if there is none
+   */
+  shared_ptr<name_tree::Entry>
+  findNextInTable(const name_tree::Entry* entry,
+                  const name_tree::EntrySelector& entrySelector) const;
+
 private:
   size_t                        m_nItems;  // Number of items being stored
   size_t                        m_nBuckets; // Number of hash buckets
@@ -312,20 +461,28 @@ private:
   double                        m_shrinkLoadFactor;
   size_t                        m_shrinkThreshold;
   double                        m_shrinkFactor;
-  name_tree::Node**             m_buckets; // Name Tree Buckets in the NPHT
+  Backend                       m_backend;
+  name_tree::Node**             m_buckets; // Name Tree Buckets in the NPHT (chained)
+  std::vector<name_tree::Slot>  m_slots; // Name Tree Slots (open addressing)
+  name_tree::Entry*             m_enumFirst; // enumeration order (open addressing)
+  name_tree::Entry*             m_enumLast;
+  mutable size_t                m_nProbes; // Number of bucket probes
   shared_ptr<name_tree::Entry>  m_end;
   const_iterator                m_endIterator;
 
   /**
    * \brief Create a Name Tree Entry if it does not exist, or return the existing
    * Name Tree Entry address.
-   * \details Called by lookup() only.
+   * \details Called by lookup() only, for the first \p prefixLen components of
+   * \p prefix, whose hash is \p hash.
    * \return The first item is the Name Tree Entry address, the second item is
    * a bool value indicates whether this is an old entry (false) or a new
    * entry (true).
    */
   std::pair<shared_ptr<name_tree::Entry>, bool>
-  insert(const Name& prefix);
+  insert(const Name& prefix, size_t prefixLen, size_t hash);
+
+  static Backend s_defaultBackend;
 };
 
 inline NameTree::const_iterator::~const_iterator()
@@ -344,6 +501,18 @@ NameTree::getNBuckets() const
   return m_nBuckets;
 }
 
+inline NameTree::Backend
+NameTree::getBackend() const
+{
+  return m_backend;
+}
+
+inline size_t
+NameTree::getNProbes() const
+{
+  return m_nProbes;
+}
+
 inline shared_ptr<name_tree::Entry>
 NameTree::get(const fib::Entry& fibEntry) const
 {
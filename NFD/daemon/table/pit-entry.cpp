@@ -33,9 +33,13 @@ const Name Entry::LOCALHOST_NAME("ndn:/localhost");
 const Name Entry::LOCALHOP_NAME("ndn:/localhop");
 
 Entry::Entry(const Interest& interest)
-  : m_interest(interest.shared_from_this())
+  : m_unsatisfyWheelTimer(*this, false)
+  , m_stragglerWheelTimer(*this, true)
+  , m_interest(interest.shared_from_this())
   , m_destination_flag(false)
   , m_flood_flag(false)
+  , m_cachedStrategy(nullptr)
+  , m_cachedStrategyVersion(0)
 {
 }
 
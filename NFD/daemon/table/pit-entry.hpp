@@ -29,6 +29,8 @@
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
 #include "core/scheduler.hpp"
+#include "core/small-vector.hpp"
+#include "core/timer-wheel.hpp"
 
 namespace nfd {
 
@@ -38,15 +40,29 @@ namespace name_tree {
 class Entry;
 }
 
+namespace fw {
+class Strategy;
+}
+
 namespace pit {
 
+/** \brief number of InRecords stored inside a PIT entry before moving them to the heap
+ */
+const size_t IN_RECORDS_INLINE_CAPACITY = 1;
+
+/** \brief number of OutRecords stored inside a PIT entry before moving them to the heap
+ */
+const size_t OUT_RECORDS_INLINE_CAPACITY = 2;
+
 /** \brief represents an unordered collection of InRecords
+ *  \note inserting or deleting an InRecord invalidates iterators to all InRecords
  */
-typedef std::list< InRecord>  InRecordCollection;
+typedef SmallVector<InRecord, IN_RECORDS_INLINE_CAPACITY> InRecordCollection;
 
 /** \brief represents an unordered collection of OutRecords
+ *  \note inserting or deleting an OutRecord invalidates iterators to all OutRecords
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef SmallVector<OutRecord, OUT_RECORDS_INLINE_CAPACITY> OutRecordCollection;
 
 /** \brief indicates where duplicate Nonces are found
  */
@@ -62,9 +78,32 @@ enum DuplicateNonceWhere {
   DUPLICATE_NONCE_OUT_OTHER = (1 << 3)
 };
 
+class Entry;
+
+/** \brief the unsatisfy or straggler timer of a PIT entry on the forwarder's TimerWheel
+ */
+class EntryTimer : public TimerWheel::Timer
+{
+public:
+  EntryTimer(Entry& entry, bool isStraggler)
+    : entry(entry)
+    , isStraggler(isStraggler)
+    , isSatisfied(false)
+  {
+  }
+
+public:
+  Entry& entry;
+  /// false for the unsatisfy timer
+  const bool isStraggler;
+  /// arguments of the Interest Finalize pipeline, for the straggler timer
+  bool isSatisfied;
+  time::milliseconds dataFreshnessPeriod;
+};
+
 /** \brief represents a PIT entry
  */
-class Entry : public StrategyInfoHost, noncopyable
+class Entry : public StrategyInfoHost, noncopyable, public enable_shared_from_this<Entry>
 {
 public:
   explicit
@@ -181,9 +220,27 @@ public: // OutRecord
   bool
   hasUnexpiredOutRecords() const;
 
+public: // effective strategy cache
+  /** \brief get the cached effective strategy
+   *  \param version current version of the Strategy Choice table
+   *  \return the strategy cached under the same version, or nullptr
+   */
+  fw::Strategy*
+  getCachedStrategy(uint64_t version) const;
+
+  /** \brief cache the effective strategy found under version of the Strategy Choice table
+   *
+   *  This is a cache maintained by StrategyChoice, so it may be set on a const Entry.
+   */
+  void
+  setCachedStrategy(fw::Strategy& strategy, uint64_t version) const;
+
 public:
   scheduler::EventId m_unsatisfyTimer;
   scheduler::EventId m_stragglerTimer;
+  /// used instead of m_unsatisfyTimer and m_stragglerTimer if the forwarder has a TimerWheel
+  EntryTimer m_unsatisfyWheelTimer;
+  EntryTimer m_stragglerWheelTimer;
 
 private:
   shared_ptr<const Interest> m_interest;
@@ -197,6 +254,9 @@ private:
   bool m_destination_flag; //Onur 
   unsigned int m_flood_flag; //Onur 
 
+  mutable fw::Strategy* m_cachedStrategy;
+  mutable uint64_t m_cachedStrategyVersion;
+
   friend class nfd::NameTree;
   friend class nfd::name_tree::Entry;
 };
@@ -207,6 +267,19 @@ Entry::getInterest() const
   return *m_interest;
 }
 
+inline fw::Strategy*
+Entry::getCachedStrategy(uint64_t version) const
+{
+  return m_cachedStrategyVersion == version ? m_cachedStrategy : nullptr;
+}
+
+inline void
+Entry::setCachedStrategy(fw::Strategy& strategy, uint64_t version) const
+{
+  m_cachedStrategy = &strategy;
+  m_cachedStrategyVersion = version;
+}
+
 inline const InRecordCollection&
 Entry::getInRecords() const
 {
@@ -24,6 +24,7 @@
  */
 
 #include "pit.hpp"
+#include "core/pool-allocator.hpp"
 #include <type_traits>
 
 #include <boost/concept/assert.hpp>
@@ -66,7 +67,8 @@ Pit::insert(const Interest& interest)
 {
   // first lookup() the Interest Name in the NameTree, which will creates all
   // the intermedia nodes, starting from the shortest prefix.
-  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(interest.getName());
+  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(interest.getName(),
+                                                                 name_tree::getHashSet(interest));
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
   const std::vector<shared_ptr<pit::Entry>>& pitEntries = nameTreeEntry->getPitEntries();
@@ -81,7 +83,9 @@ Pit::insert(const Interest& interest)
     return { *it, false };
   }
 
-  shared_ptr<pit::Entry> entry = make_shared<pit::Entry>(interest);
+  // PIT entries are created and destroyed for every Interest, so they come from a pool
+  shared_ptr<pit::Entry> entry = std::allocate_shared<pit::Entry>(PoolAllocator<pit::Entry>(),
+                                                                  interest);
   nameTreeEntry->insertPitEntry(entry);
   m_nItems++;
   return { entry, true };
@@ -90,7 +94,7 @@ Pit::insert(const Interest& interest)
 pit::DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(),
+  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), name_tree::getHashSet(data),
     [] (const name_tree::Entry& entry) { return entry.hasPitEntries(); });
 
   pit::DataMatchResult matches;
@@ -36,9 +36,12 @@ using fw::Strategy;
 
 NFD_LOG_INIT("StrategyChoice");
 
+uint64_t StrategyChoice::s_lastVersion = 0;
+
 StrategyChoice::StrategyChoice(NameTree& nameTree, shared_ptr<Strategy> defaultStrategy)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_version(++s_lastVersion)
 {
   this->setDefaultStrategy(defaultStrategy);
 }
@@ -193,10 +196,16 @@ StrategyChoice::findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const
 Strategy&
 StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
 {
+  Strategy* strategy = pitEntry.getCachedStrategy(m_version);
+  if (strategy != nullptr)
+    return *strategy;
+
   shared_ptr<name_tree::Entry> nte = m_nameTree.get(pitEntry);
 
   BOOST_ASSERT(static_cast<bool>(nte));
-  return this->findEffectiveStrategy(nte);
+  Strategy& effectiveStrategy = this->findEffectiveStrategy(nte);
+  pitEntry.setCachedStrategy(effectiveStrategy, m_version);
+  return effectiveStrategy;
 }
 
 Strategy&
@@ -222,6 +231,7 @@ StrategyChoice::setDefaultStrategy(shared_ptr<Strategy> strategy)
   NFD_LOG_INFO("setDefaultStrategy " << strategy->getName());
 
   entry->setStrategy(*strategy);
+  m_version = ++s_lastVersion;
 }
 
 static inline void
@@ -256,6 +266,9 @@ StrategyChoice::changeStrategy(strategy_choice::Entry& entry,
                << " from " << oldStrategy.getName()
                << " to " << newStrategy.getName());
 
+  // invalidate effective strategies cached on PIT entries
+  m_version = ++s_lastVersion;
+
   // reset StrategyInfo on a portion of NameTree,
   // where entry's effective strategy is covered by the changing StrategyChoice entry
   const name_tree::Entry* rootNte = m_nameTree.get(entry).get();
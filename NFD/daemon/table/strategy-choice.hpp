@@ -93,7 +93,11 @@ public: // effective strategy
   fw::Strategy&
   findEffectiveStrategy(const Name& prefix) const;
 
-  /// get effective strategy for pitEntry
+  /** \brief get effective strategy for pitEntry
+   *
+   *  The result is cached on pitEntry, and reused until the effective strategy of
+   *  any prefix changes.
+   */
   fw::Strategy&
   findEffectiveStrategy(const pit::Entry& pitEntry) const;
 
@@ -137,6 +141,13 @@ public: // enumeration
   size_t
   size() const;
 
+  /** \return a version that changes whenever the effective strategy of any prefix changes
+   *
+   *  Versions are unique across all StrategyChoice instances, and never 0.
+   */
+  uint64_t
+  getVersion() const;
+
   const_iterator
   begin() const;
 
@@ -164,6 +175,9 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  uint64_t m_version;
+
+  static uint64_t s_lastVersion;
 
   typedef std::map<Name, shared_ptr<fw::Strategy> > StrategyInstanceTable;
   StrategyInstanceTable m_strategyInstances;
@@ -175,6 +189,12 @@ StrategyChoice::size() const
   return m_nItems;
 }
 
+inline uint64_t
+StrategyChoice::getVersion() const
+{
+  return m_version;
+}
+
 inline StrategyChoice::const_iterator
 StrategyChoice::end() const
 {
@@ -25,12 +25,24 @@
 
 #include "strategy-info-host.hpp"
 
+#include <atomic>
+
 namespace nfd {
 
+size_t
+StrategyInfoHost::allocateSlot()
+{
+  static std::atomic<size_t> nSlots(0);
+  return nSlots++;
+}
+
 void
 StrategyInfoHost::clearStrategyInfo()
 {
-  m_items.clear();
+  for (shared_ptr<fw::StrategyInfo>& item : m_inlineSlots) {
+    item.reset();
+  }
+  m_moreSlots.clear();
 }
 
 } // namespace nfd
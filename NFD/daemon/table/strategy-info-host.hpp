@@ -27,10 +27,16 @@
 #define NFD_DAEMON_TABLE_STRATEGY_INFO_HOST_HPP
 
 #include "fw/strategy-info.hpp"
+#include "core/pool-allocator.hpp"
 
 namespace nfd {
 
 /** \brief base class for an entity onto which StrategyInfo objects may be placed
+ *
+ *  Each StrategyInfo type is given a dense slot number the first time it is used with any
+ *  host. A host keeps the first few slots inline and the rest in a vector indexed by slot,
+ *  so that lookups do not search. Items made by getOrCreateStrategyInfo come from a pool
+ *  per type.
  */
 class StrategyInfoHost
 {
@@ -66,9 +72,51 @@ public:
   clearStrategyInfo();
 
 private:
-  std::map<int, shared_ptr<fw::StrategyInfo>> m_items;
+  /** \return slot number of StrategyInfo type T
+   */
+  template<typename T>
+  static size_t
+  getSlot();
+
+  static size_t
+  allocateSlot();
+
+  shared_ptr<fw::StrategyInfo>*
+  findSlot(size_t slot);
+
+  const shared_ptr<fw::StrategyInfo>*
+  findSlot(size_t slot) const;
+
+private:
+  static const size_t N_INLINE_SLOTS = 2;
+  shared_ptr<fw::StrategyInfo> m_inlineSlots[N_INLINE_SLOTS];
+  std::vector<shared_ptr<fw::StrategyInfo>> m_moreSlots; // slot N_INLINE_SLOTS onwards
 };
 
+template<typename T>
+size_t
+StrategyInfoHost::getSlot()
+{
+  static const size_t slot = allocateSlot();
+  return slot;
+}
+
+inline shared_ptr<fw::StrategyInfo>*
+StrategyInfoHost::findSlot(size_t slot)
+{
+  if (slot < N_INLINE_SLOTS) {
+    return &m_inlineSlots[slot];
+  }
+  slot -= N_INLINE_SLOTS;
+  return slot < m_moreSlots.size() ? &m_moreSlots[slot] : nullptr;
+}
+
+inline const shared_ptr<fw::StrategyInfo>*
+StrategyInfoHost::findSlot(size_t slot) const
+{
+  return const_cast<StrategyInfoHost*>(this)->findSlot(slot);
+}
+
 
 template<typename T>
 shared_ptr<T>
@@ -77,11 +125,11 @@ StrategyInfoHost::getStrategyInfo() const
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
-  auto it = m_items.find(T::getTypeId());
-  if (it == m_items.end()) {
+  const shared_ptr<fw::StrategyInfo>* item = this->findSlot(getSlot<T>());
+  if (item == nullptr) {
     return nullptr;
   }
-  return static_pointer_cast<T, fw::StrategyInfo>(it->second);
+  return static_pointer_cast<T, fw::StrategyInfo>(*item);
 }
 
 template<typename T>
@@ -91,12 +139,16 @@ StrategyInfoHost::setStrategyInfo(shared_ptr<T> item)
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
-  if (item == nullptr) {
-    m_items.erase(T::getTypeId());
-  }
-  else {
-    m_items[T::getTypeId()] = item;
+  size_t slot = getSlot<T>();
+  shared_ptr<fw::StrategyInfo>* existing = this->findSlot(slot);
+  if (existing == nullptr) {
+    if (item == nullptr) {
+      return;
+    }
+    m_moreSlots.resize(slot - N_INLINE_SLOTS + 1);
+    existing = &m_moreSlots.back();
   }
+  *existing = std::move(item);
 }
 
 template<typename T, typename ...A>
@@ -108,7 +160,7 @@ StrategyInfoHost::getOrCreateStrategyInfo(A&&... args)
 
   shared_ptr<T> item = this->getStrategyInfo<T>();
   if (!static_cast<bool>(item)) {
-    item = make_shared<T>(std::forward<A>(args)...);
+    item = std::allocate_shared<T>(PoolAllocator<T>(), std::forward<A>(args)...);
     this->setStrategyInfo(item);
   }
   return item;
@@ -46,6 +46,12 @@ FibUpdater::FibUpdater(Rib& rib, ndn::nfd::Controller& controller)
   rib.setFibUpdater(this);
 }
 
+void
+FibUpdater::setFibUpdateApplier(const FibUpdateApplier& applier)
+{
+  m_applyUpdate = applier;
+}
+
 void
 FibUpdater::computeAndSendFibUpdates(const RibUpdateBatch& batch,
                                      const FibUpdateSuccessCallback& onSuccess,
@@ -62,7 +68,12 @@ FibUpdater::computeAndSendFibUpdates(const RibUpdateBatch& batch,
 
   computeUpdates(batch);
 
-  sendUpdatesForBatchFaceId(onSuccess, onFailure);
+  if (m_applyUpdate != nullptr) {
+    applyUpdates(onSuccess, onFailure);
+  }
+  else {
+    sendUpdatesForBatchFaceId(onSuccess, onFailure);
+  }
 }
 
 void
@@ -207,6 +218,42 @@ FibUpdater::sendUpdates(const FibUpdateList& updates,
   }
 }
 
+void
+FibUpdater::applyUpdates(const FibUpdateSuccessCallback& onSuccess,
+                         const FibUpdateFailureCallback& onFailure)
+{
+  NFD_LOG_DEBUG("Applying " << m_updatesForBatchFaceId.size() + m_updatesForNonBatchFaceId.size()
+                            << " updates to FIB in process");
+
+  // all updates for the batch's face fail together if that face does not exist,
+  // so nothing has been applied when the first one fails
+  for (const FibUpdate& update : m_updatesForBatchFaceId) {
+    uint32_t code = m_applyUpdate(update);
+    if (code == ERROR_FACE_NOT_FOUND) {
+      NFD_LOG_DEBUG("Failed to apply " << update << " (face not found)");
+      onFailure(code, "Face not found");
+      return;
+    }
+    else if (code != 200) {
+      BOOST_THROW_EXCEPTION(Error("Non-recoverable error applying FIB update, code: " +
+                                  std::to_string(code)));
+    }
+  }
+
+  for (const FibUpdate& update : m_updatesForNonBatchFaceId) {
+    uint32_t code = m_applyUpdate(update);
+    if (code == ERROR_FACE_NOT_FOUND) {
+      NFD_LOG_DEBUG("Failed to apply " << update << " (face not found)");
+    }
+    else if (code != 200) {
+      BOOST_THROW_EXCEPTION(Error("Non-recoverable error applying FIB update, code: " +
+                                  std::to_string(code)));
+    }
+  }
+
+  onSuccess(m_inheritedRoutes);
+}
+
 void
 FibUpdater::sendUpdatesForBatchFaceId(const FibUpdateSuccessCallback& onSuccess,
                                       const FibUpdateFailureCallback& onFailure)
@@ -57,8 +57,19 @@ public:
   typedef function<void(RibUpdateList inheritedRoutes)> FibUpdateSuccessCallback;
   typedef function<void(uint32_t code, const std::string& error)> FibUpdateFailureCallback;
 
+  /** \brief applies one FibUpdate to a FIB in the same process
+   *  \return status code of the equivalent FIB command
+   */
+  typedef function<uint32_t(const FibUpdate& update)> FibUpdateApplier;
+
   FibUpdater(Rib& rib, ndn::nfd::Controller& controller);
 
+  /** \brief makes computeAndSendFibUpdates apply all FibUpdates of a batch through \p applier
+   *         before it returns, instead of sending a command to NFD for each of them
+   */
+  void
+  setFibUpdateApplier(const FibUpdateApplier& applier);
+
   /** \brief computes FibUpdates using the provided RibUpdateBatch and then sends the
    *         updates to NFD's FIB
    *
@@ -90,6 +101,16 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
               const FibUpdateSuccessCallback& onSuccess,
               const FibUpdateFailureCallback& onFailure);
 
+  /** \brief applies all computed updates through the FibUpdateApplier
+  *
+  *   Updates with the same Face ID as the batch are applied first, and the batch fails if
+  *   that face does not exist, as with commands.  Updates for other faces that do not exist
+  *   are ignored.
+  */
+  void
+  applyUpdates(const FibUpdateSuccessCallback& onSuccess,
+               const FibUpdateFailureCallback& onFailure);
+
   /** \brief sends the updates in m_updatesForBatchFaceId to NFD if any exist,
   *          otherwise calls FibUpdater::sendUpdatesForNonBatchFaceId.
   */
@@ -257,6 +278,7 @@ private:
 private:
   const Rib& m_rib;
   ndn::nfd::Controller& m_controller;
+  FibUpdateApplier m_applyUpdate;
   uint64_t m_batchFaceId;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
@@ -140,6 +140,12 @@ RibManager::setConfigFile(ConfigFile& configFile)
                                bind(&RibManager::onConfig, this, _1, _2, _3));
 }
 
+void
+RibManager::setFibUpdateApplier(const FibUpdater::FibUpdateApplier& applier)
+{
+  m_fibUpdater.setFibUpdateApplier(applier);
+}
+
 void
 RibManager::onConfig(const ConfigSection& configSection,
                      bool isDryRun,
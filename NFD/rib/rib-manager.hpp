@@ -74,6 +74,12 @@ public:
   void
   setConfigFile(ConfigFile& configFile);
 
+  /** \brief applies FIB updates for RIB changes through \p applier instead of FIB commands
+   *  \sa FibUpdater::setFibUpdateApplier
+   */
+  void
+  setFibUpdateApplier(const FibUpdater::FibUpdateApplier& applier);
+
   void
   onRibUpdateSuccess(const RibUpdate& update);
 
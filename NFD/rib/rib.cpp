@@ -42,6 +42,7 @@ sortRoutes(const Route& lhs, const Route& rhs)
 Rib::Rib()
   : m_nItems(0)
   , m_isUpdateInProgress(false)
+  , m_isSendingBatches(false)
 {
 }
 
@@ -237,10 +238,10 @@ Rib::findDescendantsForNonInsertedName(const Name& prefix) const
 {
   std::list<shared_ptr<RibEntry>> children;
 
-  for (std::pair<Name, shared_ptr<RibEntry>> pair : m_rib) {
-    if (prefix.isPrefixOf(pair.first)) {
-      children.push_back(pair.second);
-    }
+  // names under prefix directly follow it in the table
+  for (RibTable::const_iterator it = m_rib.lower_bound(prefix);
+       it != m_rib.end() && prefix.isPrefixOf(it->first); ++it) {
+    children.push_back(it->second);
   }
 
   return children;
@@ -376,32 +377,46 @@ Rib::addUpdateToQueue(const RibUpdate& update,
 void
 Rib::sendBatchFromQueue()
 {
-  if (m_updateBatches.empty() || m_isUpdateInProgress) {
+  // When FibUpdater applies updates in process, a batch completes before
+  // computeAndSendFibUpdates returns and calls this method again; that call returns
+  // at once and this loop sends the next batch, so the stack does not grow per batch.
+  if (m_isSendingBatches) {
     return;
   }
+  m_isSendingBatches = true;
 
-  m_isUpdateInProgress = true;
+  while (!m_updateBatches.empty() && !m_isUpdateInProgress) {
+    m_isUpdateInProgress = true;
 
-  UpdateQueueItem item = std::move(m_updateBatches.front());
-  m_updateBatches.pop_front();
+    UpdateQueueItem item = std::move(m_updateBatches.front());
+    m_updateBatches.pop_front();
 
-  RibUpdateBatch& batch = item.batch;
+    RibUpdateBatch& batch = item.batch;
 
-  // Until task #1698, each RibUpdateBatch contains exactly one RIB update
-  BOOST_ASSERT(batch.size() == 1);
+    // Until task #1698, each RibUpdateBatch contains exactly one RIB update
+    BOOST_ASSERT(batch.size() == 1);
 
-  const Rib::UpdateSuccessCallback& managerSuccessCallback = item.managerSuccessCallback;
-  const Rib::UpdateFailureCallback& managerFailureCallback = item.managerFailureCallback;
+    const Rib::UpdateSuccessCallback& managerSuccessCallback = item.managerSuccessCallback;
+    const Rib::UpdateFailureCallback& managerFailureCallback = item.managerFailureCallback;
 
-  m_fibUpdater->computeAndSendFibUpdates(batch,
-                                         bind(&Rib::onFibUpdateSuccess, this,
-                                              batch, _1, managerSuccessCallback),
-                                         bind(&Rib::onFibUpdateFailure, this,
-                                              managerFailureCallback, _1, _2));
+    try {
+      m_fibUpdater->computeAndSendFibUpdates(batch,
+                                             bind(&Rib::onFibUpdateSuccess, this,
+                                                  batch, _1, managerSuccessCallback),
+                                             bind(&Rib::onFibUpdateFailure, this,
+                                                  managerFailureCallback, _1, _2));
+    }
+    catch (...) {
+      m_isSendingBatches = false;
+      throw;
+    }
 
-  if (m_onSendBatchFromQueue != nullptr) {
-    m_onSendBatchFromQueue(batch);
+    if (m_onSendBatchFromQueue != nullptr) {
+      m_onSendBatchFromQueue(batch);
+    }
   }
+
+  m_isSendingBatches = false;
 }
 
 void
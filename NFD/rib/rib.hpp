@@ -33,6 +33,8 @@
 
 #include <ndn-cxx/management/nfd-control-parameters.hpp>
 
+#include <unordered_map>
+
 namespace nfd {
 namespace rib {
 
@@ -48,7 +50,7 @@ public:
   typedef std::list<shared_ptr<RibEntry>> RibEntryList;
   typedef std::map<Name, shared_ptr<RibEntry>> RibTable;
   typedef RibTable::const_iterator const_iterator;
-  typedef std::map<uint64_t, std::list<shared_ptr<RibEntry>>> FaceLookupTable;
+  typedef std::unordered_map<uint64_t, std::list<shared_ptr<RibEntry>>> FaceLookupTable;
   typedef bool (*RouteComparePredicate)(const Route&, const Route&);
   typedef std::set<Route, RouteComparePredicate> RouteSet;
 
@@ -231,6 +233,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   bool m_isUpdateInProgress;
+  bool m_isSendingBatches; ///< sendBatchFromQueue is on the stack
 };
 
 inline Rib::const_iterator
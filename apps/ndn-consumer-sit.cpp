@@ -60,6 +60,11 @@ ConsumerSit::GetTypeId(void)
                     IntegerValue(std::numeric_limits<uint32_t>::max()),
                     MakeIntegerAccessor(&ConsumerSit::m_seqMax), MakeIntegerChecker<uint32_t>())
 
+      .AddAttribute("ChunkInterval", "Time between chunks of a flow, in seconds",
+                    DoubleValue(0.008192), // 1024 bytes at 10 Mbps
+                    MakeDoubleAccessor(&ConsumerSit::m_chunkInterval),
+                    MakeDoubleChecker<double>(0.0))
+
     ;
 
   return tid;
@@ -68,6 +73,7 @@ ConsumerSit::GetTypeId(void)
 ConsumerSit::ConsumerSit()
   : m_frequency(1.0)
   , m_firstTime(true)
+  , m_chunkInterval(0.008192)
 {
   NS_LOG_FUNCTION_NOARGS();
   m_seqMax = std::numeric_limits<uint32_t>::max();
@@ -88,6 +94,49 @@ ConsumerSit::ScheduleNextPacket()
   }
 }
 
+void
+ConsumerSit::AddFlow(uint32_t prefixNumber, uint32_t firstChunk, uint32_t nChunks, uint32_t scope,
+                     double startTime)
+{
+  if (nChunks == 0)
+    return;
+
+  Flow flow = {prefixNumber, firstChunk, firstChunk + nChunks, scope, startTime};
+  auto i = m_flows.insert(std::make_pair(Seconds(startTime), flow));
+
+  // equal keys are inserted last, so the pending event only moves for a strictly earlier flow
+  if (i == m_flows.begin()) {
+    Simulator::Cancel(m_sendEvent);
+    ScheduleNextFlowChunk();
+  }
+}
+
+void
+ConsumerSit::ScheduleNextFlowChunk()
+{
+  if (m_flows.empty())
+    return;
+
+  m_sendEvent = Simulator::Schedule(m_flows.begin()->first - Simulator::Now(),
+                                    &ConsumerSit::SendNextFlowChunk, this);
+}
+
+void
+ConsumerSit::SendNextFlowChunk()
+{
+  Flow flow = m_flows.begin()->second;
+  m_flows.erase(m_flows.begin());
+
+  SendPacketWithSeq(flow.prefixNumber, flow.nextChunk, flow.scope);
+
+  if (++flow.nextChunk < flow.endChunk) {
+    flow.nextSendTime += m_chunkInterval;
+    m_flows.insert(std::make_pair(Seconds(flow.nextSendTime), flow));
+  }
+
+  ScheduleNextFlowChunk();
+}
+
 void
 ConsumerSit::SetRandomize(const std::string& value)
 {
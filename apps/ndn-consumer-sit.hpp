@@ -24,6 +24,8 @@
 
 #include "ndn-consumer.hpp"
 
+#include <map>
+
 namespace ns3 {
 namespace ndn {
 
@@ -43,6 +45,25 @@ public:
   ConsumerSit();
   virtual ~ConsumerSit();
 
+  /**
+   * @brief Request chunks [firstChunk, firstChunk + nChunks) from producer prefixNumber
+   *
+   * The first chunk is sent at startTime and each following one ChunkInterval seconds
+   * later.  Chunks of all flows of the app are sent from a single pending event, so the
+   * number of scheduled events does not grow with the number of chunks.
+   *
+   * @param startTime Absolute send time of the first chunk, in seconds (not in the past)
+   */
+  void
+  AddFlow(uint32_t prefixNumber, uint32_t firstChunk, uint32_t nChunks, uint32_t scope,
+          double startTime);
+
+  /**
+   * @brief Number of flows that still have chunks to send
+   */
+  size_t
+  GetNActiveFlows() const;
+
 protected:
   /**
    * \brief Constructs the Interest packet and sends it using a callback to the underlying NDN
@@ -65,13 +86,41 @@ protected:
   std::string
   GetRandomize() const;
 
+private:
+  /**
+   * @brief Send the next chunk of the earliest flow and schedule the following one
+   */
+  void
+  SendNextFlowChunk();
+
+  void
+  ScheduleNextFlowChunk();
+
 protected:
   double m_frequency; // Frequency of interest packets (in hertz)
   bool m_firstTime;
   Ptr<RandomVariableStream> m_random;
   std::string m_randomType;
+
+private:
+  struct Flow {
+    uint32_t prefixNumber;
+    uint32_t nextChunk;
+    uint32_t endChunk;
+    uint32_t scope;
+    double nextSendTime; // accumulated in seconds, as the time of the first chunk was given
+  };
+
+  double m_chunkInterval;            // seconds between chunks of one flow
+  std::multimap<Time, Flow> m_flows; // ordered by send time of the next chunk, FIFO for ties
 };
 
+inline size_t
+ConsumerSit::GetNActiveFlows() const
+{
+  return m_flows.size();
+}
+
 } // namespace ndn
 } // namespace ns3
 
@@ -55,7 +55,14 @@ ConsumerZipfMandelbrot::GetTypeId(void)
       .AddAttribute("s", "parameter of power", StringValue("0.7"),
                     MakeDoubleAccessor(&ConsumerZipfMandelbrot::SetS,
                                        &ConsumerZipfMandelbrot::GetS),
-                    MakeDoubleChecker<double>());
+                    MakeDoubleChecker<double>())
+
+      .AddAttribute("Sampling",
+                    "Sampling method: binary-search (default) or alias (O(1), different sequence)",
+                    StringValue("binary-search"),
+                    MakeStringAccessor(&ConsumerZipfMandelbrot::SetSampling,
+                                       &ConsumerZipfMandelbrot::GetSampling),
+                    MakeStringChecker());
 
   return tid;
 }
@@ -64,6 +71,7 @@ ConsumerZipfMandelbrot::ConsumerZipfMandelbrot()
   : m_N(100) // needed here to make sure when SetQ/SetS are called, there is a valid value of N
   , m_q(0.7)
   , m_s(0.7)
+  , m_sampling(ZipfMandelbrotTable::BINARY_SEARCH)
   , m_seqRng(CreateObject<UniformRandomVariable>())
 {
   // SetNumberOfContents is called by NS-3 object system during the initialization
@@ -73,6 +81,7 @@ ConsumerZipfMandelbrot::ConsumerZipfMandelbrot(uint32_t num_contents, double q,
   : m_N(num_contents) // needed here to make sure when SetQ/SetS are called, there is a valid value of N
   , m_q(q)
   , m_s(s)
+  , m_sampling(ZipfMandelbrotTable::BINARY_SEARCH)
   , m_seqRng(CreateObject<UniformRandomVariable>())
 {
   // SetNumberOfContents is called by NS-3 object system during the initialization
@@ -87,20 +96,7 @@ void
 ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 {
   m_N = numOfContents;
-
-  NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
-
-  m_Pcum = std::vector<double>(m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
-  }
-
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  m_table.reset();
 }
 
 uint32_t
@@ -113,7 +109,7 @@ void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
   m_q = q;
-  SetNumberOfContents(m_N);
+  m_table.reset();
 }
 
 double
@@ -126,7 +122,7 @@ void
 ConsumerZipfMandelbrot::SetS(double s)
 {
   m_s = s;
-  SetNumberOfContents(m_N);
+  m_table.reset();
 }
 
 double
@@ -135,6 +131,25 @@ ConsumerZipfMandelbrot::GetS() const
   return m_s;
 }
 
+void
+ConsumerZipfMandelbrot::SetSampling(const std::string& value)
+{
+  if (value == "alias")
+    m_sampling = ZipfMandelbrotTable::ALIAS;
+  else if (value == "binary-search")
+    m_sampling = ZipfMandelbrotTable::BINARY_SEARCH;
+  else
+    NS_FATAL_ERROR("Unknown sampling method: " << value);
+
+  m_table.reset();
+}
+
+std::string
+ConsumerZipfMandelbrot::GetSampling() const
+{
+  return m_sampling == ZipfMandelbrotTable::ALIAS ? "alias" : "binary-search";
+}
+
 void
 ConsumerZipfMandelbrot::SendPacket()
 {
@@ -211,24 +226,17 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
-  uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
+  if (m_table == nullptr) {
+    m_table = ZipfMandelbrotTable::Get(m_N, m_q, m_s, m_sampling);
+  }
 
   double p_random = m_seqRng->GetValue();
   while (p_random == 0) {
     p_random = m_seqRng->GetValue();
   }
-  // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  uint32_t content_index = m_table->Sample(p_random); //[1, m_N]
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
@@ -37,6 +37,8 @@
 #include "ns3/double.h"
 #include "ns3/random-variable-stream.h"
 
+#include "ns3/ndnSIM/utils/ndn-zipf-mandelbrot-table.hpp"
+
 namespace ns3 {
 namespace ndn {
 
@@ -90,11 +92,19 @@ private:
   double
   GetS() const;
 
+  void
+  SetSampling(const std::string& value);
+
+  std::string
+  GetSampling() const;
+
 private:
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  ZipfMandelbrotTable::Method m_sampling;
+  shared_ptr<const ZipfMandelbrotTable> m_table; // shared by all apps with the same parameters,
+                                                 // looked up on first use
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
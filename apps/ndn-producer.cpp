@@ -21,6 +21,7 @@
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
@@ -65,7 +66,12 @@ Producer::GetTypeId(void)
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker());
+                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker())
+      .AddAttribute("UseDataTemplate",
+                    "Make Data packets from a shared pre-encoded template instead of "
+                    "encoding each one",
+                    BooleanValue(true), MakeBooleanAccessor(&Producer::m_useDataTemplate),
+                    MakeBooleanChecker());
   return tid;
 }
 
@@ -82,6 +88,11 @@ Producer::StartApplication()
   App::StartApplication();
 
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
+
+  if (m_useDataTemplate) {
+    m_dataTemplate = DataTemplate::Get(m_virtualPayloadSize, m_freshness, m_signature,
+                                       m_keyLocator);
+  }
 }
 
 void
@@ -90,6 +101,7 @@ Producer::StopApplication()
   NS_LOG_FUNCTION_NOARGS();
 
   App::StopApplication();
+  m_dataTemplate.reset();
 }
 
 void
@@ -106,28 +118,17 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   // dataName.append(m_postfix);
   // dataName.appendVersion();
 
-  auto data = make_shared<Data>();
-  data->setName(dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
+  shared_ptr<Data> data;
+  if (m_dataTemplate != nullptr) {
+    data = m_dataTemplate->Make(dataName);
+  }
+  else {
+    data = DataTemplate::Encode(dataName, m_virtualPayloadSize, m_freshness, m_signature,
+                                m_keyLocator);
   }
-
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-  data->setSignature(signature);
 
   //NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
-  // to create real wire encoding
-  data->wireEncode();
   if(data->getName().size() == 3)
     NFD_LOG_INFO("> Data for " << data->getName().at(-2).toNumber()<<"/"<<data->getName().at(-1).toSequenceNumber());
 
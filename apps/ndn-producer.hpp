@@ -24,6 +24,7 @@
 
 #include "ndn-app.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
@@ -39,6 +40,10 @@ namespace ndn {
  * which replying every incoming Interest with Data packet with a specified
  * size and name same as in Interest.cation, which replying every incoming Interest
  * with Data packet with a specified size and name same as in Interest.
+ *
+ * Unless UseDataTemplate is false, Data packets are made from a DataTemplate shared by all
+ * producers with the same payload size, freshness and signature, which is built when the
+ * application starts.
  */
 class Producer : public App {
 public:
@@ -67,6 +72,9 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  bool m_useDataTemplate;
+  shared_ptr<const DataTemplate> m_dataTemplate;
 };
 
 } // namespace ndn
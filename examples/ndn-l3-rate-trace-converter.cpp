@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
+
+#include <fstream>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Converts a trace written by L3RateTracer with FORMAT_BINARY into the TSV trace that
+ * FORMAT_TSV would have written:
+ *
+ *     ./waf --run="ndn-l3-rate-trace-converter --input=rate-trace.bin --output=rate-trace.txt"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary trace written by L3RateTracer", input);
+  cmd.AddValue("output", "TSV file to write (-: standard output)", output);
+  cmd.Parse(argc, argv);
+
+  std::ifstream is(input.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    std::cerr << "Cannot open " << input << "\n";
+    return 1;
+  }
+
+  std::ofstream os;
+  if (output != "-") {
+    os.open(output.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if (!os.is_open()) {
+      std::cerr << "Cannot open " << output << " for writing\n";
+      return 1;
+    }
+  }
+
+  if (!ndn::L3RateTracer::ConvertToTsv(is, os.is_open() ? os : std::cout)) {
+    std::cerr << input << " is not a binary L3 rate trace\n";
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/utils/tracers/ndn-sit-event-log.hpp"
+
+#include <fstream>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Converts a log written by ndn-sit-test --event_log=<file> into CSV and/or prints its
+ * summary (event counts, Content Store hit ratio by Destination Flag, hops per delivery):
+ *
+ *     ./waf --run="ndn-sit-event-log-reader --input=events.bin --csv=events.csv --summary=1"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string csv;
+  bool summary = true;
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Event log written by SitEventLog", input);
+  cmd.AddValue("csv", "CSV file to write (empty: no CSV)", csv);
+  cmd.AddValue("summary", "Print aggregate statistics", summary);
+  cmd.Parse(argc, argv);
+
+  std::ifstream is(input.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    std::cerr << "Cannot open " << input << "\n";
+    return 1;
+  }
+
+  std::ofstream os;
+  if (!csv.empty()) {
+    os.open(csv.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if (!os.is_open()) {
+      std::cerr << "Cannot open " << csv << " for writing\n";
+      return 1;
+    }
+    ndn::SitEventLog::WriteCsvHeader(os);
+  }
+
+  ndn::SitEventLog::Summary stats;
+  bool isValid = ndn::SitEventLog::Read(is, [&] (const ndn::SitEventLog::Event& event) {
+      if (os.is_open())
+        ndn::SitEventLog::WriteCsv(os, event);
+      stats.Add(event);
+    });
+  if (!isValid) {
+    std::cerr << input << " is not a SIT event log\n";
+    return 1;
+  }
+
+  if (summary)
+    stats.Print(std::cout);
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -54,6 +54,12 @@
 
 // for obtaining forwarder of a node
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/name-tree.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/dead-nonce-list.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+// for the binary SIT event log
+#include "ns3/ndnSIM/utils/tracers/ndn-sit-event-log.hpp"
 
 //string comparison case insensitive
 #include <boost/algorithm/string.hpp>
@@ -153,6 +159,154 @@ void Schedule_Send(ApplicationContainer consumer_apps, uint32_t app_indx, double
   }
 }
 
+/**
+ * Flow arrivals of the scenario: Zipf-distributed content, a uniformly chosen consumer app and
+ * exponential inter-arrival times.  Arrivals are first drawn for the initialization period,
+ * until 30% of the contents have been requested, and then, 10 seconds later, for the
+ * observation period.
+ *
+ * Arrivals are drawn one at a time, in the same order for both the prescheduled and the lazy
+ * mode, so a given seed produces the same flows in both.
+ */
+class SitArrivalProcess
+{
+public:
+  struct Arrival
+  {
+    double time;
+    uint32_t app_indx;
+    uint32_t producer_indx;
+    uint32_t content_indx;
+    uint32_t scope;
+  };
+
+  SitArrivalProcess(NodeContainer &nodes, uint32_t num_apps, uint32_t num_producers, int num_contents,
+                    double zipf_exponent, double connection_rate, double simulation_length,
+                    uint32_t scoped_downstream_counter, uint32_t num_chunks, uint32_t seed)
+    : m_nodes(nodes)
+    , m_num_apps(num_apps)
+    , m_num_producers(num_producers)
+    , m_num_contents(num_contents)
+    , m_simulation_length(simulation_length)
+    , m_scoped_downstream_counter(scoped_downstream_counter)
+    , m_num_chunks(num_chunks)
+    , m_content_dist(num_contents, 0, zipf_exponent)
+    , m_rng_exp_con(connection_rate)
+    , m_in_observation(false)
+    , m_done(false)
+    , m_connect_time(0.2)
+    , m_init_period_len(0)
+    , m_diameter(0)
+    , m_num_connected(0)
+    , m_num_contents_requested(0)
+  {
+    std::random_device rd;
+    m_rnd_gen.seed(seed != 0 ? seed : rd()); //initialize the random number generator
+    NS_LOG_INFO("Beginning of Initialization Period");
+  }
+
+  /**
+   * Draws the next arrival
+   * \return false once the observation period is over
+   */
+  bool
+  Next(Arrival &arrival)
+  {
+    if(m_done)
+      return false;
+
+    arrival.time = m_connect_time;
+    arrival.content_indx = m_content_dist.GetNextSeq();
+    arrival.producer_indx = arrival.content_indx%m_num_producers;
+    arrival.app_indx = m_rnd_gen()%m_num_apps;
+    uint32_t cost = get_cost(m_nodes, arrival.app_indx, arrival.producer_indx);
+    arrival.scope = cost + m_scoped_downstream_counter;
+    m_num_connected++;
+    if(!m_in_observation)
+    {
+      if(cost > m_diameter){
+        m_diameter = cost;
+      }
+      if(cost == 0 && (arrival.app_indx != arrival.producer_indx)){
+        std::cout<<"This should not happen; cost is 0 for different nodes\n";
+      }
+    }
+    m_connect_time = m_connect_time + m_rng_exp_con(m_rnd_gen);
+
+    if(!m_requested_content[arrival.content_indx])
+    {
+      m_requested_content[arrival.content_indx]++;
+      m_num_contents_requested++;
+    }
+
+    if(!m_in_observation && m_num_contents_requested >= (0.3 *(1.0*m_num_contents)))
+    {
+      NS_LOG_INFO("Initialization complete "<<m_num_connected*m_num_chunks); //initialization is complete after this many interests
+      m_requested_content.clear();
+      m_connect_time += 10.0;
+      m_init_period_len = m_connect_time;
+      m_num_contents_requested = 0;
+      m_num_connected = 0;
+      m_in_observation = true;
+    }
+    else if(m_in_observation && m_connect_time >= (m_init_period_len + m_simulation_length))
+    {
+      NS_LOG_INFO("Graph Diameter: "<<m_diameter);
+      NS_LOG_INFO("Observation complete: Number of Unique content during observation: "<<m_num_contents_requested);
+      NS_LOG_INFO("Observation complete: Number of requests during observation: "<<m_num_connected);
+      m_done = true;
+    }
+    return true;
+  }
+
+  /// end of the simulation, or 0 while still in the initialization period
+  double
+  GetStopTime() const
+  {
+    return m_in_observation ? m_init_period_len + m_simulation_length + 2 : 0;
+  }
+
+private:
+  NodeContainer &m_nodes;
+  uint32_t m_num_apps;
+  uint32_t m_num_producers;
+  int m_num_contents;
+  double m_simulation_length;
+  uint32_t m_scoped_downstream_counter;
+  uint32_t m_num_chunks;
+
+  ndn::ConsumerZipfMandelbrot m_content_dist;
+  std::exponential_distribution<double> m_rng_exp_con;
+  std::mt19937 m_rnd_gen;
+
+  bool m_in_observation;
+  bool m_done;
+  double m_connect_time;
+  double m_init_period_len;
+  uint32_t m_diameter;
+  uint32_t m_num_connected; //number of connected applications/users
+  uint32_t m_num_contents_requested; //number of unique content items requested in the current period
+  std::map<int, int> m_requested_content; //the number of each content connected at each node
+};
+
+// Hands an arrival to its app, which paces the chunks, and schedules the next arrival
+void Start_Flow(SitArrivalProcess *arrivals, ApplicationContainer *consumer_apps, SitArrivalProcess::Arrival arrival, uint32_t num_chunks)
+{
+  Ptr<ndn::ConsumerSit> cons = DynamicCast<ndn::ConsumerSit>(consumer_apps->Get(arrival.app_indx));
+  cons->AddFlow(arrival.producer_indx, arrival.content_indx, num_chunks, arrival.scope, arrival.time);
+
+  double stop_time = arrivals->GetStopTime();
+  SitArrivalProcess::Arrival next;
+  if(arrivals->Next(next))
+  {
+    Simulator::Schedule(Seconds(next.time) - Simulator::Now(), &Start_Flow, arrivals, consumer_apps, next, num_chunks);
+  }
+  if(stop_time == 0 && arrivals->GetStopTime() != 0)
+  {
+    Simulator::Stop(Seconds(arrivals->GetStopTime()) - Simulator::Now());
+  }
+}
+
 // Run with: NS_LOG=ndn.Consumer=info:SitTest=info:ndn.cs.Lru=info:nfd.FibManager=info:nfd.Forwarder=info:nfd.Cfib=info:nfd.FibEntry=info
 int
 main(int argc, char* argv[])
@@ -169,7 +323,6 @@ main(int argc, char* argv[])
   LogComponentEnable("ndn.cs.ProbabilityImpl", LOG_PREFIX_ALL);   */
 
   //Parameters of the simulation (to be read from the command line)
-  int diameter=0;
   int num_contents;
   double connection_rate;
   double simulation_length;
@@ -181,6 +334,17 @@ main(int argc, char* argv[])
   uint32_t num_chunks = 1;
   std::string strategy;
   uint32_t sit_size = 0;
+  uint32_t sit_max_nexthops = 0;
+  uint32_t routing_threads = 0;
+  bool routing_stats = false;
+  uint32_t seed = 0;
+  bool preschedule_flows = false;
+  std::string name_tree = "chained";
+  std::string dead_nonce_list = "scheduled";
+  double pit_timer_tick = 0;
+  std::string event_log;
+  std::string event_types = "all";
+  std::string topology_cache;
 
   if(argc < 12)
   {
@@ -206,7 +370,41 @@ main(int argc, char* argv[])
   cmd.AddValue ("num_chunks", "Number of chunks each flow requests", num_chunks);
   cmd.AddValue ("strategy", "Forwarding strategy: send to all or one", strategy);
   cmd.AddValue ("sit_size", "SIT table size", sit_size);
+  cmd.AddValue ("sit_max_nexthops", "Max. next hops per SIT entry (0: unlimited)", sit_max_nexthops);
+  cmd.AddValue ("routing_threads", "Threads used to calculate routes (0: all hardware threads)", routing_threads);
+  cmd.AddValue ("routing_stats", "Report route calculation time and peak memory", routing_stats);
+  cmd.AddValue ("seed", "Seed of the flow arrival generator (0: random)", seed);
+  cmd.AddValue ("preschedule_flows", "Schedule all chunk requests before the simulation starts", preschedule_flows);
+  cmd.AddValue ("name_tree", "NameTree hash table: chained or open-addressing", name_tree);
+  cmd.AddValue ("dead_nonce_list", "Dead Nonce List timing: scheduled or lazy (no idle events)", dead_nonce_list);
+  cmd.AddValue ("pit_timer_tick", "Tick in ms of the PIT timer wheel (0: one event per PIT timer)", pit_timer_tick);
+  cmd.AddValue ("event_log", "Binary SIT event log file (empty: no log)", event_log);
+  cmd.AddValue ("event_types", "Comma-separated event types to log, or all", event_types);
+  cmd.AddValue ("topology_cache", "Directory of estimated topology cache files (empty: no cache)", topology_cache);
   cmd.Parse(argc, argv);
+
+  // forwarders are created when the stack is installed, so their NameTrees, Dead Nonce
+  // Lists and PIT timers pick these up
+  if (name_tree == "open-addressing")
+    nfd::NameTree::setDefaultBackend(nfd::NameTree::BACKEND_OPEN_ADDRESSING);
+  else
+    nfd::NameTree::setDefaultBackend(nfd::NameTree::BACKEND_CHAINED);
+
+  if (dead_nonce_list == "lazy")
+    nfd::DeadNonceList::setDefaultMode(nfd::DeadNonceList::MODE_LAZY);
+  else
+    nfd::DeadNonceList::setDefaultMode(nfd::DeadNonceList::MODE_SCHEDULED);
+
+  nfd::Forwarder::setDefaultPitTimerTick(
+    ::ndn::time::nanoseconds(static_cast<int64_t>(pit_timer_tick * 1000000)));
+
+  if (!event_log.empty()) {
+    if (!ndn::SitEventLog::Enable(event_types)) {
+      std::cout << "Invalid event_types: " << event_types << "\n";
+      exit(1);
+    }
+    ndn::SitEventLog::Open(event_log);
+  }
   
 // Prepare the Topology
   // Read Rocketfuel topology and set producer 
@@ -230,7 +428,13 @@ main(int argc, char* argv[])
   RocketfuelMapReader topo_reader("", 10);
   std::string topo_file_name = "/home/uceeoas/maps/" + topology_file;
   topo_reader.SetFileName(topo_file_name);
+  // fixed streams keep link parameters independent of other random variables,
+  // which the topology cache requires
+  topo_reader.AssignStreams(0);
+  topo_reader.SetCacheDirectory(topology_cache);
   NodeContainer nodes = topo_reader.Read(params, true, true);
+  std::cout << "Topology loaded " << (topo_reader.IsLoadedFromCache() ? "from cache" : "from map")
+            << " in " << topo_reader.GetLoadTime() << " s\n";
 //*/
   // Read network (infrastructure) topology from a file 
   /*
@@ -251,14 +455,14 @@ main(int argc, char* argv[])
   NS_LOG_INFO("Number of chunks "<<num_chunks);
   NS_LOG_INFO("Strategy: "<<strategy);
   NS_LOG_INFO("Sit_size: "<<sit_size);
+  NS_LOG_INFO("Sit_max_nexthops: "<<sit_max_nexthops);
+  NS_LOG_INFO("Name_tree: "<<name_tree);
   NS_LOG_INFO("End_of_Params");
 
   NS_LOG_INFO("Number_of_infrastructure_nodes: "<<nodes.GetN()); 
 
   std::map<int, int > app_to_node; //maps app index to access node index
   std::map<int, int > access_to_router; //maps access node index to the next hop router index
-  uint32_t num_connected = 0; //number of connected applications/users
-  uint32_t num_contents_requested_init=0;  //number of unique content items requested during initialization
 
 // Install Content Store: Infrastructure nodes get limited storage
   ndn::StackHelper ndnHelperCaching;
@@ -334,81 +538,36 @@ main(int argc, char* argv[])
       Ptr<ndn::L3Protocol> p =  ndn::L3Protocol::getL3Protocol(n);
       shared_ptr<nfd::Forwarder> f = p->getForwarder();
       f->setSitCapacity(sit_size);
+      f->setSitMaxNextHops(sit_max_nexthops);
     }
   }
   // Calculate and install FIBs
-  ndn::GlobalRoutingHelper::CalculateRoutes();
+  ndn::GlobalRoutingHelper::CalculateRoutesParallel(routing_threads, routing_stats);
   std::this_thread::sleep_for(std::chrono::seconds(2));
   /****************************************************************/
   //Setup Simulation Events (connection, disconnection, etc)
 
-  // Content Distribution 
-  ndn::ConsumerZipfMandelbrot content_dist(num_contents, 0, zipf_exponent);
-
-  /***  Initialization Period: ***/
-  NS_LOG_INFO("Beginning of Initialization Period");
-  double connect_time = 0.2;
-  std::random_device rd; 
-  std::exponential_distribution<double> rng_exp_con (connection_rate);
-  std::mt19937 rnd_gen (rd ()); //initialize the random number generator
-  // The number of each content connected at each node
-  std::map<int, int> requested_content;
-  do 
+  SitArrivalProcess arrivals(nodes, consumer_apps.GetN(), producer_apps.GetN(), num_contents,
+                             zipf_exponent, connection_rate, simulation_length,
+                             scoped_downstream_counter, num_chunks, seed);
+  SitArrivalProcess::Arrival arrival;
+  if(preschedule_flows)
   {
-    uint32_t content_indx = content_dist.GetNextSeq(); 
-    uint32_t producer_indx = content_indx%(producer_apps.GetN());
-    uint32_t app_indx = rnd_gen()%(consumer_apps.GetN());
-    uint32_t cost = get_cost(nodes, app_indx, producer_indx);
-    if(cost > diameter){
-      diameter = cost;
-    }
-	 Schedule_Send(consumer_apps, app_indx, connect_time, producer_indx, cost + scoped_downstream_counter, content_indx, num_chunks);
-	 num_connected++;
-    if(cost == 0 && (app_indx != producer_indx)){
-      std::cout<<"This should not happen; cost is 0 for different nodes\n";
-    }
-    connect_time = connect_time + rng_exp_con(rnd_gen);
-    
-    if(!requested_content[content_indx])
+    while(arrivals.Next(arrival))
     {
-      requested_content[content_indx]++;
-      num_contents_requested_init++;
+      Schedule_Send(consumer_apps, arrival.app_indx, arrival.time, arrival.producer_indx, arrival.scope, arrival.content_indx, num_chunks);
     }
-  }while(num_contents_requested_init < (0.3 *(1.0*num_contents)));
-  //while(connect_time < simulation_length);
-  NS_LOG_INFO("Initialization complete "<<num_connected*num_chunks); //initialization is complete after this many interests
-  
-  requested_content.clear();
-  connect_time += 10.0;
-  double init_period_len = connect_time;
-  num_contents_requested_init = 0;
-  num_connected = 0;
-
-  //Real simulation: (Observation time)
-  do 
+    Simulator::Stop(Seconds(arrivals.GetStopTime()));
+  }
+  else if(arrivals.Next(arrival))
   {
-    uint32_t content_indx = content_dist.GetNextSeq(); 
-    uint32_t producer_indx = content_indx%(producer_apps.GetN());
-    uint32_t app_indx = rnd_gen()%(consumer_apps.GetN());
-    uint32_t cost = get_cost(nodes, app_indx, producer_indx);
-	 Schedule_Send(consumer_apps, app_indx, connect_time, producer_indx, cost + scoped_downstream_counter, content_indx, num_chunks);
-	 num_connected++;
-    connect_time = connect_time + rng_exp_con(rnd_gen);
-    if(!requested_content[content_indx])
-    {
-      requested_content[content_indx]++;
-      num_contents_requested_init++;
-    }
-    
-  }while(connect_time < (init_period_len + simulation_length));
-  
-  NS_LOG_INFO("Graph Diameter: "<<diameter);
-  NS_LOG_INFO("Observation complete: Number of Unique content during observation: "<<num_contents_requested_init); //initialization is complete after this many interests
-  NS_LOG_INFO("Observation complete: Number of requests during observation: "<<num_connected); //initialization is complete after this many interests
-  Simulator::Stop(Seconds(init_period_len + simulation_length + 2));
+    // one pending arrival for the whole scenario and one pending chunk per app
+    Simulator::Schedule(Seconds(arrival.time), &Start_Flow, &arrivals, &consumer_apps, arrival, num_chunks);
+  }
 
   Simulator::Run();
   Simulator::Destroy();
+  ndn::SitEventLog::Close();
 
   return 0;
 }
@@ -39,9 +39,12 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/fw/forwarder.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
+#include <algorithm>
+
 
 namespace ns3 {
 namespace ndn {
@@ -103,6 +106,42 @@ FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, i
   AddNextHop(parameters, node);
 }
 
+void
+FibHelper::AddRoutesBulk(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << routes.size() << " routes");
+
+  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(L3protocol != 0, "Ndn stack should be installed on the node");
+  shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+  nfd::Fib& fib = forwarder->getFib();
+
+  // stable sort keeps the order of next hops within a prefix, which decides their
+  // order in the FIB entry
+  std::vector<const Route*> sorted;
+  sorted.reserve(routes.size());
+  for (const Route& route : routes) {
+    sorted.push_back(&route);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(), [] (const Route* a, const Route* b) {
+    return a->prefix < b->prefix;
+  });
+
+  shared_ptr<nfd::fib::Entry> entry;
+  for (const Route* route : sorted) {
+    if (forwarder->getFace(route->face->getId()) != route->face) {
+      NS_LOG_DEBUG("Face " << route->face->getId() << " does not exist on node ["
+                           << node->GetId() << "], skipping route to " << route->prefix);
+      continue;
+    }
+
+    if (entry == nullptr || entry->getPrefix() != route->prefix) {
+      entry = fib.insert(route->prefix).first;
+    }
+    entry->addNextHop(route->face, route->metric);
+  }
+}
+
 void
 FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, uint32_t faceId, int32_t metric)
 {
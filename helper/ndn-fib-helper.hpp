@@ -44,6 +44,15 @@ using ::ndn::nfd::ControlParameters;
  */
 class FibHelper {
 public:
+  /**
+   * \brief Forwarding entry for AddRoutesBulk
+   */
+  struct Route {
+    Name prefix;
+    shared_ptr<Face> face;
+    int32_t metric;
+  };
+
   /**
    * \brief Add forwarding entry to FIB
    *
@@ -100,6 +109,23 @@ public:
   static void
   AddRoute(const std::string& nodeName, const Name& prefix, const std::string& otherNodeName,
            int32_t metric);
+  /**
+   * \brief Add many forwarding entries to FIB at once
+   *
+   * Unlike AddRoute, which sends one signed command Interest to the FIB manager per route,
+   * the entries are written into the node's FIB directly.  Routes are grouped by prefix, so
+   * each prefix is looked up in the NameTree once, and next hops of the same prefix are
+   * added in the order given.  The result is the same as calling AddRoute for each route.
+   *
+   * Like AddRoute, this does not touch the RIB.  Routes whose face is not in the node's
+   * face table are skipped, as the FIB manager would reject them.
+   *
+   * \param node   Node
+   * \param routes Forwarding entries
+   */
+  static void
+  AddRoutesBulk(Ptr<Node> node, const std::vector<Route>& routes);
+
   /**
    * \brief remove forwarding entry in FIB
    *
@@ -51,8 +51,15 @@
 #include <boost/foreach.hpp>
 #include <boost/concept/assert.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/graph/compressed_sparse_row_graph.hpp>
 
 #include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "utils/mem-usage.hpp"
 
 #include "boost-graph-ndn-global-routing-helper.hpp"
 
@@ -256,6 +263,7 @@ GlobalRoutingHelper::CalculateRoutes()
     shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
 
     NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
+    std::vector<FibHelper::Route> routes;
     for (const auto& dist : distances) {
       if (dist.first == source)
         continue;
@@ -270,12 +278,205 @@ GlobalRoutingHelper::CalculateRoutes()
                          << " with distance " << std::get<1>(dist.second) << " with delay "
                          << std::get<2>(dist.second));
 
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
+            routes.push_back({*prefix, std::get<0>(dist.second),
+                              static_cast<int32_t>(std::get<1>(dist.second))});
           }
         }
       }
     }
+    FibHelper::AddRoutesBulk(*node, routes);
+  }
+}
+
+namespace {
+
+/**
+ * @brief Read-only snapshot of NdnGlobalRouterGraph in compressed sparse row form
+ *
+ * Vertices are numbered in NdnGlobalRouterGraph order and out-edges keep the incidency
+ * order of each GlobalRouter, so Dijkstra visits vertices in the same order as on the
+ * original graph.  Worker threads only touch this structure, never ns-3 objects.
+ */
+struct RouterGraphSnapshot {
+  struct EdgeProperties {
+    uint32_t weight;
+    nfd::Face* face; // nullptr for edges leaving a channel
+  };
+
+  typedef boost::compressed_sparse_row_graph<boost::directedS, boost::no_property, EdgeProperties>
+    Graph;
+  typedef boost::graph_traits<Graph>::vertex_descriptor Vertex;
+  typedef boost::graph_traits<Graph>::edge_descriptor Edge;
+
+  std::vector<Ptr<GlobalRouter>> routers;
+  std::unordered_map<GlobalRouter*, size_t> index; // router to vertex number
+  Graph graph;
+};
+
+void
+snapshotRouterGraph(RouterGraphSnapshot& snapshot)
+{
+  boost::NdnGlobalRouterGraph routerGraph;
+  snapshot.routers.assign(routerGraph.GetVertices().begin(), routerGraph.GetVertices().end());
+
+  for (size_t i = 0; i < snapshot.routers.size(); ++i) {
+    snapshot.index[PeekPointer(snapshot.routers[i])] = i;
+  }
+
+  std::vector<std::pair<size_t, size_t>> edges;
+  std::vector<RouterGraphSnapshot::EdgeProperties> properties;
+  for (size_t i = 0; i < snapshot.routers.size(); ++i) {
+    for (const auto& incidency : snapshot.routers[i]->GetIncidencies()) {
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      edges.push_back(std::make_pair(i, snapshot.index[PeekPointer(std::get<2>(incidency))]));
+      // same truncation to uint16_t as boost::get(EdgeWeights, Incidency)
+      properties.push_back({face == nullptr ? 0u : static_cast<uint16_t>(face->getMetric()),
+                            face.get()});
+    }
+  }
+
+  snapshot.graph = RouterGraphSnapshot::Graph(boost::edges_are_sorted, edges.begin(), edges.end(),
+                                              properties.begin(), snapshot.routers.size());
+}
+
+/**
+ * @brief Dijkstra visitor that propagates the first hop face along relaxed edges,
+ *        as WeightCombine does for the tuple distances of CalculateRoutes
+ */
+class FirstHopRecorder : public boost::default_dijkstra_visitor {
+public:
+  explicit FirstHopRecorder(nfd::Face** firstHops)
+    : m_firstHops(firstHops)
+  {
+  }
+
+  void
+  edge_relaxed(RouterGraphSnapshot::Edge e, const RouterGraphSnapshot::Graph& g) const
+  {
+    nfd::Face* viaSource = m_firstHops[boost::source(e, g)];
+    m_firstHops[boost::target(e, g)] = viaSource != nullptr ? viaSource : g[e].face;
+  }
+
+private:
+  nfd::Face** m_firstHops;
+};
+
+void
+calculateShortestPaths(const RouterGraphSnapshot& snapshot, size_t source, uint32_t* distances,
+                       nfd::Face** firstHops)
+{
+  const RouterGraphSnapshot::Graph& g = snapshot.graph;
+  std::fill(firstHops, firstHops + snapshot.routers.size(), nullptr);
+
+  boost::dijkstra_shortest_paths(g, source,
+                                 boost::weight_map(boost::get(&RouterGraphSnapshot::EdgeProperties::weight, g))
+                                   .distance_map(boost::make_iterator_property_map(distances,
+                                                   boost::get(boost::vertex_index, g)))
+                                   .distance_inf(static_cast<uint32_t>(std::get<1>(boost::WeightInf)))
+                                   .distance_zero(0)
+                                   .distance_combine(std::plus<uint32_t>())
+                                   .visitor(FirstHopRecorder(firstHops)));
+}
+
+} // namespace
+
+void
+GlobalRoutingHelper::CalculateRoutesParallel(size_t nThreads, bool reportStats)
+{
+  auto start = std::chrono::steady_clock::now();
+  int64_t peakMemory = 0;
+  auto sampleMemory = [&] {
+    if (reportStats) {
+      peakMemory = std::max(peakMemory, MemUsage::Get());
+    }
+  };
+
+  RouterGraphSnapshot snapshot;
+  snapshotRouterGraph(snapshot);
+  const size_t nVertices = snapshot.routers.size();
+
+  std::vector<Ptr<Node>> sourceNodes;
+  std::vector<size_t> sources;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
+    if (source == 0) {
+      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+      continue;
+    }
+    sourceNodes.push_back(*node);
+    sources.push_back(snapshot.index[PeekPointer(source)]);
+  }
+
+  // CalculateRoutes visits reachable routers in DistancesMap (pointer) order, which
+  // decides the next hop order when several routers export the same prefix
+  std::vector<size_t> targets(nVertices);
+  for (size_t i = 0; i < nVertices; ++i) {
+    targets[i] = i;
+  }
+  std::sort(targets.begin(), targets.end(), [&snapshot] (size_t a, size_t b) {
+    return PeekPointer(snapshot.routers[a]) < PeekPointer(snapshot.routers[b]);
+  });
+
+  if (nThreads == 0) {
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  sampleMemory();
+
+  // sources are processed in batches to bound the size of the result buffers
+  const size_t batchSize = std::min(sources.size(), nThreads * 16);
+  std::vector<uint32_t> distances(batchSize * nVertices);
+  std::vector<nfd::Face*> firstHops(batchSize * nVertices);
+
+  for (size_t batchBegin = 0; batchBegin < sources.size(); batchBegin += batchSize) {
+    const size_t batchEnd = std::min(sources.size(), batchBegin + batchSize);
+
+    std::atomic<size_t> next(batchBegin);
+    auto worker = [&] {
+      for (size_t i = next++; i < batchEnd; i = next++) {
+        size_t offset = (i - batchBegin) * nVertices;
+        calculateShortestPaths(snapshot, sources[i], &distances[offset], &firstHops[offset]);
+      }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < std::min(nThreads, batchEnd - batchBegin); ++t) {
+      pool.push_back(std::thread(worker));
+    }
+    worker();
+    for (auto& thread : pool) {
+      thread.join();
+    }
+
+    for (size_t i = batchBegin; i < batchEnd; ++i) {
+      size_t offset = (i - batchBegin) * nVertices;
+
+      NS_LOG_DEBUG("Reachability from Node: " << sourceNodes[i]->GetId());
+      std::vector<FibHelper::Route> routes;
+      for (size_t target : targets) {
+        nfd::Face* face = firstHops[offset + target];
+        if (target == sources[i] || face == nullptr) {
+          continue;
+        }
+
+        uint32_t distance = distances[offset + target];
+        for (const auto& prefix : snapshot.routers[target]->GetLocalPrefixes()) {
+          NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << *face
+                       << " with distance " << distance);
+
+          routes.push_back({*prefix, face->shared_from_this(), static_cast<int32_t>(distance)});
+        }
+      }
+      FibHelper::AddRoutesBulk(sourceNodes[i], routes);
+    }
+    sampleMemory();
+  }
+
+  if (reportStats) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+    NS_LOG_UNCOND("GlobalRoutingHelper: routes for " << sources.size() << " nodes ("
+                  << nVertices << " vertices) calculated in " << elapsed.count() << " ms using "
+                  << nThreads << " threads, peak memory " << peakMemory << " bytes");
   }
 }
 
@@ -100,6 +100,20 @@ public:
   static void
   CalculateRoutes();
 
+  /**
+   * @brief Calculate shortest path trees for every node in parallel and install routes
+   *        to all prefix origins
+   *
+   * Produces the same routes as CalculateRoutes().  The router graph is snapshotted into a
+   * compressed sparse row graph, Dijkstra runs for all sources are spread over a pool of
+   * worker threads, and the results are installed with FibHelper::AddRoutesBulk.
+   *
+   * @param nThreads    Number of worker threads (0 to use the number of hardware threads)
+   * @param reportStats If true, print setup time and peak memory usage (NS_LOG_UNCOND)
+   */
+  static void
+  CalculateRoutesParallel(size_t nThreads = 0, bool reportStats = false);
+
   /**
    * @brief Calculate all possible next-hop independent alternative routes
    *
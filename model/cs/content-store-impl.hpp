@@ -41,6 +41,9 @@ namespace cs {
 /**
  * @ingroup ndn-cs
  * @brief Cache entry implementation with additional references to the base container
+ *
+ * Entries of all content stores of the same type share a pool of memory, so evicting one
+ * entry and adding the next one reuses the same block.
  */
 template<class CS>
 class EntryImpl : public Entry {
@@ -54,6 +57,23 @@ public:
   {
   }
 
+  static void*
+  operator new(size_t size)
+  {
+    if (size != sizeof(EntryImpl))
+      return ::operator new(size); // a subclass, which does not fit in the pool blocks
+    return getPool().allocate();
+  }
+
+  static void
+  operator delete(void* p, size_t size)
+  {
+    if (size != sizeof(EntryImpl))
+      ::operator delete(p);
+    else
+      getPool().deallocate(p);
+  }
+
   void
   SetTrie(typename CS::super::iterator item)
   {
@@ -71,6 +91,15 @@ public:
     return item_;
   }
 
+private:
+  static ndnSIM::trie_node_pool<EntryImpl>&
+  getPool()
+  {
+    // never destroyed, as entries may still be released while static objects are destroyed
+    static ndnSIM::trie_node_pool<EntryImpl>* pool = new ndnSIM::trie_node_pool<EntryImpl>;
+    return *pool;
+  }
+
 private:
   typename CS::super::iterator item_;
 };
@@ -103,7 +132,7 @@ public:
 
   // from ContentStore
 
-  virtual inline shared_ptr<Data>
+  virtual inline shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest);
 
   virtual inline bool
@@ -206,7 +235,7 @@ private:
 };
 
 template<class Policy>
-shared_ptr<Data>
+shared_ptr<const Data>
 ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION(this << interest->getName());
@@ -221,10 +250,9 @@ ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
   }
 
   if (node != this->end()) {
-    this->m_cacheHitsTrace(interest, node->payload()->GetData());
-
-    shared_ptr<Data> copy = make_shared<Data>(*node->payload()->GetData());
-    return copy;
+    shared_ptr<const Data> data = node->payload()->GetData();
+    this->m_cacheHitsTrace(interest, data);
+    return data;
   }
   else {
     this->m_cacheMissesTrace(interest);
@@ -245,45 +273,23 @@ bool
 ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
 {
   NS_LOG_FUNCTION(this << data->getName());
-  
-  typename super::policy_container::const_iterator begin_node = this->getPolicy().begin();
 
-  bool nonempty = false;
-  Name beg;
-  if(this->GetPolicy().size() > 0) 
-  {
-    nonempty = true;
-    beg = this->getPolicy().begin()->payload()->GetName();
+  // the entry is created only after the policy admits it, and a full policy evicts another
+  // entry while inserting it
+  std::pair<typename super::iterator, bool> result =
+    super::insert_if_admitted(data->getName(), [this, &data] (typename super::iterator item) {
+        Ptr<entry> newEntry = Create<entry>(this, data);
+        newEntry->SetTrie(item);
+        return newEntry;
+      });
+
+  if (!result.second) {
+    // already cached (should we update the payload?) or not admitted
+    return false;
   }
-  Ptr<entry> newEntry = Create<entry>(this, data);
-  std::pair<typename super::iterator, bool> result = super::insert(data->getName(), newEntry);
-
-
-  if (result.first != super::end()) {
-    if (result.second) {
-      newEntry->SetTrie(result.first);
-      
-		//if(data->getName().size() <= 3)
-      //{
-      //  NS_LOG_INFO("Added_cache_entry "<<data->getName().at(-1).toSequenceNumber());
-      //}
-		//else
-        //NS_LOG_INFO("Added_cache_entry "<<data->getName());
-  
-      //if(nonempty && beg != this->GetPolicy().begin()->payload()->GetName() && beg.size() <= 3)
-      //  NS_LOG_INFO("Removed_cache_entry "<<beg.at(-1).toSequenceNumber());
-
-      m_didAddEntry(newEntry);
-      return true;
-    }
-    else {
-      // should we do anything?
-      // update payload? add new payload?
-      return false;
-    }
-  }
-  else
-    return false; // cannot insert entry
+
+  m_didAddEntry(result.first->payload());
+  return true;
 }
 
 template<class Policy>
@@ -52,7 +52,7 @@ public:
    */
   virtual ~Nocache();
 
-  virtual shared_ptr<Data>
+  virtual shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest);
 
   virtual bool
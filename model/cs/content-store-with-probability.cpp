@@ -24,6 +24,8 @@
 #include "../../utils/trie/fifo-policy.hpp"
 #include "../../utils/trie/lfu-policy.hpp"
 
+NS_LOG_COMPONENT_DEFINE("ndn.cs.ProbabilityImpl");
+
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
   static struct X##type##templ##RegistrationClass {                                                \
     X##type##templ##RegistrationClass()                                                            \
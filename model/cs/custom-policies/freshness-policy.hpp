@@ -102,6 +102,12 @@ struct freshness_policy_traits {
         // do nothing
       }
 
+      inline bool
+      admit()
+      {
+        return true;
+      }
+
       inline bool
       insert(typename parent_trie::iterator item)
       {
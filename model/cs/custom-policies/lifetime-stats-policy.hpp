@@ -92,6 +92,12 @@ struct lifetime_stats_policy_traits {
         // do nothing. it's random policy
       }
 
+      inline bool
+      admit()
+      {
+        return true;
+      }
+
       inline bool
       insert(typename parent_trie::iterator item)
       {
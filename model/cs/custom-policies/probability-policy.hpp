@@ -29,8 +29,6 @@
 
 #include <ns3/random-variable-stream.h>
 
-NS_LOG_COMPONENT_DEFINE("ndn.cs.ProbabilityImpl");
-
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
@@ -76,22 +74,20 @@ struct probability_policy_traits {
       {
       }
 
+      /**
+       * @brief Decide whether to cache the next new entry, before it is created
+       */
+      inline bool
+      admit()
+      {
+        return ns3_rand_->GetValue() < probability_;
+      }
+
       inline bool
       insert(typename parent_trie::iterator item)
       {
-        if (ns3_rand_->GetValue() < probability_) {
-          //if(item->key().isSequenceNumber())
-          //{
-          //  NS_LOG_INFO("Added_cache_entry "<<(*item).key().toSequenceNumber());
-          //}
-          policy_container::push_back(*item);
-          // allow caching
-          return true;
-        }
-        else {
-          // don't allow caching
-          return false;
-        }
+        policy_container::push_back(*item);
+        return true;
       }
 
       inline void
@@ -62,6 +62,10 @@ Entry::Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data)
 {
 }
 
+Entry::~Entry()
+{
+}
+
 const Name&
 Entry::GetName() const
 {
@@ -64,6 +64,9 @@ public:
    */
   Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data);
 
+  virtual
+  ~Entry();
+
   /**
    * \brief Get prefix of the stored entry
    * \returns prefix of the stored entry
@@ -119,8 +122,10 @@ public:
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * \returns the cached Data itself, not a copy, or nullptr if nothing matches
    */
-  virtual shared_ptr<Data>
+  virtual shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest) = 0;
 
   /**
@@ -19,12 +19,6 @@
 
 #include "ndn-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
-
-namespace io = boost::iostreams;
-
 namespace ns3 {
 namespace ndn {
 
@@ -87,41 +81,58 @@ PacketHeader<Pkt>::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_packet->wireEncode().wire(), m_packet->wireEncode().size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+/** \brief reads a TLV VAR-NUMBER, appending its encoded octets to \p out
+ */
+static uint64_t
+readVarNumber(ns3::Buffer::Iterator& is, uint8_t* out, size_t& outSize)
+{
+  if (is.IsEnd()) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV processing"));
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  uint8_t firstOctet = is.ReadU8();
+  out[outSize++] = firstOctet;
+  if (firstOctet < 253) {
+    return firstOctet;
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  size_t nOctets = firstOctet == 253 ? 2 : (firstOctet == 254 ? 4 : 8);
+  uint64_t value = 0;
+  for (size_t i = 0; i < nOctets; ++i) {
+    if (is.IsEnd()) {
+      BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV processing"));
+    }
+    uint8_t octet = is.ReadU8();
+    out[outSize++] = octet;
+    value = (value << 8) | octet;
+  }
+  return value;
+}
 
 template<class Pkt>
 uint32_t
 PacketHeader<Pkt>::Deserialize(ns3::Buffer::Iterator start)
 {
+  // TLV-TYPE and TLV-LENGTH take at most 9 octets each
+  uint8_t typeLength[18];
+  size_t typeLengthSize = 0;
+  readVarNumber(start, typeLength, typeLengthSize);
+  uint64_t length = readVarNumber(start, typeLength, typeLengthSize);
+
+  if (length > start.GetRemainingSize()) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Not enough data in the buffer to fully parse TLV"));
+  }
+
+  // copy the whole TLV block with a single bulk read; the decoded packet
+  // and all its sub-blocks share this buffer
+  auto buffer = make_shared< ::ndn::Buffer>(typeLengthSize + length);
+  std::copy(typeLength, typeLength + typeLengthSize, buffer->begin());
+  start.Read(buffer->buf() + typeLengthSize, length);
+
   auto packet = make_shared<Pkt>();
-  io::stream<Ns3BufferIteratorSource> is(start);
-  packet->wireDecode(::ndn::Block::fromStream(is));
+  packet->wireDecode(::ndn::Block(buffer));
   m_packet = packet;
-  return packet->wireEncode().size();
+  return buffer->size();
 }
 
 template<>
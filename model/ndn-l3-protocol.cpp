@@ -291,6 +291,16 @@ L3Protocol::initializeRibManager()
   m_impl->m_ribManager = make_shared<rib::RibManager>(*(m_impl->m_face),
                                                       StackHelper::getKeyChain());
 
+  // FIB manager is in the same process: apply RIB changes to it directly rather than through
+  // one command Interest per FIB update
+  shared_ptr<FibManager> fibManager = m_impl->m_fibManager;
+  m_impl->m_ribManager->setFibUpdateApplier([fibManager] (const rib::FibUpdate& update) {
+      if (update.action == rib::FibUpdate::ADD_NEXTHOP)
+        return fibManager->applyAddNextHop(update.name, update.faceId, update.cost);
+      else
+        return fibManager->applyRemoveNextHop(update.name, update.faceId);
+    });
+
   ConfigFile config([] (const std::string& filename, const std::string& sectionName,
                         const ConfigSection& section, bool isDryRun) {
       // Ignore "log" and sections belonging to NFD,
@@ -37,6 +37,8 @@ BOOST_CONCEPT_ASSERT((WireDecodable<Interest>));
 static_assert(std::is_base_of<tlv::Error, Interest::Error>::value,
               "Interest::Error must inherit from tlv::Error");
 
+uint64_t Interest::s_nWireEncodes = 0;
+
 Interest::Interest()
   : m_interestLifetime(time::milliseconds::min())
   , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
@@ -91,6 +93,51 @@ Interest::setNonce(uint32_t nonce)
   return *this;
 }
 
+/** @brief Encode a SIT flag with a fixed-width value, so that it can be patched in place
+ */
+static Block
+makeFlagBlock(uint32_t type, uint32_t val)
+{
+  uint32_t be = htobe32(val);
+  return makeBinaryBlock(type, reinterpret_cast<const uint8_t*>(&be), sizeof(be));
+}
+
+/** @brief Update a flag in existing wire format
+ *  @return false if the flag has to be re-encoded instead
+ */
+static bool
+patchFlagBlock(const Block& wire, const Block& flag, uint32_t val)
+{
+  if (!wire.hasWire() || flag.value_size() != sizeof(uint32_t))
+    return false;
+
+  uint32_t be = htobe32(val);
+  std::memcpy(const_cast<uint8_t*>(flag.value()), &be, sizeof(be));
+  return true;
+}
+
+Interest&
+Interest::setDestinationFlag(uint32_t val)
+{
+  m_destinationFlag.set(val);
+  if (!patchFlagBlock(m_wire, m_dfBlock, val)) {
+    m_dfBlock = makeFlagBlock(tlv::DestinationFlag, val);
+    m_wire.reset();
+  }
+  return *this;
+}
+
+Interest&
+Interest::setFloodFlag(uint32_t val)
+{
+  m_floodFlag.set(val);
+  if (!patchFlagBlock(m_wire, m_ffBlock, val)) {
+    m_ffBlock = makeFlagBlock(tlv::FloodFlag, val);
+    m_wire.reset();
+  }
+  return *this;
+}
+
 void
 Interest::refreshNonce()
 {
@@ -269,15 +316,18 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
   totalLength += getName().wireEncode(encoder);
 
   // Destination Flag
-  getDestinationFlag();
- 
+  if (!m_dfBlock.hasWire())
+    m_dfBlock = makeFlagBlock(tlv::DestinationFlag, m_destinationFlag.get());
+
   NS_LOG_INFO (">> WireEncode Destination Flag: " << m_destinationFlag.get()<<" "<<readNonNegativeInteger(m_dfBlock));
 
   totalLength += encoder.prependBlock(m_dfBlock);
   //totalLength += getDestinationFlag().wireEncode(encoder);
 
  // Flood Flag
-  getFloodFlag();
+  if (!m_ffBlock.hasWire())
+    m_ffBlock = makeFlagBlock(tlv::FloodFlag, m_floodFlag.get());
+
   NS_LOG_INFO (">> WireEncode Flood Flag: " << m_floodFlag.get() << " "<<readNonNegativeInteger(m_ffBlock));
   
   totalLength += encoder.prependBlock(m_ffBlock);
@@ -305,6 +355,7 @@ Interest::wireEncode() const
 
   EncodingBuffer buffer(estimatedSize, 0);
   wireEncode(buffer);
+  ++s_nWireEncodes;
 
   // to ensure that Nonce block points to the right memory location
   const_cast<Interest*>(this)->wireDecode(buffer.block());
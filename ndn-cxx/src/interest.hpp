@@ -231,61 +231,34 @@ public: // Name and guiders
     return *this;
   }
   
+  /** @brief Set Interest's Destination Flag
+   *
+   *  The flag is encoded with a fixed 4-octet value, so if wire format already exists
+   *  this call patches it in place, without resetting and recreating it.
+   */
   Interest&
-  setDestinationFlag(uint32_t val)
-  {
-    m_destinationFlag.set(val);
-
-    if(m_wire.hasWire() && m_dfBlock.value_size() == sizeof(uint32_t))
-	 {
-      std::memcpy(const_cast<uint8_t*>(m_dfBlock.value()), &val, sizeof(uint32_t)); 
-	 }
-	 else
-	 {
-      m_dfBlock = makeNonNegativeIntegerBlock(tlv::DestinationFlag, val);
-		m_wire.reset();
-	 }
-    return *this;
-  }
+  setDestinationFlag(uint32_t val);
 
+  /** @brief Set Interest's Flood Flag
+   *
+   *  The flag is encoded with a fixed 4-octet value, so if wire format already exists
+   *  this call patches it in place, without resetting and recreating it.
+   */
   Interest&
-  setFloodFlag(uint32_t val)
-  {
-    m_floodFlag.set(val);
-
-    if(m_wire.hasWire() && m_ffBlock.value_size() == sizeof(uint32_t))
-	 {
-      std::memcpy(const_cast<uint8_t*>(m_ffBlock.value()), &val, sizeof(uint32_t)); 
-	 }
-	 else
-	 {
-      m_ffBlock = makeNonNegativeIntegerBlock(tlv::FloodFlag, val);
-		m_wire.reset();
-	 }
-    return *this;
-  }
+  setFloodFlag(uint32_t val);
 
   uint32_t
   getDestinationFlag() const
   {
-    
-	 if (!m_dfBlock.hasWire())
-	 {
-      const_cast<Interest*>(this)->setDestinationFlag(const_cast<DestinationFlag *>(&m_destinationFlag)->get());
-	 }
-    
-    return readNonNegativeInteger(m_dfBlock);
+    return m_destinationFlag.get();
   }
-  
+
   uint32_t
   getFloodFlag() const
   {
-    if (!m_ffBlock.hasWire())
-      const_cast<Interest*>(this)->setFloodFlag(const_cast<FloodFlag *>(&m_floodFlag)->get());
-    
-    return readNonNegativeInteger(m_ffBlock);
+    return m_floodFlag.get();
   }
-  
+
   const time::milliseconds&
   getInterestLifetime() const
   {
@@ -482,6 +455,18 @@ public: // Selectors
     return *this;
   }
 
+public: // instrumentation
+  /** @brief Get the number of times wire format of any Interest was encoded from scratch
+   *
+   *  Reusing existing wire format, including after an in-place update of Nonce or flags,
+   *  is not counted.
+   */
+  static uint64_t
+  getWireEncodeCount()
+  {
+    return s_nWireEncodes;
+  }
+
 public: // EqualityComparable concept
   bool
   operator==(const Interest& other) const
@@ -511,6 +496,8 @@ private:
 
   nfd::LocalControlHeader m_localControlHeader;
   friend class nfd::LocalControlHeader;
+
+  static uint64_t s_nWireEncodes;
 };
 
 std::ostream&
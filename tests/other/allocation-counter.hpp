@@ -0,0 +1,50 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_TESTS_OTHER_ALLOCATION_COUNTER_HPP
+#define NDNSIM_TESTS_OTHER_ALLOCATION_COUNTER_HPP
+
+#include <cstdlib>
+#include <new>
+
+// Every heap allocation made by the program goes through these, so that a benchmark can
+// report allocations per operation. Include this header in exactly one translation unit
+// of a benchmark program.
+static size_t g_nAllocations = 0;
+static size_t g_nAllocatedBytes = 0;
+
+void*
+operator new(std::size_t size)
+{
+  ++g_nAllocations;
+  g_nAllocatedBytes += size;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+#endif // NDNSIM_TESTS_OTHER_ALLOCATION_COUNTER_HPP
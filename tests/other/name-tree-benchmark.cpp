@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// name-tree-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/NFD/daemon/table/name-tree.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Times NameTree lookup, exact match, longest prefix match, enumeration and erasure for the
+ * chained and open-addressing backends, with and without reusing the hash values cached on
+ * the packet (HashSetTag):
+ *
+ *     ./waf --run "name-tree-benchmark --count=100000"
+ */
+
+class NameTreeBenchmark {
+public:
+  NameTreeBenchmark()
+    : m_count(100000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  timedRun(std::function<void()> f)
+  {
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t2 - t1).count();
+  }
+
+  /**
+   * Inserts, matches and erases the names of the workload
+   * \param reuseHashSet whether the per-packet hash values are shared by all operations
+   */
+  void
+  measure(nfd::NameTree::Backend backend, bool reuseHashSet);
+
+private:
+  uint32_t m_count;
+  // Interests named /bench/<i % 100>/<i % 1000>/<i>
+  std::vector<std::shared_ptr<ndn::Interest>> m_workload;
+};
+
+void
+NameTreeBenchmark::measure(nfd::NameTree::Backend backend, bool reuseHashSet)
+{
+  namespace name_tree = nfd::name_tree;
+  nfd::NameTree nt(1024, backend);
+
+  double nsLookup = timedRun([&] {
+      for (const std::shared_ptr<ndn::Interest>& interest : m_workload) {
+        if (reuseHashSet)
+          nt.lookup(interest->getName(), name_tree::getHashSet(*interest));
+        else
+          nt.lookup(interest->getName());
+      }
+    });
+  size_t nProbesLookup = nt.getNProbes();
+
+  double nsExactMatch = timedRun([&] {
+      for (const std::shared_ptr<ndn::Interest>& interest : m_workload) {
+        if (reuseHashSet)
+          nt.findExactMatch(interest->getName(), name_tree::getHashSet(*interest).back());
+        else
+          nt.findExactMatch(interest->getName());
+      }
+    });
+
+  // as done when Data is matched against PIT entries
+  size_t nProbesBefore = nt.getNProbes();
+  double nsLongestPrefixMatch = timedRun([&] {
+      for (const std::shared_ptr<ndn::Interest>& interest : m_workload) {
+        if (reuseHashSet)
+          nt.findLongestPrefixMatch(interest->getName(), name_tree::getHashSet(*interest));
+        else
+          nt.findLongestPrefixMatch(interest->getName());
+      }
+    });
+  size_t nProbesLongestPrefixMatch = nt.getNProbes() - nProbesBefore;
+
+  size_t nWithChildren = 0;
+  double nsEnumerate = timedRun([&] {
+      for (const name_tree::Entry& entry : nt) {
+        nWithChildren += entry.hasChildren();
+      }
+    });
+  size_t nEntries = nt.size();
+
+  double nsErase = timedRun([&] {
+      for (const std::shared_ptr<ndn::Interest>& interest : m_workload) {
+        nt.eraseEntryIfEmpty(nt.findExactMatch(interest->getName()));
+      }
+    });
+
+  std::cout << (backend == nfd::NameTree::BACKEND_OPEN_ADDRESSING ? "open-addressing" :
+                                                                    "chained")
+            << (reuseHashSet ? " with HashSetTag" : "") << "\n"
+            << "  lookup " << nsLookup / m_count << " ns, "
+            << static_cast<double>(nProbesLookup) / m_count << " probes\n"
+            << "  exact match " << nsExactMatch / m_count << " ns\n"
+            << "  LPM " << nsLongestPrefixMatch / m_count << " ns, "
+            << static_cast<double>(nProbesLongestPrefixMatch) / m_count << " probes\n"
+            << "  enumerate " << nsEnumerate / nEntries << " ns per entry ("
+            << nWithChildren << " of " << nEntries << " with children)\n"
+            << "  erase " << nsErase / m_count << " ns, " << nt.size() << " entries left\n";
+}
+
+int
+NameTreeBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("count", "Number of names", m_count);
+  cmd.Parse(argc, argv);
+
+  m_workload.reserve(m_count);
+  for (uint32_t i = 0; i < m_count; ++i) {
+    m_workload.push_back(std::make_shared<ndn::Interest>(ndn::Name("/bench").appendNumber(i % 100)
+                                                                             .appendNumber(i % 1000)
+                                                                             .appendNumber(i)));
+    m_workload.back()->wireEncode();
+  }
+
+  std::cout << m_count << " names\n";
+  for (nfd::NameTree::Backend backend : {nfd::NameTree::BACKEND_CHAINED,
+                                         nfd::NameTree::BACKEND_OPEN_ADDRESSING}) {
+    measure(backend, false);
+    measure(backend, true);
+  }
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::NameTreeBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
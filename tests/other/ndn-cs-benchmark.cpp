@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-cs-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
+
+#include "allocation-counter.hpp"
+
+#include <chrono>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Measures ContentStore::Lookup hits on a full cache for the content stores used in SIT
+ * experiments, printing hits per second and heap allocations per hit:
+ *
+ *     ./waf --run "ndn-cs-benchmark --size=10000 --lookups=1000000"
+ *
+ * Then measures ContentStore::Add on Probability::Lru stores of 100 to 1e6 entries (each one
+ * keeps 2 * size small Data packets in memory) with caching probabilities 0.1, 0.5 and 1,
+ * printing inserts per second and heap allocations per insert:
+ *
+ *     ./waf --run "ndn-cs-benchmark --inserts=1000000 --max_insert_size=100000"
+ */
+
+class CsBenchmark {
+public:
+  CsBenchmark()
+    : m_size(10000)
+    , m_nLookups(1000000)
+    , m_nInserts(1000000)
+    , m_maxInsertSize(1000000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  void
+  measure(const std::string& typeId);
+
+  void
+  measureInserts(uint32_t size, double probability);
+
+private:
+  uint32_t m_size;
+  uint32_t m_nLookups;
+  uint32_t m_nInserts;
+  uint32_t m_maxInsertSize;
+  std::vector<std::shared_ptr<const ndn::Data>> m_datas;
+  std::vector<std::shared_ptr<const ndn::Interest>> m_interests;
+};
+
+void
+CsBenchmark::measure(const std::string& typeId)
+{
+  ObjectFactory factory(typeId);
+  factory.Set("MaxSize", UintegerValue(m_size));
+  Ptr<ndn::ContentStore> cs = factory.Create<ndn::ContentStore>();
+
+  for (const std::shared_ptr<const ndn::Data>& data : m_datas) {
+    cs->Add(data);
+  }
+
+  size_t nHits = 0;
+  size_t nAllocationsBefore = g_nAllocations;
+
+  std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < m_nLookups; i++) {
+    if (cs->Lookup(m_interests[i % m_interests.size()]) != nullptr)
+      nHits++;
+  }
+  std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(t2 - t1).count();
+  std::cout << typeId << "\t"
+            << cs->GetSize() << " entries\t"
+            << nHits / seconds << " hits/s\t"
+            << static_cast<double>(g_nAllocations - nAllocationsBefore) / std::max<size_t>(nHits, 1)
+            << " allocations/hit\n";
+}
+
+void
+CsBenchmark::measureInserts(uint32_t size, double probability)
+{
+  ObjectFactory factory("ns3::ndn::cs::Probability::Lru");
+  factory.Set("MaxSize", UintegerValue(size));
+  factory.Set("CacheProbability", DoubleValue(probability));
+  Ptr<ndn::ContentStore> cs = factory.Create<ndn::ContentStore>();
+
+  // twice as many names as fit, inserted round robin, so a full cache keeps evicting
+  auto dataTemplate = ndn::DataTemplate::Get(16, Seconds(100), 0, ndn::Name());
+  std::vector<std::shared_ptr<const ndn::Data>> datas;
+  for (uint32_t i = 0; i < 2 * size; i++) {
+    ndn::Name name = ndn::Name("/insert").appendNumber(i % 100).appendSequenceNumber(i);
+    datas.push_back(dataTemplate->Make(name));
+  }
+  for (uint32_t i = 0; i < 2 * size; i++) {
+    cs->Add(datas[i]);
+  }
+
+  size_t nAdded = 0;
+  size_t nAllocationsBefore = g_nAllocations;
+
+  std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < m_nInserts; i++) {
+    if (cs->Add(datas[i % datas.size()]))
+      nAdded++;
+  }
+  std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(t2 - t1).count();
+  std::cout << "size " << size << "\tprobability " << probability << "\t"
+            << m_nInserts / seconds << " inserts/s\t"
+            << nAdded << " added\t"
+            << static_cast<double>(g_nAllocations - nAllocationsBefore) / m_nInserts
+            << " allocations/insert\n";
+}
+
+int
+CsBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("size", "Number of cached Data packets", m_size);
+  cmd.AddValue("lookups", "Number of lookups for each content store", m_nLookups);
+  cmd.AddValue("inserts", "Number of inserts for each size and probability", m_nInserts);
+  cmd.AddValue("max_insert_size", "Largest content store for the insert benchmark",
+               m_maxInsertSize);
+  cmd.Parse(argc, argv);
+
+  // names of ndn-sit-test Data; every Interest hits
+  auto dataTemplate = ndn::DataTemplate::Get(1024, Seconds(100), 0, ndn::Name());
+  for (uint32_t i = 0; i < m_size; i++) {
+    ndn::Name name = ndn::Name("/prefix").appendNumber(i % 100).appendSequenceNumber(i);
+    m_datas.push_back(dataTemplate->Make(name));
+    m_interests.push_back(std::make_shared<ndn::Interest>(name));
+  }
+
+  std::cout << m_nLookups << " lookups in a cache of " << m_size << " Data packets\n";
+
+  measure("ns3::ndn::cs::Lru");
+  measure("ns3::ndn::cs::Probability::Lru");
+  measure("ns3::ndn::cs::Freshness::Lru");
+
+  std::cout << "\n" << m_nInserts << " inserts of new Data into Probability::Lru\n";
+  for (uint32_t size = 100; size <= m_maxInsertSize; size *= 10) {
+    for (double probability : {0.1, 0.5, 1.0}) {
+      measureInserts(size, probability);
+    }
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::CsBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
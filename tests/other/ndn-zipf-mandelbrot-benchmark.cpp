@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-zipf-mandelbrot-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/utils/ndn-zipf-mandelbrot-table.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace ns3 {
+
+/**
+ * Compares the two ways ZipfMandelbrotTable samples a content rank, binary search over the
+ * cumulative distribution and the alias method, for catalogs of 10^6 and 10^7 contents.
+ *
+ * For each, prints the time to build the table, its memory and the sampling rate:
+ *
+ *     ./waf --run "ndn-zipf-mandelbrot-benchmark --samples=1000000"
+ */
+
+static void
+measure(uint32_t n, ndn::ZipfMandelbrotTable::Method method, uint32_t nSamples)
+{
+  auto start = std::chrono::steady_clock::now();
+  auto table = ndn::ZipfMandelbrotTable::Get(n, 0.7, 0.7, method);
+  auto built = std::chrono::steady_clock::now();
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  uint64_t checksum = 0;
+  for (uint32_t i = 0; i < nSamples; i++) {
+    checksum += table->Sample(uniform(rng));
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  std::cout << (method == ndn::ZipfMandelbrotTable::ALIAS ? "alias" : "binary-search")
+            << "\tN=" << n << "\tbuild "
+            << std::chrono::duration<double, std::milli>(built - start).count() << " ms\t"
+            << table->GetMemoryUsage() / (1024 * 1024) << " MiB\t"
+            << nSamples / std::chrono::duration<double>(end - built).count() << " samples/s\t"
+            << "(checksum " << checksum << ")\n";
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t nSamples = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue("samples", "Number of ranks sampled from each table", nSamples);
+  cmd.Parse(argc, argv);
+
+  for (uint32_t n : {1000000, 10000000}) {
+    measure(n, ndn::ZipfMandelbrotTable::BINARY_SEARCH, nSamples);
+    measure(n, ndn::ZipfMandelbrotTable::ALIAS, nSamples);
+  }
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// pit-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/NFD/daemon/table/pit.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/null-face.hpp"
+
+#include "allocation-counter.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Keeps --count Interests pending, each with one InRecord and 0 to 3 OutRecords, and prints
+ * time, heap allocations and allocated bytes per PIT entry for creating the entries and for
+ * adding their records, then the time of record and Nonce lookups. Since every entry stays
+ * pending until the end, allocated bytes are also the memory held per entry:
+ *
+ *     ./waf --run "pit-benchmark --count=1000000"
+ */
+
+class PitBenchmark {
+public:
+  PitBenchmark()
+    : m_count(100000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  timedRun(std::function<void()> f)
+  {
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t2 - t1).count();
+  }
+
+  void
+  measure(size_t nOutRecords);
+
+private:
+  static const size_t N_FACES = 8;
+  uint32_t m_count;
+  std::vector<std::shared_ptr<nfd::Face>> m_faces;
+  std::vector<std::shared_ptr<ndn::Interest>> m_workload;
+};
+
+void
+PitBenchmark::measure(size_t nOutRecords)
+{
+  nfd::NameTree nameTree;
+  nfd::Pit pit(nameTree);
+  std::vector<std::shared_ptr<nfd::pit::Entry>> entries;
+  entries.reserve(m_count);
+
+  size_t nAllocations = g_nAllocations;
+  size_t nAllocatedBytes = g_nAllocatedBytes;
+  double usInsert = timedRun([&] {
+      for (const std::shared_ptr<ndn::Interest>& interest : m_workload) {
+        entries.push_back(pit.insert(*interest).first);
+      }
+    });
+  size_t nInsertAllocations = g_nAllocations - nAllocations;
+  size_t nInsertBytes = g_nAllocatedBytes - nAllocatedBytes;
+
+  nAllocations = g_nAllocations;
+  nAllocatedBytes = g_nAllocatedBytes;
+  double usRecords = timedRun([&] {
+      for (size_t i = 0; i < m_count; ++i) {
+        const ndn::Interest& interest = *m_workload[i];
+        entries[i]->insertOrUpdateInRecord(m_faces[i % N_FACES], interest);
+        for (size_t j = 1; j <= nOutRecords; ++j) {
+          entries[i]->insertOrUpdateOutRecord(m_faces[(i + j) % N_FACES], interest);
+        }
+      }
+    });
+  size_t nRecordAllocations = g_nAllocations - nAllocations;
+  size_t nRecordBytes = g_nAllocatedBytes - nAllocatedBytes;
+
+  // as done by the forwarding pipelines
+  size_t nFound = 0;
+  double usFind = timedRun([&] {
+      for (size_t i = 0; i < m_count; ++i) {
+        const nfd::pit::Entry& entry = *entries[i];
+        nFound += entry.getInRecord(*m_faces[i % N_FACES]) != entry.getInRecords().end();
+        nFound += entry.getOutRecord(*m_faces[(i + 1) % N_FACES]) != entry.getOutRecords().end();
+        nFound += entry.findNonce(static_cast<uint32_t>(i), *m_faces[i % N_FACES]) !=
+                  nfd::pit::DUPLICATE_NONCE_NONE;
+      }
+    });
+
+  std::cout << pit.size() << " entries, 1 InRecord, " << nOutRecords << " OutRecords\n"
+            << "  insert " << usInsert << " us, "
+            << static_cast<double>(nInsertAllocations) / m_count << " allocations and "
+            << static_cast<double>(nInsertBytes) / m_count << " bytes per entry\n"
+            << "  records " << usRecords << " us, "
+            << static_cast<double>(nRecordAllocations) / m_count << " allocations and "
+            << static_cast<double>(nRecordBytes) / m_count << " bytes per entry\n"
+            << "  find " << usFind << " us (" << nFound << " found)\n";
+}
+
+int
+PitBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("count", "Number of pending Interests", m_count);
+  cmd.Parse(argc, argv);
+
+  for (size_t i = 0; i < N_FACES; ++i) {
+    m_faces.push_back(std::make_shared<nfd::NullFace>());
+  }
+
+  m_workload.reserve(m_count);
+  for (uint32_t i = 0; i < m_count; ++i) {
+    m_workload.push_back(std::make_shared<ndn::Interest>(ndn::Name("/bench").appendNumber(i % 1000)
+                                                                             .appendNumber(i)));
+    m_workload.back()->setNonce(i);
+  }
+
+  for (size_t nOutRecords : {0, 1, 2, 3}) {
+    measure(nOutRecords);
+  }
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::PitBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
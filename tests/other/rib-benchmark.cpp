@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// rib-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/NFD/rib/fib-updater.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/null-face.hpp"
+
+#include <ndn-cxx/face.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Times how long the RIB takes to update the FIB when a face carrying many routes goes away,
+ * with FIB updates applied in process as ndn::L3Protocol does:
+ *
+ *     ./waf --run "rib-benchmark --prefixes=100000 --faces=64 --faces-per-prefix=3"
+ *
+ * The RIB resembles that of a router in a large topology after routing has converged:
+ * /net/<i % 100>/<i> is reachable through faces-per-prefix of the faces, and each /net/<j>
+ * has a child-inherit route, so removing a face also changes inherited routes.
+ */
+
+class RibBenchmark {
+public:
+  RibBenchmark()
+    : m_nPrefixes(10000)
+    , m_nFaces(16)
+    , m_nFacesPerPrefix(3)
+    , m_forwarder(nullptr)
+    , m_nFibUpdates(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  timedRun(std::function<void()> f)
+  {
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t2 - t1).count();
+  }
+
+  /**
+   * Applies an update to the forwarder's FIB as FibManager does
+   */
+  uint32_t
+  apply(const nfd::rib::FibUpdate& update);
+
+  void
+  registerRoute(const ndn::Name& name, nfd::FaceId faceId, uint64_t cost, uint64_t flags);
+
+  /**
+   * Runs on the node, where ndn::Face can be created
+   */
+  void
+  measure(Ptr<Node> node);
+
+private:
+  uint32_t m_nPrefixes;
+  uint32_t m_nFaces;
+  uint32_t m_nFacesPerPrefix;
+
+  nfd::Forwarder* m_forwarder;
+  std::shared_ptr< ::ndn::Face> m_face;
+  std::shared_ptr< ::ndn::nfd::Controller> m_controller;
+  nfd::rib::Rib m_rib;
+  std::shared_ptr<nfd::rib::FibUpdater> m_fibUpdater;
+  size_t m_nFibUpdates;
+};
+
+uint32_t
+RibBenchmark::apply(const nfd::rib::FibUpdate& update)
+{
+  ++m_nFibUpdates;
+  std::shared_ptr<nfd::Face> nextHop = m_forwarder->getFace(update.faceId);
+  if (nextHop == nullptr)
+    return update.action == nfd::rib::FibUpdate::ADD_NEXTHOP ? 410 : 200;
+
+  nfd::Fib& fib = m_forwarder->getFib();
+  if (update.action == nfd::rib::FibUpdate::ADD_NEXTHOP) {
+    fib.insert(update.name).first->addNextHop(nextHop, update.cost);
+  }
+  else {
+    std::shared_ptr<nfd::fib::Entry> entry = fib.findExactMatch(update.name);
+    if (entry != nullptr) {
+      entry->removeNextHop(nextHop);
+      if (!entry->hasNextHops())
+        fib.erase(*entry);
+    }
+  }
+  return 200;
+}
+
+void
+RibBenchmark::registerRoute(const ndn::Name& name, nfd::FaceId faceId, uint64_t cost,
+                            uint64_t flags)
+{
+  nfd::rib::Route route;
+  route.faceId = faceId;
+  route.cost = cost;
+  route.flags = flags;
+
+  nfd::rib::RibUpdate update;
+  update.setAction(nfd::rib::RibUpdate::REGISTER)
+        .setName(name)
+        .setRoute(route);
+  m_rib.beginApplyUpdate(update, nullptr, nullptr);
+}
+
+void
+RibBenchmark::measure(Ptr<Node> node)
+{
+  m_forwarder = node->GetObject<ndn::L3Protocol>()->getForwarder().get();
+  m_face = std::make_shared< ::ndn::Face>();
+  m_controller = std::make_shared< ::ndn::nfd::Controller>(*m_face,
+                                                          ndn::StackHelper::getKeyChain());
+  m_fibUpdater = std::make_shared<nfd::rib::FibUpdater>(m_rib, *m_controller);
+  m_fibUpdater->setFibUpdateApplier([this] (const nfd::rib::FibUpdate& update) {
+      return this->apply(update);
+    });
+
+  std::vector<nfd::FaceId> faceIds;
+  for (uint32_t i = 0; i < m_nFaces; ++i) {
+    std::shared_ptr<nfd::Face> face = std::make_shared<nfd::NullFace>();
+    m_forwarder->addFace(face);
+    faceIds.push_back(face->getId());
+  }
+
+  double usRegister = timedRun([&] {
+      for (uint32_t j = 0; j < 100; ++j) {
+        registerRoute(ndn::Name("/net").appendNumber(j), faceIds[j % m_nFaces], 50,
+                      ::ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+      }
+      for (uint32_t i = 0; i < m_nPrefixes; ++i) {
+        ndn::Name prefix = ndn::Name("/net").appendNumber(i % 100).appendNumber(i);
+        for (uint32_t k = 0; k < m_nFacesPerPrefix; ++k) {
+          registerRoute(prefix, faceIds[(i + k) % m_nFaces], 10 * (k + 1), 0);
+        }
+      }
+    });
+  size_t nRoutes = m_rib.size();
+  size_t nRegisterUpdates = m_nFibUpdates;
+
+  m_nFibUpdates = 0;
+  double usConverge = timedRun([&] {
+      m_forwarder->getFace(faceIds[0])->close();
+      m_rib.beginRemoveFace(faceIds[0]);
+    });
+
+  std::cout << m_nPrefixes << " prefixes via " << m_nFacesPerPrefix << " of " << m_nFaces
+            << " faces (" << nRoutes << " routes)\n"
+            << "  register " << usRegister << " us (" << nRegisterUpdates << " FIB updates)\n"
+            << "  converge after face removal " << usConverge << " us ("
+            << m_rib.size() << " routes left, " << m_nFibUpdates << " FIB updates)\n";
+}
+
+int
+RibBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("prefixes", "Number of prefixes", m_nPrefixes);
+  cmd.AddValue("faces", "Number of faces", m_nFaces);
+  cmd.AddValue("faces-per-prefix", "Number of faces each prefix is reachable through",
+               m_nFacesPerPrefix);
+  cmd.Parse(argc, argv);
+
+  Ptr<Node> node = CreateObject<Node>();
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install(node);
+
+  Simulator::ScheduleWithContext(node->GetId(), Seconds(0), &RibBenchmark::measure, this, node);
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  m_fibUpdater.reset();
+  m_controller.reset();
+  m_face.reset();
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::RibBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
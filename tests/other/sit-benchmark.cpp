@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// sit-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/NFD/daemon/table/cfib.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/null-face.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+
+namespace ns3 {
+
+/**
+ * Compares the SIT replacement index (the intrusive LRU list in nfd::Cfib) with the
+ * Name-keyed LRU map it replaced, and the single-lookup Cfib::recordDownstream with the
+ * findExactMatch-insert-addNextHop sequence it replaced:
+ *
+ *     ./waf --run "sit-benchmark --capacity=100000"
+ */
+
+/** \brief the Name-keyed LRU index that Cfib used before the intrusive index,
+ *         kept here as a baseline
+ */
+class NameKeyedLruCache : nfd::noncopyable
+{
+public:
+  explicit
+  NameKeyedLruCache(size_t capacity)
+    : m_entries(capacity)
+  {
+    for (Node& node : m_entries) {
+      m_freeEntries.push_back(&node);
+    }
+    m_head.prev = nullptr;
+    m_head.next = &m_tail;
+    m_tail.prev = &m_head;
+    m_tail.next = nullptr;
+  }
+
+  /** \return evicted entry, or nullptr
+   */
+  std::shared_ptr<nfd::fib::Entry>
+  put(const ndn::Name& key, std::shared_ptr<nfd::fib::Entry> data)
+  {
+    Node* node = m_mapping[key];
+    if (node != nullptr) {
+      detach(node);
+      node->data = data;
+      attach(node);
+      return nullptr;
+    }
+
+    std::shared_ptr<nfd::fib::Entry> evicted;
+    if (m_freeEntries.empty()) {
+      node = m_tail.prev;
+      evicted = node->data;
+      detach(node);
+      m_mapping.erase(node->key);
+    }
+    else {
+      node = m_freeEntries.back();
+      m_freeEntries.pop_back();
+    }
+    node->key = key;
+    node->data = data;
+    m_mapping[key] = node;
+    attach(node);
+    return evicted;
+  }
+
+  std::shared_ptr<nfd::fib::Entry>
+  get(const ndn::Name& key)
+  {
+    Node* node = m_mapping[key];
+    if (node == nullptr) {
+      return nullptr;
+    }
+    detach(node);
+    attach(node);
+    return node->data;
+  }
+
+private:
+  struct Node
+  {
+    ndn::Name key;
+    std::shared_ptr<nfd::fib::Entry> data;
+    Node* prev;
+    Node* next;
+  };
+
+  void
+  detach(Node* node)
+  {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+  }
+
+  void
+  attach(Node* node)
+  {
+    node->next = m_head.next;
+    node->prev = &m_head;
+    m_head.next = node;
+    node->next->prev = node;
+  }
+
+private:
+  std::unordered_map<ndn::Name, Node*, std::hash<ndn::Name>> m_mapping;
+  std::vector<Node> m_entries;
+  std::vector<Node*> m_freeEntries;
+  Node m_head;
+  Node m_tail;
+};
+
+class SitBenchmark {
+public:
+  SitBenchmark()
+    : m_capacity(100000)
+    , m_face(std::make_shared<nfd::NullFace>())
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  timedRun(std::function<void()> f)
+  {
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t2 - t1).count();
+  }
+
+  /// inserts every name of the workload (the second half evicts the first),
+  /// then touches the surviving half once
+  void
+  runNameKeyed();
+
+  void
+  runIntrusive();
+
+  /// per-Data SIT update as done in Forwarder::onOutgoingData
+  void
+  runRecordDownstream();
+
+private:
+  uint32_t m_capacity;
+  std::shared_ptr<nfd::Face> m_face;
+  // SIT-style names /sit/<producer>/<seq>, twice the capacity
+  std::vector<ndn::Name> m_workload;
+};
+
+void
+SitBenchmark::runNameKeyed()
+{
+  nfd::NameTree nameTree;
+  nfd::Fib fib(nameTree);
+  NameKeyedLruCache cache(m_capacity);
+
+  double nsInsert = timedRun([&] {
+      for (const ndn::Name& name : m_workload) {
+        std::shared_ptr<nfd::fib::Entry> entry = fib.insert(name).first;
+        std::shared_ptr<nfd::fib::Entry> evicted = cache.put(name, entry);
+        if (evicted != nullptr) {
+          evicted->clearNextHops();
+        }
+        entry->addNextHop(m_face, 0);
+      }
+    });
+
+  double nsTouch = timedRun([&] {
+      for (size_t i = m_capacity; i < m_workload.size(); ++i) {
+        fib.findExactMatch(m_workload[i]);
+        cache.get(m_workload[i]);
+      }
+    });
+
+  std::cout << "Name-keyed LRU\t"
+            << nsInsert / m_workload.size() << " ns/insert\t"
+            << nsTouch / m_capacity << " ns/touch\n";
+}
+
+void
+SitBenchmark::runIntrusive()
+{
+  nfd::NameTree nameTree;
+  nfd::Cfib sit(nameTree, m_capacity);
+
+  double nsInsert = timedRun([&] {
+      for (const ndn::Name& name : m_workload) {
+        sit.insert(name).first->addNextHop(m_face, 0);
+      }
+    });
+
+  double nsTouch = timedRun([&] {
+      for (size_t i = m_capacity; i < m_workload.size(); ++i) {
+        sit.findExactMatch(m_workload[i]);
+      }
+    });
+
+  std::cout << "Intrusive LRU\t"
+            << nsInsert / m_workload.size() << " ns/insert\t"
+            << nsTouch / m_capacity << " ns/touch\t"
+            << sit.getNCachedEntries() << " entries kept\n";
+}
+
+void
+SitBenchmark::runRecordDownstream()
+{
+  nfd::NameTree nameTree;
+  nfd::Cfib sit(nameTree, m_capacity);
+
+  double nsFindInsert = timedRun([&] {
+      for (const ndn::Name& name : m_workload) {
+        std::shared_ptr<nfd::fib::Entry> sitEntry = sit.findExactMatch(name);
+        if (sitEntry == nullptr || !sitEntry->hasNextHops()) {
+          sitEntry = sit.insert(name).first;
+        }
+        sitEntry->addNextHop(m_face, 0);
+      }
+    });
+
+  double nsRecord = timedRun([&] {
+      for (const ndn::Name& name : m_workload) {
+        sit.recordDownstream(name, m_face);
+      }
+    });
+
+  std::cout << "findExactMatch-insert-addNextHop\t"
+            << nsFindInsert / m_workload.size() << " ns/Data\n"
+            << "recordDownstream\t"
+            << nsRecord / m_workload.size() << " ns/Data\n";
+}
+
+int
+SitBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("capacity", "SIT capacity; the workload has twice as many names", m_capacity);
+  cmd.Parse(argc, argv);
+
+  m_workload.reserve(m_capacity * 2);
+  for (uint32_t i = 0; i < m_capacity * 2; ++i) {
+    m_workload.push_back(ndn::Name("/sit").appendNumber(i % 100).appendSequenceNumber(i));
+    m_workload.back().wireEncode();
+  }
+
+  std::cout << "SIT capacity " << m_capacity << ", " << m_workload.size() << " names\n";
+  runNameKeyed();
+  runIntrusive();
+  runRecordDownstream();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::SitBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
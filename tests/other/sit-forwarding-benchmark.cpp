@@ -0,0 +1,300 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// sit-forwarding-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/apps/ndn-consumer-sit.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "allocation-counter.hpp"
+
+#include <boost/random/discrete_distribution.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <set>
+
+namespace ns3 {
+
+/**
+ * Measures how many packets per second of wall-clock time the forwarders of a SIT scenario
+ * handle, for the pickone, picklatestone and multicast strategies:
+ *
+ *     ./waf --run "sit-forwarding-benchmark --topology=grid --nodes=25 --strategy=pickone"
+ *     ./waf --run "sit-forwarding-benchmark --topology=rocketfuel-like --nodes=100 --scope=4"
+ *
+ * Producers of /prefix/<p> are spread evenly over the nodes and every node runs a ConsumerSit.
+ * Each request names /prefix/<k mod producers>/<k> for a Zipf-distributed content rank k and
+ * is sent by a uniformly chosen consumer, with a scope of the route cost plus --scope, as in
+ * ndn-sit-test.
+ */
+
+class SitForwardingBenchmark {
+public:
+  SitForwardingBenchmark()
+    : m_topology("grid")
+    , m_nNodes(25)
+    , m_strategy("pickone")
+    , m_nRequests(20000)
+    , m_nContents(1000)
+    , m_zipfExponent(0.8)
+    , m_nProducers(4)
+    , m_scope(2)
+    , m_sitCapacity(10000)
+    , m_interval(MicroSeconds(500))
+    , m_nSatisfied(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  /// links node (r, c) to (r, c + 1) and (r + 1, c)
+  void
+  makeGrid();
+
+  /**
+   * Makes a connected graph with the heavy-tailed degrees of Rocketfuel maps: each new node
+   * attaches to two distinct existing nodes picked with probability proportional to their
+   * degree.
+   */
+  void
+  makeRocketfuelLike();
+
+  void
+  onData(std::shared_ptr<const ndn::Data>, Ptr<ndn::App>, std::shared_ptr<ndn::Face>)
+  {
+    ++m_nSatisfied;
+  }
+
+private:
+  std::string m_topology;
+  uint32_t m_nNodes;
+  std::string m_strategy;
+  uint32_t m_nRequests;
+  uint32_t m_nContents; ///< contents are ranked 1..nContents by popularity
+  double m_zipfExponent;
+  uint32_t m_nProducers;
+  uint32_t m_scope; ///< scoped downstream counter added to the route cost
+  uint32_t m_sitCapacity;
+  Time m_interval; ///< time between two requests
+
+  NodeContainer m_nodes;
+  size_t m_nLinks;
+  size_t m_nSatisfied;
+};
+
+void
+SitForwardingBenchmark::makeGrid()
+{
+  uint32_t side = static_cast<uint32_t>(std::sqrt(m_nNodes));
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(side, side, p2p);
+  for (uint32_t r = 0; r < side; ++r) {
+    for (uint32_t c = 0; c < side; ++c) {
+      m_nodes.Add(grid.GetNode(r, c));
+    }
+  }
+  m_nNodes = side * side;
+  m_nLinks = 2 * side * (side - 1);
+}
+
+void
+SitForwardingBenchmark::makeRocketfuelLike()
+{
+  m_nodes.Create(m_nNodes);
+  PointToPointHelper p2p;
+
+  boost::random::mt19937 rng(1);
+  std::vector<uint32_t> endpoints; // node i appears degree(i) times
+  p2p.Install(m_nodes.Get(0), m_nodes.Get(1));
+  endpoints.push_back(0);
+  endpoints.push_back(1);
+  m_nLinks = 1;
+
+  for (uint32_t i = 2; i < m_nNodes; ++i) {
+    std::set<uint32_t> peers;
+    while (peers.size() < 2) {
+      boost::random::uniform_int_distribution<size_t> dist(0, endpoints.size() - 1);
+      peers.insert(endpoints[dist(rng)]);
+    }
+    for (uint32_t peer : peers) {
+      p2p.Install(m_nodes.Get(peer), m_nodes.Get(i));
+      endpoints.push_back(peer);
+      endpoints.push_back(i);
+      ++m_nLinks;
+    }
+  }
+}
+
+int
+SitForwardingBenchmark::run(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("100Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100"));
+
+  CommandLine cmd;
+  cmd.AddValue("topology", "grid or rocketfuel-like", m_topology);
+  cmd.AddValue("nodes", "Number of nodes (a grid uses the largest square below)", m_nNodes);
+  cmd.AddValue("strategy", "pickone, picklatestone or multicast", m_strategy);
+  cmd.AddValue("requests", "Number of requests", m_nRequests);
+  cmd.AddValue("contents", "Number of contents", m_nContents);
+  cmd.AddValue("zipf", "Zipf exponent of content popularity", m_zipfExponent);
+  cmd.AddValue("producers", "Number of producers", m_nProducers);
+  cmd.AddValue("scope", "Scoped downstream counter added to the route cost", m_scope);
+  cmd.AddValue("sit", "SIT capacity of every forwarder", m_sitCapacity);
+  cmd.AddValue("interval", "Time between two requests", m_interval);
+  cmd.Parse(argc, argv);
+
+  if (m_topology == "grid") {
+    makeGrid();
+  }
+  else if (m_topology == "rocketfuel-like") {
+    makeRocketfuelLike();
+  }
+  else {
+    std::cerr << "Invalid topology: " << m_topology << "\n";
+    return 1;
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install(m_nodes);
+  ndn::StrategyChoiceHelper::Install(m_nodes, "/", "/localhost/nfd/strategy/" + m_strategy);
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.Install(m_nodes);
+
+  ApplicationContainer consumers;
+  for (uint32_t i = 0; i < m_nNodes; ++i) {
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerSit");
+    consumerHelper.SetPrefix("/prefix");
+    consumers.Add(consumerHelper.Install(m_nodes.Get(i)));
+    consumers.Get(i)->TraceConnectWithoutContext("ReceivedDatas",
+      MakeCallback(&SitForwardingBenchmark::onData, this));
+  }
+
+  for (uint32_t p = 0; p < m_nProducers; ++p) {
+    ndn::Name prefix("/prefix");
+    prefix.appendNumber(p);
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(prefix.toUri());
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(m_nodes.Get(p * m_nNodes / m_nProducers));
+    ndnGlobalRoutingHelper.AddOrigins(prefix.toUri(), m_nodes.Get(p * m_nNodes / m_nProducers));
+  }
+
+  for (uint32_t i = 0; i < m_nNodes; ++i) {
+    ndn::L3Protocol::getL3Protocol(m_nodes.Get(i))->getForwarder()->setSitCapacity(m_sitCapacity);
+  }
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  // the whole request stream is queued on the consumers before measuring
+  boost::random::mt19937 rng(42);
+  std::vector<double> weights(m_nContents);
+  for (uint32_t k = 0; k < m_nContents; ++k) {
+    weights[k] = 1.0 / std::pow(k + 1, m_zipfExponent);
+  }
+  boost::random::discrete_distribution<uint32_t> zipf(weights.begin(), weights.end());
+  boost::random::uniform_int_distribution<uint32_t> pickConsumer(0, m_nNodes - 1);
+
+  for (uint32_t i = 0; i < m_nRequests; ++i) {
+    uint32_t k = zipf(rng) + 1;
+    uint32_t producer = k % m_nProducers;
+    uint32_t consumer = pickConsumer(rng);
+
+    ndn::Name prefix("/prefix");
+    prefix.appendNumber(producer);
+    nfd::Fib& fib = ndn::L3Protocol::getL3Protocol(m_nodes.Get(consumer))->getForwarder()->getFib();
+    std::shared_ptr<nfd::fib::Entry> fibEntry = fib.findLongestPrefixMatch(prefix);
+    uint32_t cost = fibEntry->hasNextHops() ? fibEntry->getNextHops()[0].getCost() : 0;
+
+    DynamicCast<ndn::ConsumerSit>(consumers.Get(consumer))
+      ->AddFlow(producer, k, 1, cost + m_scope, (m_interval * i).GetSeconds());
+  }
+
+  size_t nProbesBefore = 0;
+  for (uint32_t i = 0; i < m_nNodes; ++i) {
+    std::shared_ptr<nfd::Forwarder> forwarder = ndn::L3Protocol::getL3Protocol(m_nodes.Get(i))
+                                                  ->getForwarder();
+    nProbesBefore += forwarder->getNameTree().getNProbes() +
+                     forwarder->getSitNameTree().getNProbes();
+  }
+  size_t nAllocationsBefore = g_nAllocations;
+
+  Simulator::Stop(m_interval * m_nRequests + Seconds(2));
+  std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+  Simulator::Run();
+  std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+  size_t nAllocations = g_nAllocations - nAllocationsBefore;
+  double seconds = std::chrono::duration<double>(t2 - t1).count();
+
+  uint64_t nInInterests = 0;
+  uint64_t nPackets = 0;
+  uint64_t nMaxPackets = 0;
+  size_t nProbes = 0;
+  for (uint32_t i = 0; i < m_nNodes; ++i) {
+    std::shared_ptr<nfd::Forwarder> forwarder = ndn::L3Protocol::getL3Protocol(m_nodes.Get(i))
+                                                  ->getForwarder();
+    const nfd::ForwarderCounters& counters = forwarder->getCounters();
+    uint64_t nForwarderPackets = counters.getNInInterests() + counters.getNInDatas() +
+                                 counters.getNOutInterests() + counters.getNOutDatas();
+    nInInterests += counters.getNInInterests();
+    nPackets += nForwarderPackets;
+    nMaxPackets = std::max(nMaxPackets, nForwarderPackets);
+    nProbes += forwarder->getNameTree().getNProbes() + forwarder->getSitNameTree().getNProbes();
+  }
+  nProbes -= nProbesBefore;
+
+  std::cout << m_strategy << " " << m_topology << " nodes=" << m_nNodes
+            << " links=" << m_nLinks << " scope=" << m_scope << " sit=" << m_sitCapacity
+            << " requests=" << m_nRequests << " satisfied=" << m_nSatisfied << "\n"
+            << "  " << nPackets << " packets in " << seconds << " s: "
+            << nPackets / seconds << " packets/s, "
+            << nPackets / seconds / m_nNodes << " packets/s per forwarder, "
+            << "busiest forwarder " << nMaxPackets / seconds << " packets/s\n"
+            << "  " << seconds * 1e9 / nPackets << " ns per packet, "
+            << static_cast<double>(nAllocations) / nPackets << " allocations per packet, "
+            << nInInterests << " incoming Interests, "
+            << static_cast<double>(nProbes) / nInInterests
+            << " NameTree probes per incoming Interest\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::SitForwardingBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/core/small-vector.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::SmallVector;
+
+BOOST_FIXTURE_TEST_SUITE(NfdCoreSmallVector, CleanupFixture)
+
+/** \brief counts live instances
+ */
+class Counted
+{
+public:
+  explicit
+  Counted(int value)
+    : value(value)
+  {
+    ++s_nInstances;
+  }
+
+  Counted(Counted&& other)
+    : value(other.value)
+  {
+    ++s_nInstances;
+  }
+
+  Counted&
+  operator=(Counted&& other) = default;
+
+  ~Counted()
+  {
+    --s_nInstances;
+  }
+
+public:
+  int value;
+  static int s_nInstances;
+};
+
+int Counted::s_nInstances = 0;
+
+static std::vector<int>
+getValues(const SmallVector<Counted, 2>& vec)
+{
+  std::vector<int> values;
+  for (const Counted& item : vec) {
+    values.push_back(item.value);
+  }
+  return values;
+}
+
+BOOST_AUTO_TEST_CASE(InsertErase)
+{
+  {
+    SmallVector<Counted, 2> vec;
+    BOOST_CHECK(vec.empty());
+    BOOST_CHECK(vec.begin() == vec.end());
+
+    vec.emplace_back(2);
+    vec.emplace_front(1);
+    BOOST_CHECK_EQUAL(vec.size(), 2);
+    BOOST_CHECK(vec.isInline());
+    BOOST_CHECK_EQUAL(vec[0].value, 1);
+    BOOST_CHECK_EQUAL(vec[1].value, 2);
+
+    // moves to the heap
+    SmallVector<Counted, 2>::iterator it = vec.emplace(vec.begin() + 1, 3);
+    BOOST_CHECK(!vec.isInline());
+    BOOST_CHECK_EQUAL(it->value, 3);
+    BOOST_CHECK(getValues(vec) == std::vector<int>({1, 3, 2}));
+    BOOST_CHECK_EQUAL(Counted::s_nInstances, 3);
+
+    it = vec.erase(vec.begin());
+    BOOST_CHECK_EQUAL(it->value, 3);
+    BOOST_CHECK(getValues(vec) == std::vector<int>({3, 2}));
+    BOOST_CHECK_EQUAL(Counted::s_nInstances, 2);
+
+    it = vec.erase(vec.begin() + 1);
+    BOOST_CHECK(it == vec.end());
+    BOOST_CHECK(getValues(vec) == std::vector<int>({3}));
+
+    size_t capacity = vec.capacity();
+    vec.clear();
+    BOOST_CHECK(vec.empty());
+    BOOST_CHECK_EQUAL(vec.capacity(), capacity);
+    BOOST_CHECK_EQUAL(Counted::s_nInstances, 0);
+
+    for (int i = 0; i < 10; ++i) {
+      vec.emplace_front(i);
+    }
+    BOOST_CHECK_EQUAL(vec.size(), 10);
+    BOOST_CHECK_EQUAL(vec[0].value, 9);
+    BOOST_CHECK_EQUAL(vec[9].value, 0);
+  }
+  BOOST_CHECK_EQUAL(Counted::s_nInstances, 0);
+}
+
+BOOST_AUTO_TEST_CASE(InsertOwnElement)
+{
+  SmallVector<std::string, 2> vec;
+  vec.emplace_back("first element, long enough to be stored on the heap");
+  vec.emplace_back("second element, long enough to be stored on the heap");
+
+  // the argument refers to storage that is released when the vector grows
+  vec.emplace_back(vec[0]);
+  vec.emplace_front(vec[1]);
+  BOOST_REQUIRE_EQUAL(vec.size(), 4);
+  BOOST_CHECK_EQUAL(vec[0], vec[2]);
+  BOOST_CHECK_EQUAL(vec[1], vec[3]);
+  BOOST_CHECK_EQUAL(vec[3], "first element, long enough to be stored on the heap");
+
+  vec.emplace_back(vec[3]);
+  BOOST_CHECK_EQUAL(vec[4], vec[1]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
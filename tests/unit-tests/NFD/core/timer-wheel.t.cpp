@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/core/timer-wheel.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::TimerWheel;
+
+class TimerWheelFixture : public SimulatorTimeFixture
+{
+protected:
+  class TestTimer : public TimerWheel::Timer
+  {
+  public:
+    time::nanoseconds deadline;
+    time::nanoseconds expiredAt = time::nanoseconds::max();
+  };
+
+  TimerWheelFixture()
+    : wheel(TICK, std::bind(&TimerWheelFixture::onExpire, this, std::placeholders::_1))
+  {
+  }
+
+  void
+  onExpire(TimerWheel::Timer& timer)
+  {
+    TestTimer& testTimer = static_cast<TestTimer&>(timer);
+    testTimer.expiredAt = time::steady_clock::now().time_since_epoch();
+    expired.push_back(&testTimer);
+  }
+
+  void
+  schedule(TestTimer& timer, const time::nanoseconds& delay)
+  {
+    timer.deadline = time::steady_clock::now().time_since_epoch() + delay;
+    wheel.schedule(timer, delay);
+  }
+
+protected:
+  static const time::nanoseconds TICK;
+  TimerWheel wheel;
+  std::vector<TestTimer*> expired;
+};
+const time::nanoseconds TimerWheelFixture::TICK = time::milliseconds(1);
+
+BOOST_FIXTURE_TEST_SUITE(NfdCoreTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Expire)
+{
+  // within one slot, across slots of the lowest level, and across higher levels
+  std::vector<time::nanoseconds> delays{time::nanoseconds(0), time::microseconds(300),
+                                        time::milliseconds(1), time::milliseconds(3),
+                                        time::microseconds(63500), time::milliseconds(64),
+                                        time::milliseconds(100), time::seconds(4),
+                                        time::seconds(4), time::milliseconds(262145)};
+  std::vector<TestTimer> timers(delays.size());
+
+  this->advanceClocks(time::microseconds(100));
+  for (size_t i = 0; i < timers.size(); ++i) {
+    this->schedule(timers[i], delays[i]);
+  }
+  BOOST_CHECK_EQUAL(wheel.size(), timers.size());
+
+  this->advanceClocks(time::seconds(263));
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  BOOST_REQUIRE_EQUAL(expired.size(), timers.size());
+
+  for (TestTimer& timer : timers) {
+    BOOST_CHECK(!timer.isPending());
+    // expires at the first tick not before the deadline
+    BOOST_CHECK_GE(timer.expiredAt, timer.deadline);
+    BOOST_CHECK_LT(timer.expiredAt, timer.deadline + TICK);
+  }
+  for (size_t i = 1; i < expired.size(); ++i) {
+    BOOST_CHECK_LE(expired[i - 1]->expiredAt, expired[i]->expiredAt);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CancelReschedule)
+{
+  TestTimer timer1;
+  TestTimer timer2;
+  this->schedule(timer1, time::milliseconds(10));
+  this->schedule(timer2, time::milliseconds(10));
+  timer1.cancel();
+  BOOST_CHECK(!timer1.isPending());
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  this->schedule(timer2, time::milliseconds(200)); // reschedule later
+  this->advanceClocks(time::milliseconds(100));
+  BOOST_CHECK_EQUAL(expired.size(), 0);
+
+  this->schedule(timer2, time::milliseconds(5)); // reschedule earlier
+  this->advanceClocks(time::milliseconds(10));
+  BOOST_REQUIRE_EQUAL(expired.size(), 1);
+  BOOST_CHECK_EQUAL(expired[0], &timer2);
+  BOOST_CHECK(expired[0]->expiredAt == time::milliseconds(105));
+
+  {
+    TestTimer timer3;
+    this->schedule(timer3, time::milliseconds(5));
+  } // destroying a pending timer cancels it
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  this->advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(expired.size(), 1);
+
+  TestTimer timer4;
+  {
+    TimerWheel wheel2(TICK, [] (TimerWheel::Timer&) {});
+    wheel2.schedule(timer4, time::milliseconds(5));
+    BOOST_CHECK(timer4.isPending());
+  } // destroying the wheel cancels its timers
+  BOOST_CHECK(!timer4.isPending());
+}
+
+BOOST_AUTO_TEST_CASE(Events)
+{
+  // 1000 timers expiring within 10 ticks
+  std::vector<TestTimer> timers(1000);
+  for (size_t i = 0; i < timers.size(); ++i) {
+    this->schedule(timers[i], time::seconds(1) + time::microseconds(i * 10));
+  }
+  this->advanceClocks(time::seconds(2));
+
+  BOOST_CHECK_EQUAL(expired.size(), timers.size());
+  // one event per expiring tick, plus moving the timers down the levels
+  BOOST_CHECK_LE(wheel.getNEvents(), 10 + TimerWheel::N_LEVELS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,242 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "NFD/daemon/face/null-face.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "apps/ndn-app.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "utils/ndn-ns3-packet-tag.hpp"
+#include "utils/ndn-fw-hop-count-tag.hpp"
+
+#include "../../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::Forwarder;
+
+class PitTimerWheelFixture : public SimulatorTimeFixture
+{
+protected:
+  PitTimerWheelFixture()
+    : nExpired(0)
+  {
+    Forwarder::setDefaultPitTimerTick(time::milliseconds(10));
+    forwarder.reset(new Forwarder);
+    Forwarder::setDefaultPitTimerTick(time::nanoseconds::zero());
+
+    forwarder->beforeExpirePendingInterest.connect([this] (const nfd::pit::Entry&) {
+        ++nExpired;
+      });
+
+    face1 = std::make_shared<nfd::NullFace>();
+    face2 = std::make_shared<nfd::NullFace>();
+    face3 = std::make_shared<nfd::NullFace>();
+    forwarder->addFace(face1);
+    forwarder->addFace(face2);
+    forwarder->addFace(face3);
+    forwarder->getFib().insert(Name("/A")).first->addNextHop(face2, 0);
+  }
+
+  shared_ptr<Interest>
+  makeInterest(const Name& name, uint32_t nonce)
+  {
+    auto interest = make_shared<Interest>(name);
+    interest->setNonce(nonce);
+    interest->setInterestLifetime(time::milliseconds(45));
+    interest->setFloodFlag(1);
+    return interest;
+  }
+
+  shared_ptr<Data>
+  makeData(const Name& name)
+  {
+    auto data = make_shared<Data>(name);
+    StackHelper::getKeyChain().sign(*data);
+    return data;
+  }
+
+protected:
+  std::unique_ptr<Forwarder> forwarder;
+  shared_ptr<Face> face1;
+  shared_ptr<Face> face2;
+  shared_ptr<Face> face3;
+  int nExpired;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdDaemonFwForwarder, PitTimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(PitTimerWheel)
+{
+  BOOST_REQUIRE(forwarder->getPitTimerWheel() != nullptr);
+
+  forwarder->onInterest(*face1, *makeInterest("/A/1", 1));
+  forwarder->onInterest(*face1, *makeInterest("/A/2", 2));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 2);
+  BOOST_CHECK_EQUAL(forwarder->getPitTimerWheel()->size(), 2);
+
+  // satisfied entry waits for the straggler timer on the wheel
+  forwarder->onData(*face2, *makeData("/A/1"));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 2);
+  BOOST_CHECK_EQUAL(forwarder->getPitTimerWheel()->size(), 2);
+
+  // unsatisfied entry expires at 50ms, its lifetime rounded up to the tick
+  this->advanceClocks(time::milliseconds(45));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 2);
+  BOOST_CHECK_EQUAL(nExpired, 0);
+  this->advanceClocks(time::milliseconds(5));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 1);
+  BOOST_CHECK_EQUAL(nExpired, 1);
+
+  // satisfied entry leaves after its 100ms straggler time, without expiring
+  this->advanceClocks(time::milliseconds(45));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 1);
+  this->advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 0);
+  BOOST_CHECK_EQUAL(forwarder->getPitTimerWheel()->size(), 0);
+  BOOST_CHECK_EQUAL(nExpired, 1);
+}
+
+BOOST_AUTO_TEST_CASE(PitTimerWheelRenew)
+{
+  forwarder->onInterest(*face1, *makeInterest("/A/1", 1));
+
+  // a new downstream moves the unsatisfy timer to its own expiry, 20+45ms rounded up
+  this->advanceClocks(time::milliseconds(20));
+  forwarder->onInterest(*face3, *makeInterest("/A/1", 3));
+  BOOST_CHECK_EQUAL(forwarder->getPitTimerWheel()->size(), 1);
+
+  this->advanceClocks(time::milliseconds(40));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 1);
+  BOOST_CHECK_EQUAL(nExpired, 0);
+  this->advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 0);
+  BOOST_CHECK_EQUAL(nExpired, 1);
+}
+
+BOOST_AUTO_TEST_CASE(PitTimerWheelBothTimers)
+{
+  // no route: the unsatisfy timer set on the miss is replaced by the straggler timer
+  forwarder->onInterest(*face1, *makeInterest("/B/1", 1));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 1);
+  BOOST_CHECK_EQUAL(forwarder->getPitTimerWheel()->size(), 1);
+
+  // the rejected entry is finalized at 100ms, and never expires as unsatisfied
+  this->advanceClocks(time::milliseconds(60));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 1);
+  BOOST_CHECK_EQUAL(nExpired, 0);
+
+  // a new Interest cancels the straggler timer, then is rejected again
+  forwarder->onInterest(*face3, *makeInterest("/B/1", 3));
+  BOOST_CHECK_EQUAL(forwarder->getPitTimerWheel()->size(), 1);
+  this->advanceClocks(time::milliseconds(90));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 1);
+  this->advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(forwarder->getPit().size(), 0);
+  BOOST_CHECK_EQUAL(forwarder->getPitTimerWheel()->size(), 0);
+  BOOST_CHECK_EQUAL(nExpired, 0);
+}
+
+class CachedDataFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  void
+  onData(shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+  {
+    receivedDatas.push_back(data);
+  }
+
+  /** \return the cached Data under /prefix on \p node
+   */
+  std::vector<const Data*>
+  getCachedDatas(const std::string& node)
+  {
+    std::vector<const Data*> datas;
+    const nfd::Cs& cs = getNode(node)->GetObject<L3Protocol>()->getForwarder()->getCs();
+    for (const nfd::cs::Entry& entry : cs) {
+      if (Name("/prefix").isPrefixOf(entry.getName())) {
+        datas.push_back(&entry.getData());
+      }
+    }
+    return datas;
+  }
+
+public:
+  std::vector<shared_ptr<const Data>> receivedDatas;
+};
+
+BOOST_FIXTURE_TEST_CASE(IncomingDataCachedWithoutPacket, CachedDataFixture)
+{
+  createTopology({
+      {"A", "B"},
+      {"B", "C"}
+    });
+
+  addRoutes({
+      {"A", "B", "/prefix", 1},
+      {"B", "C", "/prefix", 1}
+    });
+
+  addApps({
+      {"A", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "0.95s"},
+      {"C", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+  getNode("A")->GetApplication(0)->TraceConnectWithoutContext("ReceivedDatas",
+    MakeCallback(&CachedDataFixture::onData, this));
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  // the consumer gets the Data with its packet and the tags B added on the way
+  BOOST_REQUIRE_EQUAL(receivedDatas.size(), 10);
+  for (const shared_ptr<const Data>& data : receivedDatas) {
+    BOOST_CHECK_EQUAL(data->getContent().value_size(), 1024);
+    auto tag = data->getTag<Ns3PacketTag>();
+    BOOST_REQUIRE(tag != nullptr);
+    FwHopCountTag hopCountTag;
+    BOOST_REQUIRE(tag->getPacket()->PeekPacketTag(hopCountTag));
+    BOOST_CHECK_EQUAL(hopCountTag.Get(), 2);
+  }
+
+  // B strips the packet in place, A caches a copy instead of touching the consumer's Data
+  for (const char* node : {"A", "B"}) {
+    std::vector<const Data*> cached = getCachedDatas(node);
+    BOOST_CHECK_EQUAL(cached.size(), 10);
+    for (const Data* data : cached) {
+      BOOST_CHECK(data->getTag<Ns3PacketTag>() == nullptr);
+      BOOST_CHECK_EQUAL(data->getContent().value_size(), 1024);
+    }
+  }
+  for (const Data* data : getCachedDatas("A")) {
+    for (const shared_ptr<const Data>& received : receivedDatas) {
+      BOOST_CHECK_NE(data, received.get());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/table/cfib.hpp"
+#include "NFD/daemon/face/null-face.hpp"
+
+#include "../../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::Cfib;
+using nfd::NameTree;
+
+BOOST_FIXTURE_TEST_SUITE(NfdDaemonTableCfib, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Eviction)
+{
+  NameTree nameTree;
+  Cfib sit(nameTree, 3);
+  shared_ptr<Face> face = std::make_shared<nfd::NullFace>();
+
+  for (uint64_t seq = 0; seq < 3; ++seq) {
+    sit.recordDownstream(Name("/prefix/1").appendSequenceNumber(seq), face);
+  }
+  // 0 is used again, so 1 is the least recently used
+  BOOST_CHECK(sit.findExactMatch(Name("/prefix/1").appendSequenceNumber(0)) != nullptr);
+
+  sit.recordDownstream(Name("/prefix/1").appendSequenceNumber(3), face);
+  sit.recordDownstream(Name("/prefix/1").appendSequenceNumber(4), face);
+  BOOST_CHECK_EQUAL(sit.getNCachedEntries(), 3);
+  BOOST_CHECK_EQUAL(sit.size(), 3);
+
+  for (uint64_t seq : {1, 2}) {
+    Name name = Name("/prefix/1").appendSequenceNumber(seq);
+    BOOST_CHECK(sit.findExactMatch(name) == nullptr);
+    BOOST_CHECK(nameTree.findExactMatch(name) == nullptr);
+  }
+  for (uint64_t seq : {0, 3, 4}) {
+    Name name = Name("/prefix/1").appendSequenceNumber(seq);
+    BOOST_CHECK(sit.findExactMatch(name) != nullptr);
+    BOOST_CHECK(nameTree.findExactMatch(name) != nullptr);
+  }
+
+  sit.setCapacity(1);
+  BOOST_CHECK_EQUAL(sit.getNCachedEntries(), 1);
+  BOOST_CHECK_EQUAL(sit.size(), 1);
+  BOOST_CHECK(sit.findExactMatch(Name("/prefix/1").appendSequenceNumber(4)) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(RecordDownstreamHashSet)
+{
+  NameTree nameTree;
+  Cfib sit(nameTree, 10);
+  shared_ptr<Face> face1 = std::make_shared<nfd::NullFace>();
+  shared_ptr<Face> face2 = std::make_shared<nfd::NullFace>();
+
+  Name name = Name("/prefix/1").appendSequenceNumber(7);
+  std::vector<size_t> hashSet = nfd::name_tree::computeHashSet(name);
+  shared_ptr<nfd::fib::Entry> entry = sit.recordDownstream(name, hashSet, face1);
+  BOOST_CHECK_EQUAL(entry->getPrefix(), name);
+  BOOST_CHECK(nameTree.findExactMatch(name) != nullptr);
+
+  // the same name without a precomputed hash set reaches the same entry
+  BOOST_CHECK_EQUAL(sit.recordDownstream(name, face2), entry);
+  BOOST_CHECK_EQUAL(sit.size(), 1);
+  BOOST_CHECK_EQUAL(sit.getNCachedEntries(), 1);
+  BOOST_CHECK(entry->hasNextHop(face1));
+  BOOST_CHECK(entry->hasNextHop(face2));
+}
+
+BOOST_AUTO_TEST_CASE(MaxNextHops)
+{
+  NameTree nameTree;
+  Cfib sit(nameTree, 10);
+  sit.setMaxNextHops(3);
+
+  std::vector<shared_ptr<Face>> faces;
+  for (int i = 0; i < 5; ++i) {
+    faces.push_back(std::make_shared<nfd::NullFace>());
+  }
+
+  Name name("/prefix/1/%FE%01");
+  // A, B, C, D: the oldest downstream A is dropped
+  for (int i = 0; i < 4; ++i) {
+    sit.recordDownstream(name, faces[i]);
+  }
+  shared_ptr<nfd::fib::Entry> entry = sit.findExactMatch(name);
+  BOOST_REQUIRE(entry != nullptr);
+  const nfd::fib::NextHopList& nexthops = entry->getNextHops();
+  BOOST_REQUIRE_EQUAL(nexthops.size(), 3);
+  BOOST_CHECK_EQUAL(nexthops[0].getFace(), faces[3]);
+  BOOST_CHECK_EQUAL(nexthops[1].getFace(), faces[2]);
+  BOOST_CHECK_EQUAL(nexthops[2].getFace(), faces[1]);
+
+  // B again, then E: C is now the oldest
+  sit.recordDownstream(name, faces[1]);
+  sit.recordDownstream(name, faces[4]);
+  BOOST_REQUIRE_EQUAL(nexthops.size(), 3);
+  BOOST_CHECK_EQUAL(nexthops[0].getFace(), faces[4]);
+  BOOST_CHECK_EQUAL(nexthops[1].getFace(), faces[1]);
+  BOOST_CHECK_EQUAL(nexthops[2].getFace(), faces[3]);
+}
+
+// without a limit, next hops are ordered as in the FIB: the latest one is swapped to the front
+BOOST_AUTO_TEST_CASE(UnlimitedNextHops)
+{
+  NameTree nameTree;
+  Cfib sit(nameTree, 10);
+
+  std::vector<shared_ptr<Face>> faces;
+  for (int i = 0; i < 3; ++i) {
+    faces.push_back(std::make_shared<nfd::NullFace>());
+  }
+
+  Name name("/prefix/1/%FE%01");
+  for (int i = 0; i < 3; ++i) {
+    sit.recordDownstream(name, faces[i]);
+  }
+  shared_ptr<nfd::fib::Entry> entry = sit.findExactMatch(name);
+  BOOST_REQUIRE(entry != nullptr);
+  const nfd::fib::NextHopList& nexthops = entry->getNextHops();
+  BOOST_REQUIRE_EQUAL(nexthops.size(), 3);
+  BOOST_CHECK_EQUAL(nexthops[0].getFace(), faces[2]);
+  BOOST_CHECK_EQUAL(nexthops[1].getFace(), faces[0]);
+  BOOST_CHECK_EQUAL(nexthops[2].getFace(), faces[1]);
+
+  nfd::fib::Entry fibEntry(name);
+  for (int i = 0; i < 3; ++i) {
+    fibEntry.addNextHop(faces[i], 0);
+  }
+  BOOST_REQUIRE_EQUAL(fibEntry.getNextHops().size(), 3);
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK_EQUAL(fibEntry.getNextHops()[i].getFace(), nexthops[i].getFace());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/table/dead-nonce-list.hpp"
+
+#include "../../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::DeadNonceList;
+
+class LazyFixture : public SimulatorTimeFixture
+{
+protected:
+  LazyFixture()
+    : scheduled(LIFETIME, DeadNonceList::MODE_SCHEDULED)
+    , lazy(LIFETIME, DeadNonceList::MODE_LAZY)
+    , name("/N")
+    , lastNonce(0)
+  {
+  }
+
+  /** \brief adds \p nNonces to both lists every LIFETIME/7 for \p nLifetimes LIFETIMEs
+   */
+  void
+  addNonces(size_t nNonces, int nLifetimes)
+  {
+    for (int i = 0; i < nLifetimes * 7; ++i) {
+      for (size_t j = 0; j < nNonces; ++j) {
+        ++lastNonce;
+        scheduled.add(name, lastNonce);
+        lazy.add(name, lastNonce);
+      }
+      this->advanceClocks(LIFETIME / 7);
+    }
+  }
+
+  void
+  checkSame()
+  {
+    BOOST_CHECK_EQUAL(lazy.size(), scheduled.size());
+    for (uint32_t nonce = 1; nonce <= lastNonce; ++nonce) {
+      BOOST_CHECK_EQUAL(lazy.has(name, nonce), scheduled.has(name, nonce));
+    }
+  }
+
+protected:
+  static const time::nanoseconds LIFETIME;
+  static const size_t INITIAL_CAPACITY; // DeadNonceList::INITIAL_CAPACITY
+  static const size_t EXPECTED_MARK_COUNT; // DeadNonceList::EXPECTED_MARK_COUNT
+  DeadNonceList scheduled;
+  DeadNonceList lazy;
+  Name name;
+  uint32_t lastNonce;
+};
+const time::nanoseconds LazyFixture::LIFETIME = time::milliseconds(200);
+const size_t LazyFixture::INITIAL_CAPACITY = 1 << 7;
+const size_t LazyFixture::EXPECTED_MARK_COUNT = 5;
+
+BOOST_FIXTURE_TEST_SUITE(NfdDaemonTableDeadNonceList, LazyFixture)
+
+BOOST_AUTO_TEST_CASE(LazySameAsScheduled)
+{
+  this->addNonces(INITIAL_CAPACITY / 10, 10);
+  this->checkSame();
+
+  this->addNonces(INITIAL_CAPACITY / 2, 10);
+  this->checkSame();
+
+  // long enough to settle at MIN_CAPACITY, so whole idle cycles are skipped
+  this->advanceClocks(LIFETIME * 300);
+  this->checkSame();
+
+  this->addNonces(INITIAL_CAPACITY / 3, 5);
+  this->checkSame();
+}
+
+BOOST_AUTO_TEST_CASE(LazyEvents)
+{
+  this->advanceClocks(LIFETIME * 10);
+
+  // every LIFETIME, one event per MARK and one capacity adjustment
+  BOOST_CHECK_EQUAL(scheduled.getNEvents(), 10 * (EXPECTED_MARK_COUNT + 1));
+  BOOST_CHECK_EQUAL(lazy.getNEvents(), 0);
+  BOOST_CHECK_EQUAL(lazy.getMode(), DeadNonceList::MODE_LAZY);
+}
+
+BOOST_AUTO_TEST_CASE(DefaultMode)
+{
+  BOOST_CHECK_EQUAL(DeadNonceList().getMode(), DeadNonceList::MODE_SCHEDULED);
+
+  DeadNonceList::setDefaultMode(DeadNonceList::MODE_LAZY);
+  BOOST_CHECK_EQUAL(DeadNonceList().getMode(), DeadNonceList::MODE_LAZY);
+  DeadNonceList::setDefaultMode(DeadNonceList::MODE_SCHEDULED);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/table/name-tree.hpp"
+
+#include "../../../tests-common.hpp"
+
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::NameTree;
+namespace name_tree = nfd::name_tree;
+
+BOOST_FIXTURE_TEST_SUITE(NfdDaemonTableNameTree, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(LookupWithHashSet)
+{
+  NameTree nt;
+  Name name("/A/B/C");
+  std::vector<size_t> hashSet = name_tree::computeHashSet(name);
+
+  shared_ptr<name_tree::Entry> entry = nt.lookup(name, hashSet);
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+  BOOST_CHECK_EQUAL(entry, nt.lookup(name));
+  BOOST_CHECK_EQUAL(entry, nt.findExactMatch(name, hashSet.back()));
+  BOOST_CHECK_EQUAL(entry->getHash(), hashSet.back());
+  BOOST_CHECK_EQUAL(entry->getParent(), nt.findLongestPrefixMatch("/A/B/D"));
+
+  // the hash values are computed once per packet
+  auto interest = make_shared<Interest>(Name("/A/B/C/D"));
+  const std::vector<size_t>& interestHashSet = name_tree::getHashSet(*interest);
+  BOOST_CHECK_EQUAL(interestHashSet.size(), 5);
+  BOOST_CHECK_EQUAL(&interestHashSet, &name_tree::getHashSet(*interest));
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(interest->getName(), interestHashSet), entry);
+}
+
+BOOST_AUTO_TEST_CASE(Probes)
+{
+  for (NameTree::Backend backend : {NameTree::BACKEND_CHAINED,
+                                    NameTree::BACKEND_OPEN_ADDRESSING}) {
+    NameTree nt(16, backend);
+    BOOST_CHECK_EQUAL(nt.getNProbes(), 0);
+
+    // one probe per prefix, including the root
+    nt.lookup("/A/B/C");
+    BOOST_CHECK_EQUAL(nt.getNProbes(), 4);
+
+    nt.findExactMatch("/A/B");
+    BOOST_CHECK_EQUAL(nt.getNProbes(), 5);
+
+    // /A/B/C/D misses, then /A/B/C matches
+    nt.findLongestPrefixMatch("/A/B/C/D");
+    BOOST_CHECK_EQUAL(nt.getNProbes(), 7);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(OpenAddressing)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  NameTree nt(10, NameTree::BACKEND_OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(nt.getBackend(), NameTree::BACKEND_OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(nt.getNBuckets(), 16); // rounded up to a power of two
+
+  shared_ptr<name_tree::Entry> npeABC = nt.lookup("/a/b/c");
+  shared_ptr<name_tree::Entry> npeABD = nt.lookup("/a/b/d");
+  shared_ptr<name_tree::Entry> npeAE = nt.lookup("/a/e");
+  BOOST_CHECK_EQUAL(nt.size(), 6);
+
+  BOOST_CHECK_EQUAL(npeABC->getParent(), nt.findExactMatch("/a/b"));
+  BOOST_CHECK_EQUAL(npeABD->getParent(), nt.findExactMatch("/a/b"));
+  BOOST_CHECK_EQUAL(npeAE->getParent(), nt.findExactMatch("/a"));
+  BOOST_CHECK(!static_cast<bool>(nt.findExactMatch("/does/not/exist")));
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/a/b/c/def"), npeABC);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/a/e/hello"), npeAE);
+
+  BOOST_CHECK_EQUAL(nt.eraseEntryIfEmpty(npeABC), true);
+  BOOST_CHECK_EQUAL(nt.size(), 5);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/a/b/c/def"), nt.findExactMatch("/a/b"));
+}
+
+BOOST_AUTO_TEST_CASE(ResizeShrink)
+{
+  NameTree nt(16, NameTree::BACKEND_OPEN_ADDRESSING);
+
+  shared_ptr<name_tree::Entry> entry = nt.lookup("/a/b/c/d/e/f/g/h/i/j/k/l/m"); // 14 entries
+  BOOST_CHECK_EQUAL(nt.size(), 14);
+  BOOST_CHECK_EQUAL(nt.getNBuckets(), 32);
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/a/b/c/d/e/f/g"), entry->getParent()->getParent()
+                                                              ->getParent()->getParent()
+                                                              ->getParent()->getParent());
+
+  nt.eraseEntryIfEmpty(entry);
+  BOOST_CHECK_EQUAL(nt.size(), 0);
+  BOOST_CHECK_EQUAL(nt.getNBuckets(), 16);
+}
+
+// both backends hold the same entries after the same random operations
+BOOST_AUTO_TEST_CASE(SameAsChained)
+{
+  NameTree chained(16, NameTree::BACKEND_CHAINED);
+  NameTree openAddressing(16, NameTree::BACKEND_OPEN_ADDRESSING);
+
+  std::vector<Name> names;
+  for (int i = 0; i < 2000; ++i) {
+    names.push_back(Name("/A").appendNumber(i % 7).appendNumber(i % 31).appendNumber(i));
+  }
+
+  for (int round = 0; round < 3; ++round) {
+    for (size_t i = round; i < names.size(); i += 2) {
+      chained.lookup(names[i]);
+      openAddressing.lookup(names[i]);
+    }
+    BOOST_REQUIRE_EQUAL(chained.size(), openAddressing.size());
+
+    for (size_t i = 0; i < names.size(); i += 3) {
+      shared_ptr<name_tree::Entry> c = chained.findExactMatch(names[i]);
+      shared_ptr<name_tree::Entry> oa = openAddressing.findExactMatch(names[i]);
+      BOOST_REQUIRE_EQUAL(static_cast<bool>(c), static_cast<bool>(oa));
+      if (c != nullptr) {
+        chained.eraseEntryIfEmpty(c);
+        openAddressing.eraseEntryIfEmpty(oa);
+      }
+    }
+    BOOST_REQUIRE_EQUAL(chained.size(), openAddressing.size());
+
+    for (const Name& name : names) {
+      shared_ptr<name_tree::Entry> c = chained.findLongestPrefixMatch(name);
+      shared_ptr<name_tree::Entry> oa = openAddressing.findLongestPrefixMatch(name);
+      BOOST_REQUIRE_EQUAL(c->getPrefix(), oa->getPrefix());
+    }
+
+    std::set<Name> enumerated;
+    for (const name_tree::Entry& entry : openAddressing) {
+      BOOST_CHECK(enumerated.insert(entry.getPrefix()).second);
+      BOOST_CHECK(static_cast<bool>(chained.findExactMatch(entry.getPrefix())));
+    }
+    BOOST_CHECK_EQUAL(enumerated.size(), chained.size());
+  }
+}
+
+// .lookup and .eraseEntryIfEmpty should not invalidate iterator
+BOOST_AUTO_TEST_CASE(SurvivedIterator)
+{
+  NameTree nt(16, NameTree::BACKEND_OPEN_ADDRESSING);
+  nt.lookup("/A/B/C");
+  nt.lookup("/A/D/E");
+  nt.lookup("/A/F/G");
+  nt.lookup("/H");
+
+  std::set<Name> seenNames;
+  for (NameTree::const_iterator it = nt.begin(); it != nt.end(); ++it) {
+    BOOST_CHECK(seenNames.insert(it->getPrefix()).second);
+    if (it->getPrefix() == "/A/D") {
+      nt.eraseEntryIfEmpty(nt.findExactMatch("/A/F/G")); // /A/F/G and /A/F are erased
+      nt.lookup("/I/J"); // displaces entries in their slots
+    }
+  }
+
+  BOOST_CHECK_EQUAL(seenNames.count("/"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/B"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/B/C"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/D"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/D/E"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/H"), 1);
+
+  seenNames.erase("/A/F"); // /A/F may or may not appear
+  seenNames.erase("/A/F/G"); // /A/F/G may or may not appear
+  seenNames.erase("/I"); // /I may or may not appear
+  seenNames.erase("/I/J"); // /I/J may or may not appear
+  BOOST_CHECK(seenNames.size() == 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // OpenAddressing
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
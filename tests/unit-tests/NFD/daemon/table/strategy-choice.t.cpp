@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/table/strategy-choice.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "NFD/daemon/fw/best-route-strategy2.hpp"
+#include "NFD/daemon/fw/broadcast-strategy.hpp"
+
+#include "../../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::Forwarder;
+using nfd::StrategyChoice;
+using nfd::fw::BestRouteStrategy2;
+using nfd::fw::BroadcastStrategy;
+
+BOOST_FIXTURE_TEST_SUITE(NfdDaemonTableStrategyChoice, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(EffectivePitEntry)
+{
+  Forwarder forwarder;
+  const Name& nameP = BestRouteStrategy2::STRATEGY_NAME;
+  const Name& nameQ = BroadcastStrategy::STRATEGY_NAME;
+
+  StrategyChoice& table = forwarder.getStrategyChoice();
+  BOOST_REQUIRE(table.hasStrategy(nameP, true));
+  BOOST_REQUIRE(table.hasStrategy(nameQ, true));
+  table.insert("ndn:/", nameP);
+  // { '/'=>P }
+
+  shared_ptr<Interest> interest = make_shared<Interest>(Name("ndn:/A/B/C"));
+  shared_ptr<nfd::pit::Entry> pitEntry = forwarder.getPit().insert(*interest).first;
+
+  uint64_t version = table.getVersion();
+  BOOST_CHECK(pitEntry->getCachedStrategy(version) == nullptr);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameP);
+  BOOST_REQUIRE(pitEntry->getCachedStrategy(version) != nullptr);
+  BOOST_CHECK_EQUAL(pitEntry->getCachedStrategy(version)->getName(), nameP);
+
+  table.insert("ndn:/A", nameP); // effective strategy unchanged
+  // { '/'=>P, '/A'=>P }
+  BOOST_CHECK_EQUAL(table.getVersion(), version);
+
+  table.insert("ndn:/A/B", nameQ);
+  // { '/'=>P, '/A'=>P, '/A/B'=>Q }
+  BOOST_CHECK_NE(table.getVersion(), version);
+  BOOST_CHECK(pitEntry->getCachedStrategy(table.getVersion()) == nullptr);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameQ);
+
+  version = table.getVersion();
+  table.erase("ndn:/A/B");
+  // { '/'=>P, '/A'=>P }
+  BOOST_CHECK_NE(table.getVersion(), version);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameP);
+
+  // versions are not shared between tables
+  Forwarder forwarder2;
+  BOOST_CHECK_NE(forwarder2.getStrategyChoice().getVersion(), table.getVersion());
+  BOOST_CHECK(pitEntry->getCachedStrategy(forwarder2.getStrategyChoice().getVersion()) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
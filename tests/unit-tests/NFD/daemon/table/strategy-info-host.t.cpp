@@ -0,0 +1,270 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/table/strategy-info-host.hpp"
+#include "NFD/daemon/fw/strategy-info.hpp"
+
+#include "../../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::StrategyInfoHost;
+using nfd::fw::StrategyInfo;
+
+/** \brief StrategyInfo that counts live instances
+ *  \tparam N distinguishes types, so that each N gets its own slot
+ */
+template<int N>
+class CountedStrategyInfo : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1000 + N;
+  }
+
+  explicit
+  CountedStrategyInfo(int id = 0)
+    : m_id(id)
+  {
+    ++s_nInstances;
+  }
+
+  virtual
+  ~CountedStrategyInfo()
+  {
+    --s_nInstances;
+  }
+
+public:
+  int m_id;
+  static int s_nInstances;
+};
+
+template<int N>
+int CountedStrategyInfo<N>::s_nInstances = 0;
+
+// StrategyInfoHost::N_INLINE_SLOTS
+static const int N_INLINE_SLOTS = 2;
+
+typedef CountedStrategyInfo<0> InlineInfo0;
+typedef CountedStrategyInfo<1> InlineInfo1;
+
+// Slots are numbered on first use in the process. Using these types during static
+// initialization, before any strategy runs, gives them the inline slots, so that the cases
+// below know which StrategyInfo types are kept inline and which are kept in m_moreSlots.
+static const bool g_areInlineSlotsTaken =
+  StrategyInfoHost().getStrategyInfo<InlineInfo0>() == nullptr &&
+  StrategyInfoHost().getStrategyInfo<InlineInfo1>() == nullptr;
+
+template<int N>
+using MoreInfo = CountedStrategyInfo<N_INLINE_SLOTS + N>;
+
+BOOST_FIXTURE_TEST_SUITE(NfdDaemonTableStrategyInfoHost, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(SetGetClear)
+{
+  BOOST_REQUIRE(g_areInlineSlotsTaken);
+  StrategyInfoHost host;
+
+  BOOST_CHECK(host.getStrategyInfo<InlineInfo0>() == nullptr);
+
+  shared_ptr<InlineInfo0> info = make_shared<InlineInfo0>(7591);
+  host.setStrategyInfo(info);
+  BOOST_REQUIRE(host.getStrategyInfo<InlineInfo0>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo0>()->m_id, 7591);
+
+  info.reset(); // unlink local reference
+  // host should still have a reference to info
+  BOOST_REQUIRE(host.getStrategyInfo<InlineInfo0>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo0>()->m_id, 7591);
+
+  host.clearStrategyInfo();
+  BOOST_CHECK(host.getStrategyInfo<InlineInfo0>() == nullptr);
+  BOOST_CHECK_EQUAL(InlineInfo0::s_nInstances, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Create)
+{
+  StrategyInfoHost host;
+
+  host.getOrCreateStrategyInfo<InlineInfo0>(3503);
+  BOOST_REQUIRE(host.getStrategyInfo<InlineInfo0>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo0>()->m_id, 3503);
+
+  host.getOrCreateStrategyInfo<InlineInfo0>(1032);
+  BOOST_REQUIRE(host.getStrategyInfo<InlineInfo0>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo0>()->m_id, 3503);
+
+  host.setStrategyInfo<InlineInfo0>(nullptr);
+  host.getOrCreateStrategyInfo<InlineInfo0>(9956);
+  BOOST_REQUIRE(host.getStrategyInfo<InlineInfo0>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo0>()->m_id, 9956);
+}
+
+BOOST_AUTO_TEST_CASE(Types)
+{
+  StrategyInfoHost host;
+
+  host.getOrCreateStrategyInfo<InlineInfo0>(8063);
+  BOOST_REQUIRE(host.getStrategyInfo<InlineInfo0>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo0>()->m_id, 8063);
+
+  host.getOrCreateStrategyInfo<InlineInfo1>(2871);
+  BOOST_REQUIRE(host.getStrategyInfo<InlineInfo1>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo1>()->m_id, 2871);
+
+  BOOST_REQUIRE(host.getStrategyInfo<InlineInfo0>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo0>()->m_id, 8063);
+}
+
+BOOST_AUTO_TEST_CASE(ClearInlineSlot)
+{
+  BOOST_REQUIRE(g_areInlineSlotsTaken);
+  StrategyInfoHost host;
+
+  host.getOrCreateStrategyInfo<InlineInfo0>(1);
+  host.getOrCreateStrategyInfo<InlineInfo1>(2);
+  BOOST_CHECK_EQUAL(InlineInfo0::s_nInstances, 1);
+  BOOST_CHECK_EQUAL(InlineInfo1::s_nInstances, 1);
+
+  // setting nullptr into an inline slot releases its item and leaves the other slot alone
+  host.setStrategyInfo<InlineInfo0>(nullptr);
+  BOOST_CHECK(host.getStrategyInfo<InlineInfo0>() == nullptr);
+  BOOST_CHECK_EQUAL(InlineInfo0::s_nInstances, 0);
+  BOOST_REQUIRE(host.getStrategyInfo<InlineInfo1>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo1>()->m_id, 2);
+
+  // clearing an empty inline slot is a no-op
+  host.setStrategyInfo<InlineInfo0>(nullptr);
+  BOOST_CHECK(host.getStrategyInfo<InlineInfo0>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<InlineInfo1>() != nullptr);
+
+  host.getOrCreateStrategyInfo<InlineInfo0>(3);
+  BOOST_REQUIRE(host.getStrategyInfo<InlineInfo0>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo0>()->m_id, 3);
+}
+
+BOOST_AUTO_TEST_CASE(MoreSlots)
+{
+  BOOST_REQUIRE(g_areInlineSlotsTaken);
+
+  // first use in this order gives MoreInfo<0> the lowest slot of the four,
+  // all of them at or above N_INLINE_SLOTS
+  StrategyInfoHost host;
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<0>>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<1>>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<2>>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<3>>() == nullptr);
+
+  // nullptr beyond m_moreSlots does not resize
+  host.setStrategyInfo<MoreInfo<3>>(nullptr);
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<3>>() == nullptr);
+
+  // m_moreSlots grows to the lowest slot, then to the highest one
+  host.getOrCreateStrategyInfo<MoreInfo<0>>(10);
+  host.getOrCreateStrategyInfo<MoreInfo<3>>(13);
+  // and a slot between them does not resize again
+  host.getOrCreateStrategyInfo<MoreInfo<1>>(11);
+  BOOST_REQUIRE(host.getStrategyInfo<MoreInfo<0>>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<MoreInfo<0>>()->m_id, 10);
+  BOOST_REQUIRE(host.getStrategyInfo<MoreInfo<1>>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<MoreInfo<1>>()->m_id, 11);
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<2>>() == nullptr);
+  BOOST_REQUIRE(host.getStrategyInfo<MoreInfo<3>>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<MoreInfo<3>>()->m_id, 13);
+
+  // inline slots are independent of m_moreSlots
+  BOOST_CHECK(host.getStrategyInfo<InlineInfo0>() == nullptr);
+  host.getOrCreateStrategyInfo<InlineInfo0>(20);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo0>()->m_id, 20);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<MoreInfo<0>>()->m_id, 10);
+
+  // setting nullptr into m_moreSlots releases only that item
+  host.setStrategyInfo<MoreInfo<3>>(nullptr);
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<3>>() == nullptr);
+  BOOST_CHECK_EQUAL(MoreInfo<3>::s_nInstances, 0);
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<1>>() != nullptr);
+
+  // items are per host
+  StrategyInfoHost host2;
+  BOOST_CHECK(host2.getStrategyInfo<MoreInfo<0>>() == nullptr);
+  BOOST_CHECK(host2.getStrategyInfo<MoreInfo<1>>() == nullptr);
+  host2.getOrCreateStrategyInfo<MoreInfo<1>>(31);
+  BOOST_CHECK_EQUAL(host2.getStrategyInfo<MoreInfo<1>>()->m_id, 31);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<MoreInfo<1>>()->m_id, 11);
+}
+
+BOOST_AUTO_TEST_CASE(ClearAllSlots)
+{
+  BOOST_REQUIRE(g_areInlineSlotsTaken);
+  StrategyInfoHost host;
+
+  host.getOrCreateStrategyInfo<InlineInfo0>();
+  host.getOrCreateStrategyInfo<InlineInfo1>();
+  host.getOrCreateStrategyInfo<MoreInfo<0>>();
+  host.getOrCreateStrategyInfo<MoreInfo<3>>();
+  BOOST_CHECK_EQUAL(InlineInfo0::s_nInstances, 1);
+  BOOST_CHECK_EQUAL(InlineInfo1::s_nInstances, 1);
+  BOOST_CHECK_EQUAL(MoreInfo<0>::s_nInstances, 1);
+  BOOST_CHECK_EQUAL(MoreInfo<3>::s_nInstances, 1);
+
+  host.clearStrategyInfo();
+  BOOST_CHECK(host.getStrategyInfo<InlineInfo0>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<InlineInfo1>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<0>>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<3>>() == nullptr);
+  BOOST_CHECK_EQUAL(InlineInfo0::s_nInstances, 0);
+  BOOST_CHECK_EQUAL(InlineInfo1::s_nInstances, 0);
+  BOOST_CHECK_EQUAL(MoreInfo<0>::s_nInstances, 0);
+  BOOST_CHECK_EQUAL(MoreInfo<3>::s_nInstances, 0);
+
+  // the host is usable after clearing, and m_moreSlots grows again
+  host.getOrCreateStrategyInfo<MoreInfo<3>>(43);
+  BOOST_REQUIRE(host.getStrategyInfo<MoreInfo<3>>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<MoreInfo<3>>()->m_id, 43);
+  BOOST_CHECK(host.getStrategyInfo<MoreInfo<0>>() == nullptr);
+
+  // clearing an empty host is a no-op
+  StrategyInfoHost host2;
+  host2.clearStrategyInfo();
+  BOOST_CHECK(host2.getStrategyInfo<InlineInfo0>() == nullptr);
+  BOOST_CHECK(host2.getStrategyInfo<MoreInfo<3>>() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ReuseStorage)
+{
+  StrategyInfoHost host;
+
+  InlineInfo0* info = host.getOrCreateStrategyInfo<InlineInfo0>(2231).get();
+  host.clearStrategyInfo();
+  BOOST_CHECK_EQUAL(InlineInfo0::s_nInstances, 0);
+
+  // freed storage is taken again by the next item of the same type
+  BOOST_CHECK_EQUAL(host.getOrCreateStrategyInfo<InlineInfo0>(4719).get(), info);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<InlineInfo0>()->m_id, 4719);
+  BOOST_CHECK_EQUAL(InlineInfo0::s_nInstances, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/rib/fib-updater.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include <ndn-cxx/face.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::rib::FibUpdate;
+using nfd::rib::RibUpdate;
+using nfd::rib::Route;
+
+/** \brief FibUpdater that applies updates to a map instead of sending commands
+ */
+class InProcessFibUpdatesFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  InProcessFibUpdatesFixture()
+    : nFailures(0)
+  {
+    faces = {1, 2, 3};
+
+    // ndn::Face, needed by the controller, can only be created on a node
+    createTopology({
+        {"1"},
+      });
+    FactoryCallbackApp::Install(getNode("1"), [this] () -> shared_ptr<void> {
+        face = make_shared< ::ndn::Face>();
+        controller = make_shared< ::ndn::nfd::Controller>(*face, StackHelper::getKeyChain());
+        fibUpdater = make_shared<nfd::rib::FibUpdater>(rib, *controller);
+        fibUpdater->setFibUpdateApplier([this] (const FibUpdate& update) {
+            return this->apply(update);
+          });
+        return nullptr;
+      })
+      .Start(Seconds(0.01));
+
+    Simulator::Stop(Seconds(0.1));
+    Simulator::Run();
+  }
+
+  uint32_t
+  apply(const FibUpdate& update)
+  {
+    if (faces.count(update.faceId) == 0) {
+      return update.action == FibUpdate::ADD_NEXTHOP ? 410 : 200;
+    }
+
+    if (update.action == FibUpdate::ADD_NEXTHOP) {
+      fib[update.name][update.faceId] = update.cost;
+    }
+    else {
+      fib[update.name].erase(update.faceId);
+      if (fib[update.name].empty()) {
+        fib.erase(update.name);
+      }
+    }
+    return 200;
+  }
+
+  void
+  registerRoute(const Name& name, uint64_t faceId, uint64_t cost, uint64_t flags)
+  {
+    Route route;
+    route.faceId = faceId;
+    route.origin = 0;
+    route.cost = cost;
+    route.flags = flags;
+
+    RibUpdate update;
+    update.setAction(RibUpdate::REGISTER)
+          .setName(name)
+          .setRoute(route);
+
+    rib.beginApplyUpdate(update, nullptr, [this] (uint32_t, const std::string&) { nFailures++; });
+  }
+
+public:
+  nfd::rib::Rib rib;
+  shared_ptr< ::ndn::Face> face;
+  shared_ptr< ::ndn::nfd::Controller> controller;
+  shared_ptr<nfd::rib::FibUpdater> fibUpdater;
+
+  std::set<uint64_t> faces;
+  std::map<Name, std::map<uint64_t, uint64_t>> fib; // prefix => face => cost
+  int nFailures;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdRibFibUpdatesInProcess, InProcessFibUpdatesFixture)
+
+BOOST_AUTO_TEST_CASE(InheritedRoutes)
+{
+  BOOST_REQUIRE(fibUpdater != nullptr);
+
+  // applied before returning, without running the simulator
+  registerRoute("/a", 1, 10, ::ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  registerRoute("/a/b", 2, 20, 0);
+  registerRoute("/a/c", 3, 30, 0);
+
+  BOOST_CHECK_EQUAL(rib.size(), 3);
+  BOOST_REQUIRE_EQUAL(fib.size(), 3);
+  BOOST_CHECK_EQUAL(fib["/a"].size(), 1);
+  BOOST_CHECK_EQUAL(fib["/a/b"][1], 10);
+  BOOST_CHECK_EQUAL(fib["/a/b"][2], 20);
+  BOOST_CHECK_EQUAL(fib["/a/c"][1], 10);
+
+  rib.beginRemoveFace(1);
+
+  BOOST_CHECK(rib.find("/a") == rib.end());
+  BOOST_REQUIRE_EQUAL(fib.size(), 2);
+  BOOST_CHECK_EQUAL(fib["/a/b"].size(), 1);
+  BOOST_CHECK_EQUAL(fib["/a/c"].size(), 1);
+  BOOST_CHECK_EQUAL(nFailures, 0);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveFaceWithManyRoutes)
+{
+  BOOST_REQUIRE(fibUpdater != nullptr);
+
+  for (int i = 0; i < 5000; i++) {
+    registerRoute(Name("/many").appendNumber(i), 2, 1, 0);
+  }
+  BOOST_CHECK_EQUAL(fib.size(), 5000);
+
+  // one batch per route, all applied without recursing per batch
+  rib.beginRemoveFace(2);
+  BOOST_CHECK_EQUAL(rib.size(), 0);
+  BOOST_CHECK_EQUAL(fib.size(), 0);
+
+  // nothing is left queued
+  registerRoute("/after", 3, 1, 0);
+  BOOST_CHECK_EQUAL(fib.count("/after"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(FaceNotFound)
+{
+  BOOST_REQUIRE(fibUpdater != nullptr);
+
+  registerRoute("/a", 1, 10, ::ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  registerRoute("/a/b", 9, 20, 0);
+
+  BOOST_CHECK_EQUAL(nFailures, 1);
+  BOOST_CHECK(rib.find("/a/b") == rib.end());
+  BOOST_CHECK_EQUAL(fib.count("/a/b"), 0);
+
+  // the queue moves on after the failure
+  registerRoute("/a/c", 3, 30, 0);
+  BOOST_CHECK_EQUAL(fib["/a/c"].size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+class RibManagerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  RibManagerFixture()
+    : isRegistered(false)
+    , hasFibEntryOnSuccess(false)
+  {
+  }
+
+  nfd::Forwarder&
+  getForwarder()
+  {
+    return *getNode("1")->GetObject<L3Protocol>()->getForwarder();
+  }
+
+public:
+  bool isRegistered;
+  bool hasFibEntryOnSuccess;
+};
+
+BOOST_FIXTURE_TEST_CASE(RegisterThroughL3Protocol, RibManagerFixture)
+{
+  createTopology({
+      {"1"},
+    });
+
+  FactoryCallbackApp::Install(getNode("1"), [this] () -> shared_ptr<void> {
+      auto face = make_shared< ::ndn::Face>();
+      face->registerPrefix("/test",
+        [this] (const Name&) {
+          isRegistered = true;
+          hasFibEntryOnSuccess = getForwarder().getFib().findExactMatch("/test") != nullptr;
+        },
+        [] (const Name&, const std::string& reason) {
+          BOOST_ERROR("registration failed: " << reason);
+        });
+      return face;
+    })
+    .Start(Seconds(0.5));
+
+  // RIB manager is running and has registered its own prefix by now
+  Simulator::Stop(Seconds(0.4));
+  Simulator::Run();
+  shared_ptr<nfd::Face> internalFace = getForwarder().getFace(nfd::FACEID_INTERNAL_FACE);
+  BOOST_REQUIRE(internalFace != nullptr);
+  uint64_t nCommands = internalFace->getCounters().getNOutInterests();
+
+  Simulator::Stop(Seconds(0.6));
+  Simulator::Run();
+
+  // the route reached the FIB while the RIB handled the command, with no fib/add-nexthop
+  BOOST_CHECK(isRegistered);
+  BOOST_CHECK(hasFibEntryOnSuccess);
+  shared_ptr<nfd::fib::Entry> entry = getForwarder().getFib().findExactMatch("/test");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(internalFace->getCounters().getNOutInterests(), nCommands);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -97,6 +97,14 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// static void
+// AddRoutesBulk(Ptr<Node> node, const std::vector<Route>& routes);
+BOOST_AUTO_TEST_CASE(Bulk)
+{
+  FibHelper::AddRoutesBulk(getNode("1"), {{Name("/other"), getFace("1", "2"), 5},
+                                          {Name("/prefix"), getFace("1", "2"), 1}});
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
@@ -37,6 +37,8 @@
 
 #include <boost/filesystem.hpp>
 
+#include <tuple>
+
 namespace ns3 {
 namespace ndn {
 
@@ -146,6 +148,60 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+// next hops as (node, prefix, face, cost), sorted
+static std::vector<std::tuple<uint32_t, Name, nfd::FaceId, uint64_t>>
+collectRoutes()
+{
+  std::vector<std::tuple<uint32_t, Name, nfd::FaceId, uint64_t>> routes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    auto ndn = (*node)->GetObject<ndn::L3Protocol>();
+    for (const auto& entry : ndn->getForwarder()->getFib()) {
+      for (const auto& nextHop : entry.getNextHops()) {
+        routes.push_back(std::make_tuple((*node)->GetId(), entry.getPrefix(),
+                                         nextHop.getFace()->getId(), nextHop.getCost()));
+      }
+    }
+  }
+  std::sort(routes.begin(), routes.end());
+  return routes;
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRoutesParallel)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(4, 4, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/corner", grid.GetNode(0, 0));
+  ndnGlobalRoutingHelper.AddOrigins("/corner", grid.GetNode(3, 3));
+  ndnGlobalRoutingHelper.AddOrigins("/center", grid.GetNode(1, 2));
+
+  auto baseRoutes = collectRoutes();
+
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  auto serialRoutes = collectRoutes();
+  BOOST_CHECK_GT(serialRoutes.size(), baseRoutes.size());
+
+  // start again from FIBs without the calculated routes
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nfd::Fib& fib = (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+    fib.erase(Name("/corner"));
+    fib.erase(Name("/center"));
+  }
+  BOOST_REQUIRE(collectRoutes() == baseRoutes);
+
+  BOOST_CHECK_NO_THROW(ndn::GlobalRoutingHelper::CalculateRoutesParallel(3));
+  auto parallelRoutes = collectRoutes();
+
+  BOOST_CHECK_EQUAL(parallelRoutes.size(), serialRoutes.size());
+  BOOST_CHECK(serialRoutes == parallelRoutes);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
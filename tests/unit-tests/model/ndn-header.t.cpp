@@ -24,6 +24,8 @@
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 
+#include <chrono>
+
 #include "../tests-common.hpp"
 
 namespace ns3 {
@@ -47,6 +49,48 @@ BOOST_AUTO_TEST_CASE(TypeId)
  BOOST_CHECK_EQUAL(dataPktHeader.GetSerializedSize(), 1354); // 328 + 1024
 }
 
+template<class Pkt>
+static double
+measureDecodeTime(const Pkt& pkt, size_t nRepeats)
+{
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(PacketHeader<Pkt>(pkt));
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < nRepeats; ++i) {
+    PacketHeader<Pkt> header;
+    packet->PeekHeader(header);
+    BOOST_REQUIRE(header.getPacket() != nullptr);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  PacketHeader<Pkt> header;
+  packet->PeekHeader(header);
+  BOOST_CHECK(header.getPacket()->wireEncode() == pkt.wireEncode());
+
+  return std::chrono::duration<double, std::nano>(end - start).count() / nRepeats;
+}
+
+BOOST_AUTO_TEST_CASE(DecodeBenchmark)
+{
+  const size_t N_REPEATS = 100000;
+
+  Name name("/prefix");
+  while (name.wireEncode().size() < 80) {
+    name.appendNumber(name.size());
+  }
+  auto interest = make_shared<ndn::Interest>(name);
+  interest->setNonce(1);
+  BOOST_TEST_MESSAGE("Interest decode (" << interest->wireEncode().size() << " bytes): "
+                     << measureDecodeTime(*interest, N_REPEATS) << " ns/packet");
+
+  auto data = make_shared<ndn::Data>(name);
+  data->setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(*data);
+  BOOST_TEST_MESSAGE("Data decode (" << data->wireEncode().size() << " bytes): "
+                     << measureDecodeTime(*data, N_REPEATS) << " ns/packet");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
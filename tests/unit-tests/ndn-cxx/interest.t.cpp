@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/interest.hpp>
+
+#include "ns3/ndnSIM/helper/ndn-app-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-strategy-choice-helper.hpp"
+#include "ns3/ndnSIM/apps/ndn-app.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxInterest, ScenarioHelperWithCleanupFixture)
+
+BOOST_AUTO_TEST_CASE(FlagsPatchedInPlace)
+{
+  Interest original("/prefix/1");
+  original.setNonce(1);
+  original.setFloodFlag(3);
+  original.setDestinationFlag(0);
+
+  // as received by the next hop
+  Interest interest(original.wireEncode());
+  const uint8_t* buffer = interest.wireEncode().wire();
+  uint64_t nEncodes = Interest::getWireEncodeCount();
+
+  for (uint32_t hop = 1; hop <= 10; ++hop) {
+    interest.setFloodFlag(hop * 100000);
+    interest.setDestinationFlag(hop % 2);
+    const Block& wire = interest.wireEncode();
+    BOOST_CHECK(wire.wire() == buffer);
+
+    Interest decoded(wire);
+    BOOST_CHECK_EQUAL(decoded.getFloodFlag(), hop * 100000);
+    BOOST_CHECK_EQUAL(decoded.getDestinationFlag(), hop % 2);
+    BOOST_CHECK_EQUAL(decoded.getName(), Name("/prefix/1"));
+  }
+  BOOST_CHECK_EQUAL(Interest::getWireEncodeCount(), nEncodes);
+
+  // changing anything else still re-encodes
+  interest.setInterestLifetime(time::seconds(1));
+  BOOST_CHECK(interest.wireEncode().wire() != buffer);
+  BOOST_CHECK_EQUAL(Interest::getWireEncodeCount(), nEncodes + 1);
+  BOOST_CHECK_EQUAL(Interest(interest.wireEncode()).getFloodFlag(), 1000000);
+}
+
+BOOST_AUTO_TEST_CASE(FlagsOfCopy)
+{
+  Interest original("/prefix/1");
+  original.setNonce(1);
+  original.setDestinationFlag(0);
+  original.setFloodFlag(3);
+  original.wireEncode();
+
+  // a copy shares the wire buffer, so patching it changes the original's bytes too
+  Interest copy(original);
+  copy.setDestinationFlag(1);
+  copy.setFloodFlag(4);
+
+  original.setDestinationFlag(0);
+  original.setFloodFlag(3);
+  Interest decoded(original.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.getDestinationFlag(), 0);
+  BOOST_CHECK_EQUAL(decoded.getFloodFlag(), 3);
+}
+
+class FlagsOnPathFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  void
+  onInterestAtProducer(shared_ptr<const Interest> interest, Ptr<App>, shared_ptr<Face>)
+  {
+    floodFlags.push_back(interest->getFloodFlag());
+    destinationFlags.push_back(interest->getDestinationFlag());
+  }
+
+public:
+  std::vector<uint32_t> floodFlags;
+  std::vector<uint32_t> destinationFlags;
+};
+
+BOOST_FIXTURE_TEST_CASE(FlagsPatchedOnPath, FlagsOnPathFixture)
+{
+  createTopology({
+      {"A", "B"},
+      {"B", "C"},
+      {"C", "D"}
+    });
+
+  addRoutes({
+      {"A", "B", "/prefix", 1},
+      {"B", "C", "/prefix", 1},
+      {"C", "D", "/prefix", 1}
+    });
+
+  // the multicast strategy decrements the Flood Flag at every hop that forwards on the FIB
+  for (const char* node : {"A", "B", "C"}) {
+    StrategyChoiceHelper::Install(getNode(node), "/prefix", "/localhost/nfd/strategy/multicast");
+  }
+
+  addApps({
+      {"A", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "0.95s"},
+      {"D", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+  getNode("D")->GetApplication(0)->TraceConnectWithoutContext("ReceivedInterests",
+    MakeCallback(&FlagsOnPathFixture::onInterestAtProducer, this));
+
+  uint64_t nEncodes = Interest::getWireEncodeCount();
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("C", "D")->getFaceStatus().getNOutInterests(), 10);
+
+  // A, B and C patch the flags of the Interests they forward
+  BOOST_REQUIRE_EQUAL(floodFlags.size(), 10);
+  for (size_t i = 0; i < floodFlags.size(); ++i) {
+    BOOST_CHECK_EQUAL(floodFlags[i], 1000 - 3);
+    BOOST_CHECK_EQUAL(destinationFlags[i], 0);
+  }
+
+  // each Interest is encoded once, when A first sends it, and never again on B, C or D
+  BOOST_CHECK_LE(Interest::getWireEncodeCount() - nEncodes, 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
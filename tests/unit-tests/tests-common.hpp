@@ -23,6 +23,7 @@
 #include "ns3/core-module.h"
 #include "model/ndn-global-router.hpp"
 #include "helper/ndn-scenario-helper.hpp"
+#include "utils/ndn-time.hpp"
 
 #include "boost-test.hpp"
 
@@ -40,6 +41,30 @@ public:
   }
 };
 
+/** \brief lets ndn-cxx clocks follow the simulator, and advances the simulator
+ *
+ *  NFD tables and timers read time::steady_clock and schedule on the ns-3 simulator,
+ *  so tests of those drive time by running the simulator.
+ */
+class SimulatorTimeFixture : public CleanupFixture
+{
+public:
+  SimulatorTimeFixture()
+  {
+    ::ndn::time::setCustomClocks(make_shared<time::CustomSteadyClock>(),
+                                 make_shared<time::CustomSystemClock>());
+  }
+
+  /** \brief runs the simulator for delay, firing every event due until then
+   */
+  void
+  advanceClocks(const time::nanoseconds& delay)
+  {
+    Simulator::Stop(NanoSeconds(delay.count()));
+    Simulator::Run();
+  }
+};
+
 class ScenarioHelperWithCleanupFixture : public ScenarioHelper, public CleanupFixture
 {
 public:
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-data-template.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsDataTemplate, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(SameEncoding)
+{
+  std::vector<Name> names = {Name("/"), Name("/prefix"),
+                             Name("/sit").appendNumber(3).appendSequenceNumber(1000)};
+  for (uint32_t payloadSize : {0, 1024, 70000}) {
+    for (Time freshness : {Seconds(0), Seconds(2)}) {
+      for (const Name& keyLocator : {Name(), Name("/key")}) {
+        DataTemplate dataTemplate(payloadSize, freshness, 7, keyLocator);
+        for (const Name& name : names) {
+          shared_ptr<Data> expected = DataTemplate::Encode(name, payloadSize, freshness, 7,
+                                                           keyLocator);
+          shared_ptr<Data> data = dataTemplate.Make(name);
+
+          const Block& wire = data->wireEncode();
+          const Block& expectedWire = expected->wireEncode();
+          BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(),
+                                        expectedWire.begin(), expectedWire.end());
+          BOOST_CHECK_EQUAL(data->getName(), name);
+          BOOST_CHECK_EQUAL(data->getContent().value_size(), payloadSize);
+          BOOST_CHECK_EQUAL(data->getFreshnessPeriod(),
+                            ::ndn::time::milliseconds(freshness.GetMilliSeconds()));
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Shared)
+{
+  auto dataTemplate = DataTemplate::Get(1024, Seconds(1), 0, Name());
+  BOOST_CHECK_EQUAL(DataTemplate::Get(1024, Seconds(1), 0, Name()), dataTemplate);
+  BOOST_CHECK_NE(DataTemplate::Get(1024, Seconds(1), 0, Name("/key")), dataTemplate);
+  BOOST_CHECK_NE(DataTemplate::Get(100, Seconds(1), 0, Name()), dataTemplate);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
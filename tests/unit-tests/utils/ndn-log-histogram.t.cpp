@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-log-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsLogHistogram, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(SmallValuesExact)
+{
+  LogHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(50), 0);
+
+  for (uint64_t value = 1; value <= 100; value++) {
+    histogram.Record(value);
+  }
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 100);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), 1);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 100);
+  BOOST_CHECK_CLOSE(histogram.GetMean(), 50.5, 0.001);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(0), 1);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(50), 50);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(99), 99);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(100), 100);
+
+  histogram.Reset();
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+  histogram.Record(7);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(50), 7);
+}
+
+BOOST_AUTO_TEST_CASE(PercentilesMatchSorted)
+{
+  std::mt19937_64 rng(42);
+  std::lognormal_distribution<double> delay(16, 1.5); // around 10 ms in nanoseconds
+
+  LogHistogram histogram;
+  std::vector<uint64_t> values;
+  for (int i = 0; i < 10000; i++) {
+    uint64_t value = static_cast<uint64_t>(delay(rng));
+    histogram.Record(value);
+    values.push_back(value);
+  }
+  std::sort(values.begin(), values.end());
+
+  for (double percentile : {1.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+    uint64_t exact = values[static_cast<size_t>(std::ceil(percentile / 100 * values.size())) - 1];
+    BOOST_CHECK_CLOSE(static_cast<double>(histogram.GetPercentile(percentile)),
+                      static_cast<double>(exact), 100.0 / 256);
+  }
+  BOOST_CHECK_EQUAL(histogram.GetMax(), values.back());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
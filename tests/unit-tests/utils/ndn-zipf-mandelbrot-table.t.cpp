@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-zipf-mandelbrot-table.hpp"
+
+#include <cmath>
+#include <random>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsZipfMandelbrotTable, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(BinarySearchMatchesLinearScan)
+{
+  const uint32_t N = 1000;
+  auto table = ZipfMandelbrotTable::Get(N, 0.7, 0.7);
+
+  std::vector<double> pcum(N + 1, 0.0);
+  for (uint32_t i = 1; i <= N; i++) {
+    pcum[i] = pcum[i - 1] + 1.0 / std::pow(i + 0.7, 0.7);
+  }
+  for (uint32_t i = 1; i <= N; i++) {
+    pcum[i] = pcum[i] / pcum[N];
+  }
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  for (int n = 0; n < 10000; n++) {
+    double u = uniform(rng);
+    if (n == 0)
+      u = 1.0;
+
+    uint32_t expected = 1;
+    for (uint32_t i = 1; i <= N; i++) {
+      if (u <= pcum[i]) {
+        expected = i;
+        break;
+      }
+    }
+    BOOST_REQUIRE_EQUAL(table->Sample(u), expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AliasDistribution)
+{
+  const uint32_t N = 100;
+  const uint32_t STEPS = 10000; // per column
+  auto table = ZipfMandelbrotTable::Get(N, 0.7, 0.7, ZipfMandelbrotTable::ALIAS);
+
+  // evenly spaced random numbers hit each content proportionally to its probability
+  std::vector<uint32_t> counts(N + 1, 0);
+  for (uint32_t j = 0; j < N * STEPS; j++) {
+    uint32_t k = table->Sample((j + 0.5) / (N * STEPS));
+    BOOST_REQUIRE(k >= 1 && k <= N);
+    counts[k]++;
+  }
+  BOOST_CHECK(table->Sample(1.0) >= 1 && table->Sample(1.0) <= N);
+
+  double sum = 0.0;
+  for (uint32_t k = 1; k <= N; k++) {
+    sum += 1.0 / std::pow(k + 0.7, 0.7);
+  }
+  for (uint32_t k = 1; k <= N; k++) {
+    double p = 1.0 / std::pow(k + 0.7, 0.7) / sum;
+    // each of the N columns can be off by one step
+    BOOST_CHECK_SMALL(1.0 * counts[k] / (N * STEPS) - p, 1.0 / STEPS);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Sharing)
+{
+  auto table1 = ZipfMandelbrotTable::Get(100, 0.7, 0.7);
+  auto table2 = ZipfMandelbrotTable::Get(100, 0.7, 0.7);
+  auto table3 = ZipfMandelbrotTable::Get(100, 0.7, 0.8);
+  auto table4 = ZipfMandelbrotTable::Get(100, 0.7, 0.7, ZipfMandelbrotTable::ALIAS);
+
+  BOOST_CHECK(table1 == table2);
+  BOOST_CHECK(table1 != table3);
+  BOOST_CHECK(table1 != table4);
+  BOOST_CHECK_EQUAL(table4->GetMethod(), ZipfMandelbrotTable::ALIAS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -22,6 +22,11 @@
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+
 #include "../../tests-common.hpp"
 
 namespace ns3 {
@@ -157,6 +162,79 @@ BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
     "3.02087	2	0	1	FullDelay	0.0208712	20871.2	1	1\n"));
 }
 
+BOOST_AUTO_TEST_CASE(AggregatedMatchesLines)
+{
+  // node 1 retrieves some of the Data from the cache of node 2 and the rest from node 3
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix/other"}, {"Frequency", "20"}, {"Randomize", "uniform"}},
+          "1s", "3s"},
+      {"2", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix/other"}, {"Frequency", "50"}, {"Randomize", "uniform"}},
+          "1s", "3s"}
+    });
+
+  auto lines = make_shared<std::stringstream>();
+  auto aggregates = make_shared<std::stringstream>();
+  Ptr<AppDelayTracer> lineTracer = AppDelayTracer::Install(getNode("1"), lines);
+  Ptr<AppDelayTracer> aggregateTracer =
+    AppDelayTracer::Install(getNode("1"), aggregates, AppDelayTracer::AGGREGATE_NODE, Seconds(10));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  Simulator::Destroy(); // writes the aggregates of the partial period
+  lineTracer = nullptr;
+  aggregateTracer = nullptr;
+
+  std::vector<double> fullDelays;
+  std::vector<double> hopCounts;
+  std::string time, node, appId, seqNo, type;
+  double delayS, delayUs, retxCount, hopCount;
+  while (*lines >> time >> node >> appId >> seqNo >> type >> delayS >> delayUs >> retxCount
+                >> hopCount) {
+    if (type == "FullDelay") {
+      fullDelays.push_back(delayUs);
+      hopCounts.push_back(hopCount);
+    }
+  }
+  BOOST_REQUIRE_GT(fullDelays.size(), 10);
+  std::sort(fullDelays.begin(), fullDelays.end());
+  std::sort(hopCounts.begin(), hopCounts.end());
+
+  auto percentile = [] (const std::vector<double>& values, double p) {
+    size_t rank = std::max<size_t>(1, static_cast<size_t>(std::ceil(p / 100 * values.size())));
+    return values[rank - 1];
+  };
+
+  std::map<std::string, std::vector<double>> rows;
+  std::string line;
+  while (std::getline(*aggregates, line)) {
+    std::istringstream is(line);
+    std::string group;
+    is >> time >> node >> group >> type;
+    BOOST_CHECK_EQUAL(time, "4");
+    BOOST_CHECK_EQUAL(group, "all");
+    double value;
+    while (is >> value) {
+      rows[type].push_back(value);
+    }
+  }
+
+  // Count Mean Min P50 P90 P99 Max
+  BOOST_REQUIRE_EQUAL(rows["FullDelayUS"].size(), 7);
+  BOOST_CHECK_EQUAL(rows["FullDelayUS"][0], fullDelays.size());
+  BOOST_CHECK_CLOSE(rows["FullDelayUS"][2], fullDelays.front(), 0.01);
+  BOOST_CHECK_CLOSE(rows["FullDelayUS"][3], percentile(fullDelays, 50), 0.5);
+  BOOST_CHECK_CLOSE(rows["FullDelayUS"][4], percentile(fullDelays, 90), 0.5);
+  BOOST_CHECK_CLOSE(rows["FullDelayUS"][5], percentile(fullDelays, 99), 0.5);
+  BOOST_CHECK_CLOSE(rows["FullDelayUS"][6], fullDelays.back(), 0.01);
+
+  BOOST_REQUIRE_EQUAL(rows["HopCount"].size(), 7);
+  BOOST_CHECK_EQUAL(rows["HopCount"][3], percentile(hopCounts, 50));
+  BOOST_CHECK_EQUAL(rows["HopCount"][6], hopCounts.back());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
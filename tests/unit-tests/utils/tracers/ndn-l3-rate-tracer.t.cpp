@@ -0,0 +1,373 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "utils/ndn-data-template.hpp"
+#include "daemon/table/pit-entry.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TSV_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) /
+                                               "rate-trace.txt";
+const boost::filesystem::path TEST_BINARY_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) /
+                                                  "rate-trace.bin";
+
+// Printed by the L3RateTracer that kept its counters in a map keyed by Face, before the
+// binary format, for TracedSequenceFixture::traceSequence()
+const std::string BASELINE_TSV =
+  "Time\tNode\tFaceId\tFaceDescr\tType\tPackets\tKilobytes\tPacketRaw\tKilobytesRaw\n"
+  "0.5\t1\t256\tnetDeviceFace://\tInInterests\t1.6\t0.0578125\t1\t0.0361328\n"
+  "0.5\t1\t256\tnetDeviceFace://\tOutInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t256\tnetDeviceFace://\tInData\t0\t0\t0\t0\n"
+  "0.5\t1\t256\tnetDeviceFace://\tOutData\t1.6\t1.65313\t1\t1.0332\n"
+  "0.5\t1\t256\tnetDeviceFace://\tInSatisfiedInterests\t1.6\t0\t1\t0\n"
+  "0.5\t1\t256\tnetDeviceFace://\tInTimedOutInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t256\tnetDeviceFace://\tOutSatisfiedInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t256\tnetDeviceFace://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t257\tnetDeviceFace://\tInInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t257\tnetDeviceFace://\tOutInterests\t3.2\t0.0578125\t2\t0.0361328\n"
+  "0.5\t1\t257\tnetDeviceFace://\tInData\t1.6\t1.65313\t1\t1.0332\n"
+  "0.5\t1\t257\tnetDeviceFace://\tOutData\t0\t0\t0\t0\n"
+  "0.5\t1\t257\tnetDeviceFace://\tInSatisfiedInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t257\tnetDeviceFace://\tInTimedOutInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t257\tnetDeviceFace://\tOutSatisfiedInterests\t1.6\t0\t1\t0\n"
+  "0.5\t1\t257\tnetDeviceFace://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t1\tinternal://\tInInterests\t1.6\t0\t1\t0\n"
+  "0.5\t1\t1\tinternal://\tOutInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t1\tinternal://\tInData\t0\t0\t0\t0\n"
+  "0.5\t1\t1\tinternal://\tOutData\t0\t0\t0\t0\n"
+  "0.5\t1\t1\tinternal://\tInSatisfiedInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t1\tinternal://\tInTimedOutInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t1\tinternal://\tOutSatisfiedInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t1\tinternal://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+  "0.5\t1\t-1\tall\tSatisfiedInterests\t1.6\t0\t1\t0\n"
+  "0.5\t1\t-1\tall\tTimedOutInterests\t0\t0\t0\t0\n"
+  "1\t1\t256\tnetDeviceFace://\tInInterests\t3.52\t0.127188\t2\t0.0722656\n"
+  "1\t1\t256\tnetDeviceFace://\tOutInterests\t0\t0\t0\t0\n"
+  "1\t1\t256\tnetDeviceFace://\tInData\t0\t0\t0\t0\n"
+  "1\t1\t256\tnetDeviceFace://\tOutData\t0.32\t0.330625\t0\t0\n"
+  "1\t1\t256\tnetDeviceFace://\tInSatisfiedInterests\t0.32\t0\t0\t0\n"
+  "1\t1\t256\tnetDeviceFace://\tInTimedOutInterests\t0\t0\t0\t0\n"
+  "1\t1\t256\tnetDeviceFace://\tOutSatisfiedInterests\t0\t0\t0\t0\n"
+  "1\t1\t256\tnetDeviceFace://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+  "1\t1\t257\tnetDeviceFace://\tInInterests\t0\t0\t0\t0\n"
+  "1\t1\t257\tnetDeviceFace://\tOutInterests\t0.64\t0.0115625\t0\t0\n"
+  "1\t1\t257\tnetDeviceFace://\tInData\t0.32\t0.330625\t0\t0\n"
+  "1\t1\t257\tnetDeviceFace://\tOutData\t0\t0\t0\t0\n"
+  "1\t1\t257\tnetDeviceFace://\tInSatisfiedInterests\t0\t0\t0\t0\n"
+  "1\t1\t257\tnetDeviceFace://\tInTimedOutInterests\t0\t0\t0\t0\n"
+  "1\t1\t257\tnetDeviceFace://\tOutSatisfiedInterests\t0.32\t0\t0\t0\n"
+  "1\t1\t257\tnetDeviceFace://\tOutTimedOutInterests\t1.6\t0\t1\t0\n"
+  "1\t1\t1\tinternal://\tInInterests\t0.32\t0\t0\t0\n"
+  "1\t1\t1\tinternal://\tOutInterests\t0\t0\t0\t0\n"
+  "1\t1\t1\tinternal://\tInData\t0\t0\t0\t0\n"
+  "1\t1\t1\tinternal://\tOutData\t0\t0\t0\t0\n"
+  "1\t1\t1\tinternal://\tInSatisfiedInterests\t0\t0\t0\t0\n"
+  "1\t1\t1\tinternal://\tInTimedOutInterests\t1.6\t0\t1\t0\n"
+  "1\t1\t1\tinternal://\tOutSatisfiedInterests\t0\t0\t0\t0\n"
+  "1\t1\t1\tinternal://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+  "1\t1\t-1\tall\tSatisfiedInterests\t0.32\t0\t0\t0\n"
+  "1\t1\t-1\tall\tTimedOutInterests\t1.6\t0\t1\t0\n"
+  "1.5\t1\t256\tnetDeviceFace://\tInInterests\t0.704\t0.0254375\t0\t0\n"
+  "1.5\t1\t256\tnetDeviceFace://\tOutInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t256\tnetDeviceFace://\tInData\t0\t0\t0\t0\n"
+  "1.5\t1\t256\tnetDeviceFace://\tOutData\t1.664\t1.71925\t1\t1.0332\n"
+  "1.5\t1\t256\tnetDeviceFace://\tInSatisfiedInterests\t1.664\t0\t1\t0\n"
+  "1.5\t1\t256\tnetDeviceFace://\tInTimedOutInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t256\tnetDeviceFace://\tOutSatisfiedInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t256\tnetDeviceFace://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t257\tnetDeviceFace://\tInInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t257\tnetDeviceFace://\tOutInterests\t1.728\t0.060125\t1\t0.0361328\n"
+  "1.5\t1\t257\tnetDeviceFace://\tInData\t1.664\t1.71925\t1\t1.0332\n"
+  "1.5\t1\t257\tnetDeviceFace://\tOutData\t0\t0\t0\t0\n"
+  "1.5\t1\t257\tnetDeviceFace://\tInSatisfiedInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t257\tnetDeviceFace://\tInTimedOutInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t257\tnetDeviceFace://\tOutSatisfiedInterests\t1.664\t0\t1\t0\n"
+  "1.5\t1\t257\tnetDeviceFace://\tOutTimedOutInterests\t0.32\t0\t0\t0\n"
+  "1.5\t1\t1\tinternal://\tInInterests\t0.064\t0\t0\t0\n"
+  "1.5\t1\t1\tinternal://\tOutInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t1\tinternal://\tInData\t0\t0\t0\t0\n"
+  "1.5\t1\t1\tinternal://\tOutData\t0\t0\t0\t0\n"
+  "1.5\t1\t1\tinternal://\tInSatisfiedInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t1\tinternal://\tInTimedOutInterests\t0.32\t0\t0\t0\n"
+  "1.5\t1\t1\tinternal://\tOutSatisfiedInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t1\tinternal://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+  "1.5\t1\t-1\tall\tSatisfiedInterests\t1.664\t0\t1\t0\n"
+  "1.5\t1\t-1\tall\tTimedOutInterests\t0.32\t0\t0\t0\n"
+  "2\t1\t256\tnetDeviceFace://\tInInterests\t0.1408\t0.0050875\t0\t0\n"
+  "2\t1\t256\tnetDeviceFace://\tOutInterests\t0\t0\t0\t0\n"
+  "2\t1\t256\tnetDeviceFace://\tInData\t0\t0\t0\t0\n"
+  "2\t1\t256\tnetDeviceFace://\tOutData\t0.3328\t0.34385\t0\t0\n"
+  "2\t1\t256\tnetDeviceFace://\tInSatisfiedInterests\t0.3328\t0\t0\t0\n"
+  "2\t1\t256\tnetDeviceFace://\tInTimedOutInterests\t0\t0\t0\t0\n"
+  "2\t1\t256\tnetDeviceFace://\tOutSatisfiedInterests\t0\t0\t0\t0\n"
+  "2\t1\t256\tnetDeviceFace://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+  "2\t1\t257\tnetDeviceFace://\tInInterests\t0\t0\t0\t0\n"
+  "2\t1\t257\tnetDeviceFace://\tOutInterests\t0.3456\t0.012025\t0\t0\n"
+  "2\t1\t257\tnetDeviceFace://\tInData\t0.3328\t0.34385\t0\t0\n"
+  "2\t1\t257\tnetDeviceFace://\tOutData\t0\t0\t0\t0\n"
+  "2\t1\t257\tnetDeviceFace://\tInSatisfiedInterests\t0\t0\t0\t0\n"
+  "2\t1\t257\tnetDeviceFace://\tInTimedOutInterests\t0\t0\t0\t0\n"
+  "2\t1\t257\tnetDeviceFace://\tOutSatisfiedInterests\t0.3328\t0\t0\t0\n"
+  "2\t1\t257\tnetDeviceFace://\tOutTimedOutInterests\t0.064\t0\t0\t0\n"
+  "2\t1\t1\tinternal://\tInInterests\t0.0128\t0\t0\t0\n"
+  "2\t1\t1\tinternal://\tOutInterests\t0\t0\t0\t0\n"
+  "2\t1\t1\tinternal://\tInData\t0\t0\t0\t0\n"
+  "2\t1\t1\tinternal://\tOutData\t0\t0\t0\t0\n"
+  "2\t1\t1\tinternal://\tInSatisfiedInterests\t0\t0\t0\t0\n"
+  "2\t1\t1\tinternal://\tInTimedOutInterests\t0.064\t0\t0\t0\n"
+  "2\t1\t1\tinternal://\tOutSatisfiedInterests\t0\t0\t0\t0\n"
+  "2\t1\t1\tinternal://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+  "2\t1\t-1\tall\tSatisfiedInterests\t0.3328\t0\t0\t0\n"
+  "2\t1\t-1\tall\tTimedOutInterests\t0.064\t0\t0\t0\n";
+
+class L3RateTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  L3RateTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "100s"},
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "1.5s"} // later Interests time out
+      });
+  }
+
+  ~L3RateTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TSV_TRACE);
+    boost::filesystem::remove(TEST_BINARY_TRACE);
+    L3RateTracer::Destroy(); // additional cleanup
+  }
+
+  static std::string
+  readFile(const boost::filesystem::path& path)
+  {
+    std::ifstream t(path.string().c_str());
+    std::stringstream buffer;
+    buffer << t.rdbuf();
+    return buffer.str();
+  }
+};
+
+// The trace sinks are protected, as only L3Protocol's trace sources call them
+class L3RateTracerSinks : public L3RateTracer
+{
+public:
+  using L3RateTracer::InInterests;
+  using L3RateTracer::OutInterests;
+  using L3RateTracer::InData;
+  using L3RateTracer::OutData;
+  using L3RateTracer::SatisfiedInterests;
+  using L3RateTracer::TimedOutInterests;
+};
+
+/**
+ * Traces a fixed sequence of packets on node 1, which has faces 256 and 257 towards nodes 2
+ * and 3, and the internal face
+ */
+class TracedSequenceFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TracedSequenceFixture()
+    : tsv(make_shared<std::ostringstream>())
+    , binary(make_shared<std::stringstream>(std::ios_base::in | std::ios_base::out |
+                                            std::ios_base::binary))
+  {
+    createTopology({
+        {"1", "2"},
+        {"1", "3"}
+      });
+
+    toNode2 = getFace("1", "2");
+    toNode3 = getFace("1", "3");
+    internalFace = getNode("1")->GetObject<L3Protocol>()->getFaceById(nfd::FACEID_INTERNAL_FACE);
+
+    tsvTracer = L3RateTracer::Install(getNode("1"), tsv, Seconds(0.5));
+    tsvTracer->PrintHeader(*tsv);
+    *tsv << "\n";
+    binaryTracer = L3RateTracer::Install(getNode("1"), binary, Seconds(0.5),
+                                         L3RateTracer::FORMAT_BINARY);
+    L3RateTracer::WriteBinaryHeader(*binary);
+  }
+
+  void
+  runUntil(double seconds)
+  {
+    Simulator::Stop(Seconds(seconds) - Simulator::Now());
+    Simulator::Run();
+  }
+
+  template<typename Sink, typename... Args>
+  void
+  trace(Sink sink, const Args&... args)
+  {
+    ((*tsvTracer).*sink)(args...);
+    ((*binaryTracer).*sink)(args...);
+  }
+
+  static shared_ptr<Interest>
+  makeInterest(const Name& name)
+  {
+    auto interest = make_shared<Interest>(name);
+    interest->setNonce(1);
+    interest->setInterestLifetime(time::seconds(1));
+    interest->wireEncode();
+    return interest;
+  }
+
+  void
+  traceSequence()
+  {
+    shared_ptr<Interest> interest1 = makeInterest("/prefix/1");
+    shared_ptr<Interest> interest2 = make_shared<Interest>(Name("/prefix/2")); // has no wire
+    shared_ptr<Interest> interest3 = makeInterest("/prefix/3");
+    shared_ptr<Data> data1 = DataTemplate::Encode("/prefix/1", 1024, Seconds(0), 0, Name());
+    shared_ptr<Data> data3 = DataTemplate::Encode("/prefix/3", 1024, Seconds(0), 0, Name());
+
+    nfd::pit::Entry entry1(*interest1);
+    entry1.insertOrUpdateInRecord(toNode2, *interest1);
+    entry1.insertOrUpdateOutRecord(toNode3, *interest1);
+    nfd::pit::Entry entry2(*interest2);
+    entry2.insertOrUpdateInRecord(internalFace, *interest2);
+    entry2.insertOrUpdateOutRecord(toNode3, *interest2);
+    nfd::pit::Entry entry3(*interest3);
+    entry3.insertOrUpdateInRecord(toNode2, *interest3);
+    entry3.insertOrUpdateOutRecord(toNode3, *interest3);
+
+    runUntil(0.1);
+    trace(&L3RateTracerSinks::InInterests, *interest1, *toNode2);
+    trace(&L3RateTracerSinks::OutInterests, *interest1, *toNode3);
+    runUntil(0.2);
+    trace(&L3RateTracerSinks::InData, *data1, *toNode3);
+    trace(&L3RateTracerSinks::OutData, *data1, *toNode2);
+    trace(&L3RateTracerSinks::SatisfiedInterests, entry1, *toNode3, *data1);
+    runUntil(0.3);
+    trace(&L3RateTracerSinks::InInterests, *interest2, *internalFace);
+    trace(&L3RateTracerSinks::OutInterests, *interest2, *toNode3);
+    runUntil(0.7);
+    trace(&L3RateTracerSinks::TimedOutInterests, entry2);
+    runUntil(0.8);
+    trace(&L3RateTracerSinks::InInterests, *interest3, *toNode2);
+    trace(&L3RateTracerSinks::InInterests, *interest3, *toNode2);
+    runUntil(1.2);
+    trace(&L3RateTracerSinks::OutInterests, *interest3, *toNode3);
+    runUntil(1.3);
+    trace(&L3RateTracerSinks::InData, *data3, *toNode3);
+    trace(&L3RateTracerSinks::OutData, *data3, *toNode2);
+    trace(&L3RateTracerSinks::SatisfiedInterests, entry3, *toNode3, *data3);
+    runUntil(2.1); // the last snapshot is taken at 2s
+  }
+
+  /// rows of a TSV trace in a fixed order, as the baseline tracer ordered faces by address
+  static std::vector<std::string>
+  sortRows(const std::string& trace)
+  {
+    std::vector<std::string> rows;
+    std::istringstream is(trace);
+    std::string row;
+    while (std::getline(is, row)) {
+      rows.push_back(row);
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+public:
+  shared_ptr<std::ostringstream> tsv;
+  shared_ptr<std::stringstream> binary;
+  shared_ptr<Face> toNode2;
+  shared_ptr<Face> toNode3;
+  shared_ptr<Face> internalFace;
+  Ptr<L3RateTracer> tsvTracer;
+  Ptr<L3RateTracer> binaryTracer;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnL3RateTracer, L3RateTracerFixture)
+
+BOOST_AUTO_TEST_CASE(BinaryMatchesTsv)
+{
+  L3RateTracer::InstallAll(TEST_TSV_TRACE.string(), Seconds(0.5));
+  L3RateTracer::InstallAll(TEST_BINARY_TRACE.string(), Seconds(0.5), L3RateTracer::FORMAT_BINARY);
+
+  Simulator::Stop(Seconds(4.1));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force traces to be written
+
+  std::string tsv = readFile(TEST_TSV_TRACE);
+  BOOST_CHECK(tsv.find("Time\tNode\tFaceId\tFaceDescr\tType") == 0);
+  BOOST_CHECK_NE(tsv.find("\t2\t-1\tall\tSatisfiedInterests\t"), std::string::npos);
+  BOOST_CHECK_NE(tsv.find("\t2\t-1\tall\tTimedOutInterests\t"), std::string::npos);
+  BOOST_CHECK_NE(tsv.find("\tOutTimedOutInterests\t"), std::string::npos);
+
+  std::ifstream is(TEST_BINARY_TRACE.string().c_str(), std::ios_base::in | std::ios_base::binary);
+  std::ostringstream converted;
+  BOOST_REQUIRE(L3RateTracer::ConvertToTsv(is, converted));
+  BOOST_CHECK_EQUAL(converted.str(), tsv);
+
+  std::istringstream notBinary(tsv);
+  std::ostringstream os;
+  BOOST_CHECK(!L3RateTracer::ConvertToTsv(notBinary, os));
+}
+
+BOOST_FIXTURE_TEST_CASE(MatchesBaselineTsv, TracedSequenceFixture)
+{
+  traceSequence();
+
+  std::vector<std::string> expected = sortRows(BASELINE_TSV);
+  std::vector<std::string> rows = sortRows(tsv->str());
+  BOOST_CHECK_EQUAL_COLLECTIONS(rows.begin(), rows.end(), expected.begin(), expected.end());
+
+  std::ostringstream converted;
+  BOOST_REQUIRE(L3RateTracer::ConvertToTsv(*binary, converted));
+  BOOST_CHECK_EQUAL(converted.str(), tsv->str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
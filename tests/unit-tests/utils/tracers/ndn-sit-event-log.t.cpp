@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-sit-event-log.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/output_test_stream.hpp>
+
+#include <fstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_EVENT_LOG = boost::filesystem::path(TEST_CONFIG_PATH) /
+                                               "events.bin";
+
+class SitEventLogFixture : public CleanupFixture
+{
+public:
+  SitEventLogFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~SitEventLogFixture()
+  {
+    SitEventLog::Close();
+    for (int type = 0; type < SitEventLog::N_EVENT_TYPES; type++) {
+      SitEventLog::Disable(static_cast<SitEventLog::EventType>(type));
+    }
+    boost::filesystem::remove(TEST_EVENT_LOG);
+  }
+
+  std::vector<SitEventLog::Event>
+  readEvents()
+  {
+    std::vector<SitEventLog::Event> events;
+    std::ifstream is(TEST_EVENT_LOG.string().c_str(), std::ios_base::in | std::ios_base::binary);
+    BOOST_REQUIRE(SitEventLog::Read(is, [&] (const SitEventLog::Event& event) {
+          events.push_back(event);
+        }));
+    return events;
+  }
+
+  static void
+  record(SitEventLog::EventType type, uint64_t seq, uint32_t face, bool isLocalFace,
+         bool destinationFlag)
+  {
+    SitEventLog::Record(type, Name("/sit").appendNumber(7).appendSequenceNumber(seq), face,
+                        isLocalFace, destinationFlag, 3);
+  }
+
+  static void
+  recordMixed()
+  {
+    record(SitEventLog::CS_MISS, 1, 256, false, false);
+    record(SitEventLog::FORWARD_FIB, 1, 257, false, false); // not enabled
+    record(SitEventLog::CS_HIT, 2, 256, false, true);
+    SitEventLog::Record(SitEventLog::DATA_OUT, Name("/other"), 258, true, false, 70000);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnSitEventLog, SitEventLogFixture)
+
+BOOST_AUTO_TEST_CASE(RecordAndRead)
+{
+  BOOST_REQUIRE(SitEventLog::Enable("cs-hit,cs-miss,data-out"));
+  SitEventLog::Open(TEST_EVENT_LOG.string(), 2); // forces writes before Close
+
+  Simulator::ScheduleWithContext(5, Seconds(1), &SitEventLogFixture::recordMixed);
+  Simulator::Run();
+  SitEventLog::Close();
+
+  std::vector<SitEventLog::Event> events = readEvents();
+  BOOST_REQUIRE_EQUAL(events.size(), 3);
+
+  BOOST_CHECK_EQUAL(events[0].type, SitEventLog::CS_MISS);
+  BOOST_CHECK_EQUAL(events[0].time, Seconds(1).GetNanoSeconds());
+  BOOST_CHECK_EQUAL(events[0].node, 5);
+  BOOST_CHECK_EQUAL(events[0].producer, 7);
+  BOOST_CHECK_EQUAL(events[0].seq, 1);
+  BOOST_CHECK_EQUAL(events[0].face, 256);
+  BOOST_CHECK_EQUAL(events[0].floodFlag, 3);
+  BOOST_CHECK_EQUAL(events[0].flags, 0);
+
+  BOOST_CHECK_EQUAL(events[1].type, SitEventLog::CS_HIT);
+  BOOST_CHECK_EQUAL(events[1].flags, SitEventLog::DESTINATION_FLAG);
+
+  BOOST_CHECK_EQUAL(events[2].type, SitEventLog::DATA_OUT);
+  BOOST_CHECK_EQUAL(events[2].producer, std::numeric_limits<uint32_t>::max());
+  BOOST_CHECK_EQUAL(events[2].floodFlag, 0xFFFF);
+  BOOST_CHECK_EQUAL(events[2].flags, SitEventLog::LOCAL_FACE);
+
+  boost::test_tools::output_test_stream os;
+  SitEventLog::WriteCsv(os, events[0]);
+  BOOST_CHECK(os.is_equal("1000000000,5,cs-miss,7,1,0,3,256,0\n"));
+}
+
+BOOST_AUTO_TEST_CASE(Aggregate)
+{
+  BOOST_REQUIRE(SitEventLog::Enable("all"));
+  SitEventLog::Open(TEST_EVENT_LOG.string());
+
+  // one Interest with DF 0 travels two hops to a cache, and its Data travels back
+  record(SitEventLog::CS_MISS, 1, 256, true, false);
+  record(SitEventLog::FORWARD_FIB, 1, 257, false, false);
+  record(SitEventLog::CS_MISS, 1, 256, false, false);
+  record(SitEventLog::FORWARD_SIT, 1, 258, false, true);
+  record(SitEventLog::CS_HIT, 1, 256, false, true);
+  record(SitEventLog::DATA_OUT, 1, 256, false, false);
+  record(SitEventLog::DATA_OUT, 1, 256, false, false);
+  record(SitEventLog::DATA_OUT, 1, 1, true, false);
+  record(SitEventLog::REJECT, 2, 256, false, false);
+  SitEventLog::Close();
+
+  SitEventLog::Summary summary;
+  for (const SitEventLog::Event& event : readEvents()) {
+    summary.Add(event);
+  }
+
+  BOOST_CHECK_EQUAL(summary.GetCount(SitEventLog::CS_MISS), 2);
+  BOOST_CHECK_EQUAL(summary.GetCount(SitEventLog::DATA_OUT), 3);
+  BOOST_CHECK_EQUAL(summary.GetCount(SitEventLog::REJECT), 1);
+  BOOST_CHECK_CLOSE(summary.GetHitRatio(false), 0.0, 0.001);
+  BOOST_CHECK_CLOSE(summary.GetHitRatio(true), 1.0, 0.001);
+  BOOST_CHECK_CLOSE(summary.GetDataHopsPerDelivery(), 2.0, 0.001);
+  BOOST_CHECK_CLOSE(summary.GetInterestHopsPerDelivery(), 2.0, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  SitEventLog::Open(TEST_EVENT_LOG.string());
+  record(SitEventLog::CS_HIT, 1, 256, false, false);
+  SitEventLog::Close();
+
+  // closed log
+  SitEventLog::Enable(SitEventLog::CS_HIT);
+  record(SitEventLog::CS_HIT, 2, 256, false, false);
+
+  BOOST_CHECK_EQUAL(readEvents().size(), 0);
+  BOOST_CHECK(!SitEventLog::Enable("cs-hit,unknown"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,296 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-content-store.hpp" // boost::hash_value for name::Component, before the trie
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "utils/trie/lfu-policy.hpp"
+#include "utils/trie/fifo-policy.hpp"
+#include "utils/trie/random-policy.hpp"
+#include "utils/trie/multi-policy.hpp"
+#include "model/cs/custom-policies/freshness-policy.hpp"
+#include "model/cs/custom-policies/probability-policy.hpp"
+#include "model/cs/custom-policies/lifetime-stats-policy.hpp"
+
+#include <boost/mpl/vector.hpp>
+
+#include <set>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+class Item : public SimpleRefCount<Item> {
+public:
+  explicit
+  Item(int value)
+    : m_value(value)
+    , m_data(make_shared<Data>())
+  {
+    m_data->setFreshnessPeriod(time::seconds(1)); // so that the freshness policy tracks it
+  }
+
+  shared_ptr<const Data>
+  GetData() const
+  {
+    return m_data;
+  }
+
+  int m_value;
+
+private:
+  shared_ptr<Data> m_data;
+};
+
+typedef trie_with_policy<Name, smart_pointer_payload_traits<Item>, lru_policy_traits> LruTrie;
+
+template<class Trie>
+static size_t
+countNodes(Trie& trie)
+{
+  size_t count = 0;
+  for (typename Trie::parent_trie::recursive_iterator node(trie.getTrie()), end(0); node != end;
+       node++) {
+    count++;
+  }
+  return count;
+}
+
+class TrieFixture : public CleanupFixture
+{
+public:
+  size_t
+  countPayloads()
+  {
+    size_t count = 0;
+    for (LruTrie::parent_trie::recursive_iterator node(trie.getTrie()), end(0); node != end;
+         node++) {
+      if (node->payload() != nullptr)
+        count++;
+    }
+    return count;
+  }
+
+  size_t
+  countChildren(LruTrie::iterator parent)
+  {
+    size_t count = 0;
+    for (LruTrie::parent_trie::point_iterator child(*parent), end(0); child != end; child++) {
+      count++;
+    }
+    return count;
+  }
+
+public:
+  LruTrie trie;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTrieTrieWithPolicy, TrieFixture)
+
+BOOST_AUTO_TEST_CASE(ManyChildren)
+{
+  trie.getPolicy().set_max_size(1000);
+
+  // more children than fit in the sorted array, so /a switches to the hash table
+  for (int i = 0; i < 100; i++) {
+    BOOST_CHECK(trie.insert(Name("/a").appendNumber(i), Create<Item>(i)).second);
+  }
+  BOOST_CHECK(!trie.insert(Name("/a").appendNumber(42), Create<Item>(0)).second);
+  BOOST_CHECK_EQUAL(countPayloads(), 100);
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 100);
+
+  // /a has no payload of its own, so find_exact() would not return it
+  LruTrie::iterator a = std::get<2>(trie.getTrie().find(Name("/a")));
+  BOOST_REQUIRE(a != trie.end());
+  BOOST_CHECK_EQUAL(a->key(), name::Component("a"));
+  BOOST_CHECK_EQUAL(countChildren(a), 100);
+
+  for (int i = 0; i < 100; i++) {
+    LruTrie::iterator item = trie.find_exact(Name("/a").appendNumber(i));
+    BOOST_REQUIRE(item != trie.end());
+    BOOST_CHECK_EQUAL(item->payload()->m_value, i);
+  }
+  BOOST_CHECK(trie.find_exact(Name("/a").appendNumber(100)) == trie.end());
+  BOOST_CHECK_EQUAL(trie.longest_prefix_match(Name("/a").appendNumber(7).append("b"))
+                      ->payload()->m_value, 7);
+
+  // back to the sorted array
+  for (int i = 0; i < 95; i++) {
+    trie.erase(Name("/a").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(countPayloads(), 5);
+  BOOST_CHECK_EQUAL(countChildren(a), 5);
+  for (int i = 95; i < 100; i++) {
+    BOOST_CHECK(trie.find_exact(Name("/a").appendNumber(i)) != trie.end());
+  }
+
+  trie.clear();
+  BOOST_CHECK_EQUAL(countPayloads(), 0);
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Eviction)
+{
+  trie.getPolicy().set_max_size(20);
+
+  for (int i = 0; i < 50; i++) {
+    trie.insert(Name("/b").appendNumber(i % 7).appendNumber(i), Create<Item>(i));
+  }
+  BOOST_CHECK_EQUAL(countPayloads(), 20);
+
+  std::set<int> values;
+  for (LruTrie::parent_trie::recursive_iterator node(trie.getTrie()), end(0); node != end;
+       node++) {
+    if (node->payload() != nullptr)
+      values.insert(node->payload()->m_value);
+  }
+  BOOST_REQUIRE_EQUAL(values.size(), 20);
+  BOOST_CHECK_EQUAL(*values.begin(), 30); // the least recently inserted ones are gone
+  BOOST_CHECK_EQUAL(*values.rbegin(), 49);
+}
+
+BOOST_AUTO_TEST_CASE(InsertIfAdmitted)
+{
+  int nCreated = 0;
+  auto makeItem = [&nCreated] (LruTrie::iterator) {
+    nCreated++;
+    return Create<Item>(nCreated);
+  };
+
+  std::pair<LruTrie::iterator, bool> result = trie.insert_if_admitted(Name("/c/1"), makeItem);
+  BOOST_CHECK(result.second);
+  BOOST_CHECK_EQUAL(result.first->payload()->m_value, 1);
+
+  // an existing key gets no new payload
+  result = trie.insert_if_admitted(Name("/c/1"), makeItem);
+  BOOST_CHECK(!result.second);
+  BOOST_CHECK_EQUAL(result.first->payload()->m_value, 1);
+  BOOST_CHECK_EQUAL(nCreated, 1);
+
+  // a prefix of an existing key is a new key
+  BOOST_CHECK(trie.insert_if_admitted(Name("/c"), makeItem).second);
+  BOOST_CHECK_EQUAL(nCreated, 2);
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(InsertIfAdmittedRejected)
+{
+  typedef trie_with_policy<Name, smart_pointer_payload_traits<Item>, probability_policy_traits>
+    ProbabilityTrie;
+  ProbabilityTrie probabilityTrie;
+
+  int nCreated = 0;
+  auto makeItem = [&nCreated] (ProbabilityTrie::iterator) {
+    nCreated++;
+    return Create<Item>(nCreated);
+  };
+
+  BOOST_CHECK(probabilityTrie.insert_if_admitted(Name("/d"), makeItem).second);
+  BOOST_CHECK_EQUAL(countNodes(probabilityTrie), 2);
+
+  probabilityTrie.getPolicy().set_probability(0.0);
+  std::pair<ProbabilityTrie::iterator, bool> result =
+    probabilityTrie.insert_if_admitted(Name("/d/1/2"), makeItem);
+  BOOST_CHECK(!result.second);
+  BOOST_CHECK(result.first == probabilityTrie.end());
+
+  // no payload was made, and only the nodes created for /d/1/2 are gone
+  BOOST_CHECK_EQUAL(nCreated, 1);
+  BOOST_CHECK_EQUAL(countNodes(probabilityTrie), 2);
+  BOOST_CHECK(probabilityTrie.find_exact(Name("/d/1")) == probabilityTrie.end());
+  BOOST_CHECK_EQUAL(probabilityTrie.find_exact(Name("/d"))->payload()->m_value, 1);
+  BOOST_CHECK_EQUAL(probabilityTrie.getPolicy().size(), 1);
+}
+
+typedef boost::mpl::vector<lru_policy_traits, lfu_policy_traits, fifo_policy_traits,
+                           random_policy_traits, freshness_policy_traits,
+                           probability_policy_traits, lifetime_stats_policy_traits,
+                           multi_policy_traits<boost::mpl::vector2<lru_policy_traits,
+                                                                   lifetime_stats_policy_traits>>>
+  AllPolicies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(InsertErase, Policy, AllPolicies)
+{
+  typedef trie_with_policy<Name, smart_pointer_payload_traits<Item>, Policy> PolicyTrie;
+  PolicyTrie policyTrie;
+  policyTrie.getPolicy().set_max_size(100);
+
+  for (int i = 0; i < 20; i++) {
+    BOOST_CHECK(policyTrie.insert(Name("/p").appendNumber(i % 3).appendNumber(i),
+                                  Create<Item>(i)).second);
+  }
+  BOOST_CHECK(!policyTrie.insert(Name("/p").appendNumber(1).appendNumber(4), Create<Item>(0))
+                 .second);
+  BOOST_CHECK_EQUAL(countNodes(policyTrie), 1 + 1 + 3 + 20);
+
+  policyTrie.erase(Name("/p").appendNumber(1).appendNumber(4));
+  BOOST_CHECK(policyTrie.find_exact(Name("/p").appendNumber(1).appendNumber(4)) ==
+              policyTrie.end());
+  BOOST_CHECK_EQUAL(countNodes(policyTrie), 1 + 1 + 3 + 19);
+
+  for (int i = 0; i < 20; i++) {
+    if (i == 4)
+      continue;
+    typename PolicyTrie::iterator item =
+      policyTrie.find_exact(Name("/p").appendNumber(i % 3).appendNumber(i));
+    BOOST_REQUIRE(item != policyTrie.end());
+    BOOST_CHECK_EQUAL(item->payload()->m_value, i);
+  }
+
+  policyTrie.clear();
+  BOOST_CHECK_EQUAL(countNodes(policyTrie), 1);
+}
+
+typedef boost::mpl::vector<lru_policy_traits, lfu_policy_traits, fifo_policy_traits,
+                           random_policy_traits,
+                           multi_policy_traits<boost::mpl::vector2<lru_policy_traits,
+                                                                   lifetime_stats_policy_traits>>>
+  EvictingPolicies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(EvictionByPolicy, Policy, EvictingPolicies)
+{
+  typedef trie_with_policy<Name, smart_pointer_payload_traits<Item>, Policy> PolicyTrie;
+  PolicyTrie policyTrie;
+  policyTrie.getPolicy().set_max_size(5);
+
+  for (int i = 0; i < 20; i++) {
+    policyTrie.insert(Name("/e").appendNumber(i), Create<Item>(i));
+  }
+
+  // evicted (or rejected) keys leave no nodes behind
+  BOOST_CHECK_EQUAL(countNodes(policyTrie), 1 + 1 + 5);
+
+  size_t nFound = 0;
+  for (int i = 0; i < 20; i++) {
+    typename PolicyTrie::iterator item = policyTrie.find_exact(Name("/e").appendNumber(i));
+    if (item != policyTrie.end()) {
+      BOOST_CHECK_EQUAL(item->payload()->m_value, i);
+      nFound++;
+    }
+  }
+  BOOST_CHECK_EQUAL(nFound, 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndnSIM
+} // namespace ndn
+} // namespace ns3
@@ -22,9 +22,10 @@
 
 #ifdef __linux__
 // #include <proc/readproc.h>
-// #include <unistd.h>
+#include <unistd.h>
 // // #include <sys/resource.h>
 #include <sys/sysinfo.h>
+#include <fstream>
 #endif
 
 #ifdef __APPLE__
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-data-template.hpp"
+
+#include "ns3/log.h"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <map>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE("ndn.DataTemplate");
+
+namespace ns3 {
+namespace ndn {
+
+shared_ptr<const DataTemplate>
+DataTemplate::Get(uint32_t payloadSize, Time freshness, uint32_t signature, const Name& keyLocator)
+{
+  typedef std::tuple<uint32_t, int64_t, uint32_t, Name> Key;
+  static std::map<Key, std::weak_ptr<const DataTemplate>> templates;
+
+  std::weak_ptr<const DataTemplate>& weakTemplate =
+    templates[Key(payloadSize, freshness.GetMilliSeconds(), signature, keyLocator)];
+  shared_ptr<const DataTemplate> dataTemplate = weakTemplate.lock();
+  if (dataTemplate == nullptr) {
+    // forget templates that nobody uses anymore
+    for (auto i = templates.begin(); i != templates.end();) {
+      if (i->second.expired() && &i->second != &weakTemplate)
+        i = templates.erase(i);
+      else
+        ++i;
+    }
+
+    dataTemplate = make_shared<DataTemplate>(payloadSize, freshness, signature, keyLocator);
+    weakTemplate = dataTemplate;
+  }
+  return dataTemplate;
+}
+
+DataTemplate::DataTemplate(uint32_t payloadSize, Time freshness, uint32_t signature,
+                           const Name& keyLocator)
+{
+  // encode with an empty Name and keep what follows it
+  shared_ptr<Data> data = Encode(Name(), payloadSize, freshness, signature, keyLocator);
+  const Block& wire = data->wireEncode();
+  const Block& name = wire.get(::ndn::tlv::Name);
+  m_tail = make_shared< ::ndn::Buffer>(name.end(), wire.end());
+
+  NS_LOG_DEBUG("Data template with " << m_tail->size() << " bytes after the Name");
+}
+
+shared_ptr<Data>
+DataTemplate::Make(const Name& name) const
+{
+  const Block& nameWire = name.wireEncode();
+  size_t length = nameWire.size() + m_tail->size();
+
+  // room for the Data type and length, at most 5 bytes each for these sizes
+  ::ndn::EncodingBuffer encoder(length + 10, 0);
+  encoder.prependByteArray(m_tail->buf(), m_tail->size());
+  encoder.prependByteArray(nameWire.wire(), nameWire.size());
+  encoder.prependVarNumber(length);
+  encoder.prependVarNumber(::ndn::tlv::Data);
+
+  return make_shared<Data>(encoder.block());
+}
+
+shared_ptr<Data>
+DataTemplate::Encode(const Name& name, uint32_t payloadSize, Time freshness, uint32_t signature,
+                     const Name& keyLocator)
+{
+  auto data = make_shared<Data>();
+  data->setName(name);
+  data->setFreshnessPeriod(::ndn::time::milliseconds(freshness.GetMilliSeconds()));
+
+  data->setContent(make_shared< ::ndn::Buffer>(payloadSize));
+
+  Signature fakeSignature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+
+  if (keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(keyLocator);
+  }
+
+  fakeSignature.setInfo(signatureInfo);
+  fakeSignature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, signature));
+
+  data->setSignature(fakeSignature);
+
+  // to create real wire encoding
+  data->wireEncode();
+  return data;
+}
+
+} // namespace ndn
+} // namespace ns3
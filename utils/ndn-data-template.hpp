@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_DATA_TEMPLATE_H
+#define NDN_DATA_TEMPLATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <boost/noncopyable.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Pre-encoded Data packet with a virtual (all zero) payload and a fake signature
+ *
+ * Everything in such a Data but the Name (MetaInfo, Content, SignatureInfo and
+ * SignatureValue) is encoded once. Make() then copies the encoded Name and this tail into
+ * one buffer, producing the same wire encoding as Encode() without allocating the payload,
+ * building the signature or running the encoder.
+ *
+ * Templates are immutable and shared: Get() returns the same instance for every caller
+ * asking for the same parameters while any of them holds it.
+ */
+class DataTemplate : boost::noncopyable {
+public:
+  /**
+   * @brief Get the shared template for the given parameters, building it if needed
+   */
+  static shared_ptr<const DataTemplate>
+  Get(uint32_t payloadSize, Time freshness, uint32_t signature, const Name& keyLocator);
+
+  /**
+   * @param payloadSize size of the zero payload
+   * @param freshness FreshnessPeriod, truncated to milliseconds
+   * @param signature value of the fake signature (signature type 255)
+   * @param keyLocator key locator name, not used if empty
+   */
+  DataTemplate(uint32_t payloadSize, Time freshness, uint32_t signature, const Name& keyLocator);
+
+  /**
+   * @brief Make a Data packet with the given name from the template
+   */
+  shared_ptr<Data>
+  Make(const Name& name) const;
+
+  /**
+   * @brief Build and encode a Data packet field by field
+   *
+   * This is what the template saves; the result has the same wire encoding as Make().
+   */
+  static shared_ptr<Data>
+  Encode(const Name& name, uint32_t payloadSize, Time freshness, uint32_t signature,
+         const Name& keyLocator);
+
+  /**
+   * @brief Size of the encoding that follows the Name, in bytes
+   */
+  size_t
+  GetTailSize() const;
+
+private:
+  ::ndn::ConstBufferPtr m_tail; // MetaInfo, Content, SignatureInfo and SignatureValue
+};
+
+inline size_t
+DataTemplate::GetTailSize() const
+{
+  return m_tail->size();
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DATA_TEMPLATE_H
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-log-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+const uint64_t HALF_BUCKETS = uint64_t(1) << (LogHistogram::PRECISION_BITS - 1);
+
+int
+getShift(uint64_t value)
+{
+  int msb = 63 - __builtin_clzll(value | 1);
+  return std::max(0, msb - LogHistogram::PRECISION_BITS + 1);
+}
+
+} // namespace
+
+LogHistogram::LogHistogram()
+  : m_count(0)
+  , m_min(std::numeric_limits<uint64_t>::max())
+  , m_max(0)
+  , m_sum(0.0)
+{
+}
+
+size_t
+LogHistogram::GetBucket(uint64_t value)
+{
+  int shift = getShift(value);
+  return shift * HALF_BUCKETS + (value >> shift);
+}
+
+void
+LogHistogram::Record(uint64_t value)
+{
+  size_t bucket = GetBucket(value);
+  if (bucket >= m_buckets.size())
+    m_buckets.resize(bucket + 1, 0);
+  m_buckets[bucket]++;
+
+  m_count++;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+  m_sum += value;
+}
+
+void
+LogHistogram::Reset()
+{
+  std::fill(m_buckets.begin(), m_buckets.end(), 0);
+  m_count = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+  m_sum = 0.0;
+}
+
+uint64_t
+LogHistogram::GetPercentile(double percentile) const
+{
+  if (m_count == 0)
+    return 0;
+
+  uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_count));
+  rank = std::min(std::max<uint64_t>(rank, 1), m_count);
+
+  uint64_t seen = 0;
+  size_t bucket = 0;
+  for (; bucket < m_buckets.size(); bucket++) {
+    seen += m_buckets[bucket];
+    if (seen >= rank)
+      break;
+  }
+
+  // bucket = shift * HALF_BUCKETS + (value >> shift), where (value >> shift) is in
+  // [HALF_BUCKETS, 2 * HALF_BUCKETS) unless shift is 0
+  uint64_t shift = bucket < 2 * HALF_BUCKETS ? 0 : bucket / HALF_BUCKETS - 1;
+  uint64_t lowest = (bucket - shift * HALF_BUCKETS) << shift;
+  uint64_t middle = lowest + (((uint64_t(1) << shift) - 1) >> 1);
+  return std::min(std::max(middle, m_min), m_max);
+}
+
+} // namespace ndn
+} // namespace ns3
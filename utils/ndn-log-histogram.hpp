@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_LOG_HISTOGRAM_H
+#define NDN_LOG_HISTOGRAM_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Histogram of non-negative integers with logarithmic buckets (HDR-style)
+ *
+ * Values below 2^PRECISION_BITS get a bucket each.  Above that, each power-of-two range
+ * is split into 2^(PRECISION_BITS - 1) equal buckets, so a bucket is at most 1/128 (0.8%)
+ * of the values in it.  Percentiles are estimated by the middle of a bucket and are within
+ * 1/256 (0.4%) of the exact ones.  Buckets are allocated up to the largest recorded value only.
+ */
+class LogHistogram {
+public:
+  static const int PRECISION_BITS = 8;
+
+  LogHistogram();
+
+  void
+  Record(uint64_t value);
+
+  /**
+   * @brief Forget all recorded values, keeping the buckets allocated
+   */
+  void
+  Reset();
+
+  uint64_t
+  GetCount() const;
+
+  uint64_t
+  GetMin() const;
+
+  uint64_t
+  GetMax() const;
+
+  double
+  GetMean() const;
+
+  /**
+   * @brief Estimate the nearest-rank percentile
+   * @param percentile in [0, 100]
+   * @return middle of the bucket holding the value of rank ceil(percentile / 100 * count),
+   *         clamped to [GetMin(), GetMax()], or 0 if the histogram is empty
+   */
+  uint64_t
+  GetPercentile(double percentile) const;
+
+private:
+  static size_t
+  GetBucket(uint64_t value);
+
+private:
+  std::vector<uint64_t> m_buckets;
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+  double m_sum;
+};
+
+inline uint64_t
+LogHistogram::GetCount() const
+{
+  return m_count;
+}
+
+inline uint64_t
+LogHistogram::GetMin() const
+{
+  return m_count == 0 ? 0 : m_min;
+}
+
+inline uint64_t
+LogHistogram::GetMax() const
+{
+  return m_max;
+}
+
+inline double
+LogHistogram::GetMean() const
+{
+  return m_count == 0 ? 0.0 : m_sum / m_count;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LOG_HISTOGRAM_H
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-zipf-mandelbrot-table.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ZipfMandelbrotTable");
+
+namespace ns3 {
+namespace ndn {
+
+shared_ptr<const ZipfMandelbrotTable>
+ZipfMandelbrotTable::Get(uint32_t n, double q, double s, Method method)
+{
+  typedef std::tuple<uint32_t, double, double, Method> Key;
+  static std::map<Key, std::weak_ptr<const ZipfMandelbrotTable>> tables;
+
+  std::weak_ptr<const ZipfMandelbrotTable>& weakTable = tables[Key(n, q, s, method)];
+  shared_ptr<const ZipfMandelbrotTable> table = weakTable.lock();
+  if (table == nullptr) {
+    // forget tables that nobody uses anymore
+    for (auto i = tables.begin(); i != tables.end();) {
+      if (i->second.expired() && &i->second != &weakTable)
+        i = tables.erase(i);
+      else
+        ++i;
+    }
+
+    table = make_shared<ZipfMandelbrotTable>(n, q, s, method);
+    weakTable = table;
+  }
+  return table;
+}
+
+ZipfMandelbrotTable::ZipfMandelbrotTable(uint32_t n, double q, double s, Method method)
+  : m_N(n)
+  , m_method(method)
+{
+  NS_LOG_DEBUG(q << " and " << s << " and " << m_N);
+
+  if (m_method == ALIAS)
+    BuildAlias(q, s);
+  else
+    BuildCumulative(q, s);
+}
+
+void
+ZipfMandelbrotTable::BuildCumulative(double q, double s)
+{
+  m_Pcum = std::vector<double>(m_N + 1);
+
+  m_Pcum[0] = 0.0;
+  for (uint32_t i = 1; i <= m_N; i++) {
+    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + q, s);
+  }
+
+  for (uint32_t i = 1; i <= m_N; i++) {
+    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
+    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
+  }
+}
+
+void
+ZipfMandelbrotTable::BuildAlias(double q, double s)
+{
+  m_prob = std::vector<double>(m_N);
+  m_alias = std::vector<uint32_t>(m_N);
+
+  double sum = 0.0;
+  for (uint32_t i = 0; i < m_N; i++) {
+    m_prob[i] = 1.0 / std::pow(i + 1 + q, s);
+    sum += m_prob[i];
+  }
+
+  // scale so that the average column holds 1, then pair each underfull column with an
+  // overfull one that fills it up
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (uint32_t i = 0; i < m_N; i++) {
+    m_prob[i] = m_prob[i] * m_N / sum;
+    m_alias[i] = i + 1;
+    if (m_prob[i] < 1.0)
+      small.push_back(i);
+    else
+      large.push_back(i);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    uint32_t less = small.back();
+    small.pop_back();
+    uint32_t more = large.back();
+
+    m_alias[less] = more + 1;
+    m_prob[more] = (m_prob[more] + m_prob[less]) - 1.0;
+    if (m_prob[more] < 1.0) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+
+  // whatever is left is full up to rounding errors
+  for (uint32_t i : small) {
+    m_prob[i] = 1.0;
+  }
+  for (uint32_t i : large) {
+    m_prob[i] = 1.0;
+  }
+}
+
+uint32_t
+ZipfMandelbrotTable::SampleBinarySearch(double u) const
+{
+  // first k with u <= m_Pcum[k], which is what scanning m_Pcum from k = 1 finds
+  auto i = std::lower_bound(m_Pcum.begin() + 1, m_Pcum.end(), u);
+  if (i == m_Pcum.end())
+    return 1;
+  return static_cast<uint32_t>(i - m_Pcum.begin());
+}
+
+uint32_t
+ZipfMandelbrotTable::SampleAlias(double u) const
+{
+  if (m_N == 0)
+    return 1;
+
+  // the integer part of u * N picks the column, the fraction decides between the column
+  // and its alias
+  double x = u * m_N;
+  uint32_t column = std::min(static_cast<uint32_t>(x), m_N - 1);
+  return (x - column) < m_prob[column] ? column + 1 : m_alias[column];
+}
+
+size_t
+ZipfMandelbrotTable::GetMemoryUsage() const
+{
+  return sizeof(*this) + m_Pcum.capacity() * sizeof(double) + m_prob.capacity() * sizeof(double)
+         + m_alias.capacity() * sizeof(uint32_t);
+}
+
+} // namespace ndn
+} // namespace ns3
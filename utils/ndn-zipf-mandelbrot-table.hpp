@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ZIPF_MANDELBROT_TABLE_H
+#define NDN_ZIPF_MANDELBROT_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Sampling table of the Zipf-Mandelbrot distribution p(k) ~ 1 / (k + q)^s, k = 1..N
+ *
+ * Tables are immutable and shared: Get() returns the same instance for every caller asking
+ * for the same (N, q, s, method) while any of them holds it.
+ *
+ * With BINARY_SEARCH the table holds the cumulative probabilities and a sample costs
+ * O(log N); it returns the same content index as a linear scan of the cumulative array.
+ * With ALIAS the table holds a Walker alias table (Vose's construction) and a sample
+ * costs O(1), but maps a given random number to a different index.
+ */
+class ZipfMandelbrotTable : boost::noncopyable {
+public:
+  enum Method {
+    BINARY_SEARCH,
+    ALIAS
+  };
+
+  /**
+   * @brief Get the shared table for the given parameters, building it if needed
+   */
+  static shared_ptr<const ZipfMandelbrotTable>
+  Get(uint32_t n, double q, double s, Method method = BINARY_SEARCH);
+
+  ZipfMandelbrotTable(uint32_t n, double q, double s, Method method);
+
+  /**
+   * @brief Map a uniform random number to a content index
+   * @param u Uniform random number in (0, 1]
+   * @return Content index in [1, N]
+   */
+  uint32_t
+  Sample(double u) const;
+
+  uint32_t
+  GetNumberOfContents() const;
+
+  Method
+  GetMethod() const;
+
+  /**
+   * @brief Heap memory used by the table, in bytes
+   */
+  size_t
+  GetMemoryUsage() const;
+
+private:
+  uint32_t
+  SampleBinarySearch(double u) const;
+
+  uint32_t
+  SampleAlias(double u) const;
+
+  void
+  BuildCumulative(double q, double s);
+
+  void
+  BuildAlias(double q, double s);
+
+private:
+  uint32_t m_N;
+  Method m_method;
+
+  std::vector<double> m_Pcum; // BINARY_SEARCH: m_Pcum[k] = p[1] + ... + p[k], m_Pcum[0] = 0
+
+  std::vector<double> m_prob;    // ALIAS: probability of keeping column k - 1
+  std::vector<uint32_t> m_alias; // ALIAS: content index used otherwise
+};
+
+inline uint32_t
+ZipfMandelbrotTable::Sample(double u) const
+{
+  return m_method == ALIAS ? SampleAlias(u) : SampleBinarySearch(u);
+}
+
+inline uint32_t
+ZipfMandelbrotTable::GetNumberOfContents() const
+{
+  return m_N;
+}
+
+inline ZipfMandelbrotTable::Method
+ZipfMandelbrotTable::GetMethod() const
+{
+  return m_method;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ZIPF_MANDELBROT_TABLE_H
@@ -40,6 +40,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/node-list.h"
+#include "ns3/rng-seed-manager.h"
 
 #include "ns3/mobility-model.h"
 
@@ -51,7 +52,17 @@
 #include <boost/graph/graphviz.hpp>
 #include <boost/graph/connected_components.hpp>
 
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iomanip>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace std;
 using namespace boost;
@@ -64,7 +75,10 @@ RocketfuelMapReader::RocketfuelMapReader(const std::string& path /*=""*/, double
                                          const std::string& referenceOspfRate)
   : AnnotatedTopologyReader(path, scale)
   , m_randVar(CreateObject<UniformRandomVariable>())
+  , m_stream(-1)
   , m_referenceOspfRate(boost::lexical_cast<DataRate>(referenceOspfRate))
+  , m_isLoadedFromCache(false)
+  , m_loadTime(0.0)
 {
 }
 
@@ -93,71 +107,42 @@ RocketfuelMapReader::Read()
         "\\(([0-9]+)\\)" SPACE "(&[0-9]+)*" MAYSPACE "->" MAYSPACE "(<[0-9 \t<>]+>)*" MAYSPACE     \
         "(\\{-[0-9\\{\\} \t-]+\\})*" SPACE "=([A-Za-z0-9.!-]+)" SPACE "r([0-9])" MAYSPACE END
 
-void
-RocketfuelMapReader::CreateLink(string nodeName1, string nodeName2, double averageRtt,
-                                const string& minBw, const string& maxBw, const string& minDelay,
-                                const string& maxDelay)
-{
-  Ptr<Node> node1 = Names::Find<Node>(m_path, nodeName1);
-  Ptr<Node> node2 = Names::Find<Node>(m_path, nodeName2);
-  Link link(node1, nodeName1, node2, nodeName2);
-
-  DataRate randBandwidth(
-    m_randVar->GetInteger(static_cast<uint32_t>(lexical_cast<DataRate>(minBw).GetBitRate()),
-                          static_cast<uint32_t>(lexical_cast<DataRate>(maxBw).GetBitRate())));
-
-  int32_t metric = std::max(1, static_cast<int32_t>(1.0 * m_referenceOspfRate.GetBitRate()
-                                                    / randBandwidth.GetBitRate()));
-
-  Time randDelay =
-    Time::FromDouble((m_randVar->GetValue(lexical_cast<Time>(minDelay).ToDouble(Time::US),
-                                          lexical_cast<Time>(maxDelay).ToDouble(Time::US))),
-                     Time::US);
-
-  uint32_t queue = ceil(averageRtt * (randBandwidth.GetBitRate() / 8.0 / 1100.0));
+namespace {
 
-  link.SetAttribute("DataRate", boost::lexical_cast<string>(randBandwidth));
-  link.SetAttribute("OSPF", boost::lexical_cast<string>(metric));
-  link.SetAttribute("Delay",
-                    boost::lexical_cast<string>(ceil(randDelay.ToDouble(Time::US))) + "us");
-  link.SetAttribute("MaxPackets", boost::lexical_cast<string>(queue));
+const size_t LINES_PER_THREAD = 4096;
 
-  AddLink(link);
-}
+struct MapLine {
+  string uid; // empty if the line does not add a node
+  vector<string> neighbors;
+  vector<string> warnings;
+};
 
-// NodeContainer
+// runs in parser threads, so it must not log
 void
-RocketfuelMapReader::GenerateFromMapsFile(int argc, char* argv[])
-{
-  string uid;
-  string loc;
-  string ptr;
-  string name;
-  string nuid;
-  // bool dns = false;
-  // bool bb = false;
-  int num_neigh_s = 0;
-  unsigned int num_neigh = 0;
-  int radius = 0;
-  vector<string> neigh_list;
-
-  uid = argv[0];
-  loc = argv[1];
-
-  // if (argv[2])
-  // {
-  //   dns = true;
-  // }
+parseMapLine(string line, regex_t& regex, MapLine& result)
+{
+  regmatch_t regmatch[REGMATCH_MAX];
+  if (regexec(&regex, line.c_str(), REGMATCH_MAX, regmatch, 0) == REG_NOMATCH) {
+    result.warnings.push_back("match failed (maps file): %s" + line);
+    return;
+  }
 
-  // if (argv[3])
-  // {
-  //   bb = true;
-  // }
+  const char* argv[REGMATCH_MAX];
+  /* regmatch[0] is the entire strings that matched */
+  for (int i = 1; i < REGMATCH_MAX; i++) {
+    if (regmatch[i].rm_so == -1) {
+      argv[i - 1] = NULL;
+    }
+    else {
+      line[regmatch[i].rm_eo] = '\0';
+      argv[i - 1] = &line[regmatch[i].rm_so];
+    }
+  }
 
-  num_neigh_s = ::atoi(argv[4]);
+  unsigned int num_neigh = 0;
+  int num_neigh_s = ::atoi(argv[4]);
   if (num_neigh_s < 0) {
-    num_neigh = 0;
-    NS_LOG_WARN("Negative number of neighbors given");
+    result.warnings.push_back("Negative number of neighbors given");
   }
   else {
     num_neigh = num_neigh_s;
@@ -166,37 +151,183 @@ RocketfuelMapReader::GenerateFromMapsFile(int argc, char* argv[])
   /* neighbors */
   if (argv[6]) {
     char* nbr;
-    char* stringp = argv[6];
+    char* stringp = const_cast<char*>(argv[6]);
     while ((nbr = strsep(&stringp, " \t")) != NULL) {
-      nbr[strlen(nbr) - 1] = '\0';
-      neigh_list.push_back(nbr + 1);
+      size_t length = strlen(nbr);
+      // without < and >; empty names are counted, but do not add links
+      result.neighbors.push_back(length < 2 ? string() : string(nbr + 1, length - 2));
     }
   }
 
-  if (num_neigh != neigh_list.size()) {
-    NS_LOG_WARN("Given number of neighbors = " << num_neigh << " != size of neighbors list = "
-                                               << neigh_list.size());
+  if (num_neigh != result.neighbors.size()) {
+    result.warnings.push_back("Given number of neighbors = " + boost::lexical_cast<string>(num_neigh)
+                              + " != size of neighbors list = "
+                              + boost::lexical_cast<string>(result.neighbors.size()));
   }
 
-  /* externs */
-  if (argv[7]) {
-    //      euid = argv[7];
+  int radius = ::atoi(&argv[9][1]);
+  if (radius > 0) {
+    result.neighbors.clear();
+    return;
   }
 
-  /* name */
-  if (argv[8]) {
-    name = argv[8];
-  }
+  result.uid = argv[0];
+}
 
-  radius = ::atoi(&argv[9][1]);
-  if (radius > 0) {
+void
+parseMapLines(const vector<string>& lines, size_t begin, size_t end, vector<MapLine>& results)
+{
+  regex_t regex;
+  int ret = regcomp(&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
+  if (ret != 0) {
+    char errbuf[512];
+    regerror(ret, &regex, errbuf, sizeof(errbuf));
+    regfree(&regex);
+    for (size_t i = begin; i < end; i++) {
+      results[i].warnings.push_back(errbuf);
+    }
     return;
   }
 
-  // Create node and link
-  if (uid.empty())
-    return;
+  for (size_t i = begin; i < end; i++) {
+    parseMapLine(lines[i], regex, results[i]);
+  }
+  regfree(&regex);
+}
+
+uint64_t
+fnv1a(const std::string& data)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : data) {
+    hash = (hash ^ c) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+// A cache file is MAGIC and FORMAT_VERSION followed by the cache key, whether
+// ConnectBackboneRouters created a random variable, the nodes (name, type, color) and the
+// links (node indices, DataRate, OSPF, Delay, MaxPackets).
+// Strings are a uint32_t length followed by the characters; numbers are in host order.
+const char MAGIC[8] = {'R', 'F', 'T', 'O', 'P', 'O', 'L', '\0'};
+const uint32_t FORMAT_VERSION = 1;
+
+template<typename T>
+void
+writeValue(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+writeString(std::ostream& os, const std::string& str)
+{
+  writeValue(os, static_cast<uint32_t>(str.size()));
+  os.write(str.data(), str.size());
+}
+
+// reads from a memory-mapped cache file, failing on truncated content
+struct CacheReader {
+  const char* pos;
+  const char* end;
+
+  template<typename T>
+  bool
+  readValue(T& value)
+  {
+    if (static_cast<size_t>(end - pos) < sizeof(value))
+      return false;
+    std::memcpy(&value, pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+  }
 
+  bool
+  readString(std::string& str)
+  {
+    uint32_t size;
+    if (!readValue(size) || static_cast<size_t>(end - pos) < size)
+      return false;
+    str.assign(pos, size);
+    pos += size;
+    return true;
+  }
+};
+
+} // namespace
+
+int64_t
+RocketfuelMapReader::AssignStreams(int64_t stream)
+{
+  m_randVar->SetStream(stream);
+  m_stream = stream;
+  return 2;
+}
+
+void
+RocketfuelMapReader::SetCacheDirectory(const std::string& directory)
+{
+  m_cacheDirectory = directory;
+}
+
+bool
+RocketfuelMapReader::IsLoadedFromCache() const
+{
+  return m_isLoadedFromCache;
+}
+
+double
+RocketfuelMapReader::GetLoadTime() const
+{
+  return m_loadTime;
+}
+
+void
+RocketfuelMapReader::ParseMap(const std::string& map)
+{
+  vector<string> lines;
+  size_t lineStart = 0;
+  while (lineStart <= map.size()) {
+    size_t lineEnd = std::min(map.find('\n', lineStart), map.size());
+    lines.push_back(map.substr(lineStart, lineEnd - lineStart));
+    lineStart = lineEnd + 1;
+  }
+
+  // lines are matched in parallel, but added to the graph in order so that vertex indices
+  // do not depend on the number of threads
+  vector<MapLine> results(lines.size());
+  size_t nThreads = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                                     (lines.size() + LINES_PER_THREAD - 1) / LINES_PER_THREAD);
+  if (nThreads <= 1) {
+    parseMapLines(lines, 0, lines.size(), results);
+  }
+  else {
+    vector<std::thread> threads;
+    size_t chunk = (lines.size() + nThreads - 1) / nThreads;
+    for (size_t begin = 0; begin < lines.size(); begin += chunk) {
+      threads.emplace_back(&parseMapLines, std::cref(lines), begin,
+                           std::min(begin + chunk, lines.size()), std::ref(results));
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+  NS_LOG_DEBUG("Parsed " << lines.size() << " lines with " << std::max<size_t>(nThreads, 1)
+                         << " threads");
+
+  for (const MapLine& result : results) {
+    for (const string& warning : result.warnings) {
+      NS_LOG_WARN(warning);
+    }
+    if (!result.uid.empty()) {
+      AddMapNode(result.uid, result.neighbors);
+    }
+  }
+}
+
+void
+RocketfuelMapReader::AddMapNode(const string& uid, const vector<string>& neighbors)
+{
   node_map_t::iterator node = m_graphNodes.find(uid);
   if (node == m_graphNodes.end()) {
     bool ok;
@@ -207,9 +338,7 @@ RocketfuelMapReader::GenerateFromMapsFile(int argc, char* argv[])
     m_maxNodeId++;
   }
 
-  for (uint32_t i = 0; i < neigh_list.size(); ++i) {
-    nuid = neigh_list[i];
-
+  for (const string& nuid : neighbors) {
     if (nuid.empty()) {
       continue;
     }
@@ -225,12 +354,44 @@ RocketfuelMapReader::GenerateFromMapsFile(int argc, char* argv[])
       m_maxNodeId++;
     }
 
-    // cout << node->second << " <-> " << otherNode->second << endl;
     // parallel edges are disabled in the graph, so no need to worry
     add_edge(node->second, otherNode->second, m_graph);
   }
 }
 
+RocketfuelMapReader::LinkClass::LinkClass(const string& minBw, const string& maxBw,
+                                          const string& minDelay, const string& maxDelay)
+  : minBitRate(static_cast<uint32_t>(lexical_cast<DataRate>(minBw).GetBitRate()))
+  , maxBitRate(static_cast<uint32_t>(lexical_cast<DataRate>(maxBw).GetBitRate()))
+  , minDelayUs(lexical_cast<Time>(minDelay).ToDouble(Time::US))
+  , maxDelayUs(lexical_cast<Time>(maxDelay).ToDouble(Time::US))
+{
+}
+
+RocketfuelMapReader::Topology::LinkInfo
+RocketfuelMapReader::CreateLink(uint32_t from, uint32_t to, double averageRtt,
+                                const LinkClass& linkClass)
+{
+  DataRate randBandwidth(m_randVar->GetInteger(linkClass.minBitRate, linkClass.maxBitRate));
+
+  int32_t metric = std::max(1, static_cast<int32_t>(1.0 * m_referenceOspfRate.GetBitRate()
+                                                    / randBandwidth.GetBitRate()));
+
+  Time randDelay =
+    Time::FromDouble(m_randVar->GetValue(linkClass.minDelayUs, linkClass.maxDelayUs), Time::US);
+
+  uint32_t queue = ceil(averageRtt * (randBandwidth.GetBitRate() / 8.0 / 1100.0));
+
+  Topology::LinkInfo link;
+  link.from = from;
+  link.to = to;
+  link.dataRate = boost::lexical_cast<string>(randBandwidth);
+  link.metric = boost::lexical_cast<string>(metric);
+  link.delay = boost::lexical_cast<string>(ceil(randDelay.ToDouble(Time::US))) + "us";
+  link.maxPackets = boost::lexical_cast<string>(queue);
+  return link;
+}
+
 void
 RocketfuelMapReader::assignGw(Traits::vertex_descriptor vertex, uint32_t degree,
                               node_type_t nodeType)
@@ -268,154 +429,206 @@ NodeContainer
 RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true*/,
                           bool connectBackbones /*=true*/)
 {
+  auto startTime = std::chrono::steady_clock::now();
   m_maxNodeId = 0;
+  m_isLoadedFromCache = false;
 
   ifstream topgen;
-  topgen.open(GetFileName().c_str());
+  topgen.open(GetFileName().c_str(), ios_base::in | ios_base::binary);
   // NodeContainer nodes;
 
-  istringstream lineBuffer;
-  string line;
-  int lineNumber = 0;
-  char errbuf[512];
-
   if (!topgen.is_open()) {
     NS_LOG_WARN("Couldn't open the file " << GetFileName());
     std::cout<<"Couldn't open the file " << GetFileName();
     return m_nodes;
   }
 
-  while (!topgen.eof()) {
-    int ret;
-    int argc;
-    char* argv[REGMATCH_MAX];
-    char* buf;
+  std::string map((std::istreambuf_iterator<char>(topgen)), std::istreambuf_iterator<char>());
+
+  Topology topology;
+  std::string cacheKey;
+  std::string cacheFile;
+  if (!m_cacheDirectory.empty() && m_stream < 0) {
+    NS_LOG_WARN("Topology cache is not used without AssignStreams()");
+  }
+  else if (!m_cacheDirectory.empty()) {
+    cacheKey = GetCacheKey(map, params, keepOneComponent, connectBackbones);
+    std::ostringstream os;
+    os << m_cacheDirectory << "/rocketfuel-" << std::hex << std::setw(16) << std::setfill('0')
+       << fnv1a(cacheKey) << ".bin";
+    cacheFile = os.str();
+    m_isLoadedFromCache = LoadCache(cacheFile, cacheKey, topology);
+  }
 
-    lineNumber++;
-    line.clear();
-    lineBuffer.clear();
+  if (m_isLoadedFromCache) {
+    RestoreGraph(topology);
+    if (topology.hasBackboneRandomVariable) {
+      // keep the stream numbers of random variables created after this reader unchanged
+      CreateObject<UniformRandomVariable>();
+    }
+  }
+  else {
+    ParseMap(map);
 
-    getline(topgen, line);
-    buf = (char*)line.c_str();
+    if (keepOneComponent) {
+      NS_LOG_DEBUG("Before eliminating disconnected nodes: " << num_vertices(m_graph));
+      KeepOnlyBiggestConnectedComponent();
+      NS_LOG_DEBUG("After eliminating disconnected nodes:  " << num_vertices(m_graph));
+    }
 
-    regmatch_t regmatch[REGMATCH_MAX];
-    regex_t regex;
+    for (int clientDegree = 1; clientDegree <= params.clientNodeDegrees; clientDegree++) {
+      AssignClients(clientDegree, std::min(clientDegree, 3));
+    }
 
-    ret = regcomp(&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
-    if (ret != 0) {
-      regerror(ret, &regex, errbuf, sizeof(errbuf));
-      regfree(&regex);
-      continue;
+    graph_traits<Graph>::vertex_iterator v, endv;
+    for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
+      node_type_t type = get(vertex_rank, m_graph, *v);
+      if (type == UNKNOWN) {
+        put(vertex_rank, m_graph, *v, BACKBONE);
+        put(vertex_color, m_graph, *v, "blue");
+      }
     }
 
-    ret = regexec(&regex, buf, REGMATCH_MAX, regmatch, 0);
-    if (ret == REG_NOMATCH) {
-      NS_LOG_WARN("match failed (maps file): %s" << buf);
-      regfree(&regex);
-      continue;
+    topology.hasBackboneRandomVariable = false;
+    if (connectBackbones) {
+      topology.hasBackboneRandomVariable = ConnectBackboneRouters();
     }
 
-    line = buf;
-    argc = 0;
+    graph_traits<Graph>::edge_iterator e, ende;
+    for (tie(e, ende) = edges(m_graph); e != ende;) {
+      Traits::vertex_descriptor u = source(*e, m_graph), v = target(*e, m_graph);
+
+      node_type_t u_type = get(vertex_rank, m_graph, u), v_type = get(vertex_rank, m_graph, v);
 
-    /* regmatch[0] is the entire strings that matched */
-    for (int i = 1; i < REGMATCH_MAX; i++) {
-      if (regmatch[i].rm_so == -1) {
-        argv[i - 1] = NULL;
+      if (u_type == BACKBONE && v_type == BACKBONE) {
+        // ok
+      }
+      else if ((u_type == GATEWAY && v_type == BACKBONE)
+               || (u_type == BACKBONE && v_type == GATEWAY)) {
+        // ok
+      }
+      else if (u_type == GATEWAY && v_type == GATEWAY) {
+        // ok
+      }
+      else if ((u_type == GATEWAY && v_type == CLIENT) || (u_type == CLIENT && v_type == GATEWAY)) {
+        // ok
       }
       else {
-        line[regmatch[i].rm_eo] = '\0';
-        argv[i - 1] = &line[regmatch[i].rm_so];
-        argc = i;
+        // not ok
+        NS_LOG_DEBUG("Wrong link type between nodes: " << u_type << " <-> " << v_type
+                                                       << " (deleting the link)");
+
+        graph_traits<Graph>::edge_iterator tmp = e;
+        tmp++;
+
+        remove_edge(*e, m_graph);
+        e = tmp;
+        continue;
       }
+      e++;
     }
 
-    GenerateFromMapsFile(argc, argv);
-    regfree(&regex);
-  }
+    if (keepOneComponent) {
+      NS_LOG_DEBUG("Before 2 eliminating disconnected nodes: " << num_vertices(m_graph));
+      KeepOnlyBiggestConnectedComponent();
+      NS_LOG_DEBUG("After 2 eliminating disconnected nodes:  " << num_vertices(m_graph));
+    }
 
-  if (keepOneComponent) {
-    NS_LOG_DEBUG("Before eliminating disconnected nodes: " << num_vertices(m_graph));
-    KeepOnlyBiggestConnectedComponent();
-    NS_LOG_DEBUG("After eliminating disconnected nodes:  " << num_vertices(m_graph));
-  }
+    EstimateLinks(params, topology);
 
-  for (int clientDegree = 1; clientDegree <= params.clientNodeDegrees; clientDegree++) {
-    AssignClients(clientDegree, std::min(clientDegree, 3));
+    if (!cacheFile.empty()) {
+      SaveCache(cacheFile, cacheKey, topology);
+    }
   }
 
+  BuildTopology(topology);
+  ApplySettings();
+
+  m_loadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+  NS_LOG_INFO("Clients:   " << m_customerRouters.GetN());
+  NS_LOG_INFO("Gateways:  " << m_gatewayRouters.GetN());
+  NS_LOG_INFO("Backbones: " << m_backboneRouters.GetN());
+  NS_LOG_INFO("Links:     " << GetLinks().size());
+  NS_LOG_INFO("Loaded " << (m_isLoadedFromCache ? "from cache " + cacheFile : "from the map")
+                        << " in " << m_loadTime << " s");
+
+  return m_nodes;
+}
+
+void
+RocketfuelMapReader::EstimateLinks(const RocketfuelParams& params, Topology& topology)
+{
+  static const char* const PREFIXES[] = {"", "leaf-", "gw-", "bb-"};
+
+  std::map<Traits::vertex_descriptor, uint32_t> indices;
   graph_traits<Graph>::vertex_iterator v, endv;
   for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
     node_type_t type = get(vertex_rank, m_graph, *v);
     if (type == UNKNOWN) {
-      put(vertex_rank, m_graph, *v, BACKBONE);
-      put(vertex_color, m_graph, *v, "blue");
+      NS_FATAL_ERROR("Should not happen");
     }
-  }
 
-  if (connectBackbones) {
-    ConnectBackboneRouters();
+    string nodeName = PREFIXES[type] + get(vertex_name, m_graph, *v);
+    put(vertex_name, m_graph, *v, nodeName);
+
+    indices[*v] = topology.nodes.size();
+    topology.nodes.push_back({nodeName, type, get(vertex_color, m_graph, *v)});
   }
 
+  // parameter strings are parsed once rather than for each link
+  LinkClass b2b(params.minb2bBandwidth, params.maxb2bBandwidth, params.minb2bDelay,
+                params.maxb2bDelay);
+  LinkClass b2g(params.minb2gBandwidth, params.maxb2gBandwidth, params.minb2gDelay,
+                params.maxb2gDelay);
+  LinkClass g2c(params.ming2cBandwidth, params.maxg2cBandwidth, params.ming2cDelay,
+                params.maxg2cDelay);
+
   graph_traits<Graph>::edge_iterator e, ende;
-  for (tie(e, ende) = edges(m_graph); e != ende;) {
+  for (tie(e, ende) = edges(m_graph); e != ende; e++) {
     Traits::vertex_descriptor u = source(*e, m_graph), v = target(*e, m_graph);
 
     node_type_t u_type = get(vertex_rank, m_graph, u), v_type = get(vertex_rank, m_graph, v);
 
+    const LinkClass* linkClass = nullptr;
     if (u_type == BACKBONE && v_type == BACKBONE) {
-      // ok
+      linkClass = &b2b;
     }
     else if ((u_type == GATEWAY && v_type == BACKBONE)
              || (u_type == BACKBONE && v_type == GATEWAY)) {
-      // ok
+      linkClass = &b2g;
     }
     else if (u_type == GATEWAY && v_type == GATEWAY) {
-      // ok
+      linkClass = &b2g;
     }
     else if ((u_type == GATEWAY && v_type == CLIENT) || (u_type == CLIENT && v_type == GATEWAY)) {
-      // ok
+      linkClass = &g2c;
     }
     else {
-      // not ok
-      NS_LOG_DEBUG("Wrong link type between nodes: " << u_type << " <-> " << v_type
-                                                     << " (deleting the link)");
-
-      graph_traits<Graph>::edge_iterator tmp = e;
-      tmp++;
-
-      remove_edge(*e, m_graph);
-      e = tmp;
-      continue;
+      NS_FATAL_ERROR("Wrong link type between nodes: " << u_type << " <-> " << v_type);
     }
-    e++;
-  }
 
-  if (keepOneComponent) {
-    NS_LOG_DEBUG("Before 2 eliminating disconnected nodes: " << num_vertices(m_graph));
-    KeepOnlyBiggestConnectedComponent();
-    NS_LOG_DEBUG("After 2 eliminating disconnected nodes:  " << num_vertices(m_graph));
+    topology.links.push_back(CreateLink(indices[u], indices[v], params.averageRtt, *linkClass));
   }
+}
 
-  for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
-    string nodeName = get(vertex_name, m_graph, *v);
-    Ptr<Node> node = CreateNode(nodeName, 0);
+void
+RocketfuelMapReader::BuildTopology(const Topology& topology)
+{
+  vector<Ptr<Node>> nodes;
+  nodes.reserve(topology.nodes.size());
+  for (const Topology::NodeInfo& info : topology.nodes) {
+    Ptr<Node> node = CreateNode(info.name, 0);
+    nodes.push_back(node);
 
-    node_type_t type = get(vertex_rank, m_graph, *v);
-    switch (type) {
+    switch (info.type) {
     case BACKBONE:
-      Names::Rename(nodeName, "bb-" + nodeName);
-      put(vertex_name, m_graph, *v, "bb-" + nodeName);
       m_backboneRouters.Add(node);
       break;
     case CLIENT:
-      Names::Rename(nodeName, "leaf-" + nodeName);
-      put(vertex_name, m_graph, *v, "leaf-" + nodeName);
       m_customerRouters.Add(node);
       break;
     case GATEWAY:
-      Names::Rename(nodeName, "gw-" + nodeName);
-      put(vertex_name, m_graph, *v, "gw-" + nodeName);
       m_gatewayRouters.Add(node);
       break;
     case UNKNOWN:
@@ -424,43 +637,164 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     }
   }
 
-  for (tie(e, ende) = edges(m_graph); e != ende; e++) {
-    Traits::vertex_descriptor u = source(*e, m_graph), v = target(*e, m_graph);
+  for (const Topology::LinkInfo& info : topology.links) {
+    Link link(nodes[info.from], topology.nodes[info.from].name, nodes[info.to],
+              topology.nodes[info.to].name);
+    link.SetAttribute("DataRate", info.dataRate);
+    link.SetAttribute("OSPF", info.metric);
+    link.SetAttribute("Delay", info.delay);
+    link.SetAttribute("MaxPackets", info.maxPackets);
+    AddLink(link);
+  }
+}
 
-    node_type_t u_type = get(vertex_rank, m_graph, u), v_type = get(vertex_rank, m_graph, v);
+void
+RocketfuelMapReader::RestoreGraph(const Topology& topology)
+{
+  vector<Traits::vertex_descriptor> vertices;
+  vertices.reserve(topology.nodes.size());
+  for (const Topology::NodeInfo& info : topology.nodes) {
+    Traits::vertex_descriptor vertex = add_vertex(nodeProperty(info.name), m_graph);
+    put(vertex_index, m_graph, vertex, m_maxNodeId++);
+    put(vertex_rank, m_graph, vertex, info.type);
+    put(vertex_color, m_graph, vertex, info.color);
+    vertices.push_back(vertex);
+  }
 
-    string u_name = get(vertex_name, m_graph, u), v_name = get(vertex_name, m_graph, v);
+  for (const Topology::LinkInfo& info : topology.links) {
+    add_edge(vertices[info.from], vertices[info.to], m_graph);
+  }
+}
 
-    if (u_type == BACKBONE && v_type == BACKBONE) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2bBandwidth, params.maxb2bBandwidth,
-                 params.minb2bDelay, params.maxb2bDelay);
-    }
-    else if ((u_type == GATEWAY && v_type == BACKBONE)
-             || (u_type == BACKBONE && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
-    }
-    else if (u_type == GATEWAY && v_type == GATEWAY) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
-    }
-    else if ((u_type == GATEWAY && v_type == CLIENT) || (u_type == CLIENT && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.ming2cBandwidth, params.maxg2cBandwidth,
-                 params.ming2cDelay, params.maxg2cDelay);
-    }
-    else {
-      NS_FATAL_ERROR("Wrong link type between nodes: " << u_type << " <-> " << v_type);
-    }
+string
+RocketfuelMapReader::GetCacheKey(const std::string& map, const RocketfuelParams& params,
+                                 bool keepOneComponent, bool connectBackbones) const
+{
+  std::ostringstream os;
+  os << std::setprecision(17);
+  os << "map " << std::hex << fnv1a(map) << std::dec << " " << map.size() << "\n"
+     << "params " << params.clientNodeDegrees << " " << params.averageRtt << " "
+     << params.minb2bBandwidth << " " << params.minb2bDelay << " " << params.maxb2bBandwidth
+     << " " << params.maxb2bDelay << " " << params.minb2gBandwidth << " " << params.minb2gDelay
+     << " " << params.maxb2gBandwidth << " " << params.maxb2gDelay << " "
+     << params.ming2cBandwidth << " " << params.ming2cDelay << " " << params.maxg2cBandwidth
+     << " " << params.maxg2cDelay << "\n"
+     << "flags " << keepOneComponent << " " << connectBackbones << "\n"
+     << "ospf " << m_referenceOspfRate.GetBitRate() << "\n"
+     << "rng " << RngSeedManager::GetSeed() << " " << RngSeedManager::GetRun() << " "
+     << m_stream << "\n";
+  return os.str();
+}
+
+bool
+RocketfuelMapReader::LoadCache(const std::string& file, const std::string& key,
+                               Topology& topology)
+{
+  int fd = ::open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    NS_LOG_DEBUG("No cache file " << file);
+    return false;
   }
 
-  ApplySettings();
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || status.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
 
-  NS_LOG_INFO("Clients:   " << m_customerRouters.GetN());
-  NS_LOG_INFO("Gateways:  " << m_gatewayRouters.GetN());
-  NS_LOG_INFO("Backbones: " << m_backboneRouters.GetN());
-  NS_LOG_INFO("Links:     " << GetLinks().size());
+  size_t size = static_cast<size_t>(status.st_size);
+  void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    NS_LOG_WARN("Cannot map cache file " << file);
+    return false;
+  }
 
-  return m_nodes;
+  CacheReader reader{static_cast<const char*>(data), static_cast<const char*>(data) + size};
+
+  char magic[sizeof(MAGIC)];
+  uint32_t version = 0;
+  string fileKey;
+  uint8_t hasBackboneRandomVariable = 0;
+  uint32_t nNodes = 0;
+  bool isValid = reader.readValue(magic) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 reader.readValue(version) && version == FORMAT_VERSION &&
+                 reader.readString(fileKey) && fileKey == key &&
+                 reader.readValue(hasBackboneRandomVariable) && reader.readValue(nNodes);
+
+  topology.nodes.clear();
+  topology.links.clear();
+  for (uint32_t i = 0; isValid && i < nNodes; i++) {
+    Topology::NodeInfo node;
+    uint8_t type = 0;
+    isValid = reader.readString(node.name) && reader.readValue(type) &&
+              type >= CLIENT && type <= BACKBONE && reader.readString(node.color);
+    node.type = static_cast<node_type_t>(type);
+    topology.nodes.push_back(std::move(node));
+  }
+
+  uint32_t nLinks = 0;
+  isValid = isValid && reader.readValue(nLinks);
+  for (uint32_t i = 0; isValid && i < nLinks; i++) {
+    Topology::LinkInfo link;
+    isValid = reader.readValue(link.from) && reader.readValue(link.to) && link.from < nNodes &&
+              link.to < nNodes && reader.readString(link.dataRate) &&
+              reader.readString(link.metric) && reader.readString(link.delay) &&
+              reader.readString(link.maxPackets);
+    topology.links.push_back(std::move(link));
+  }
+  topology.hasBackboneRandomVariable = hasBackboneRandomVariable != 0;
+
+  ::munmap(data, size);
+
+  if (!isValid || reader.pos != reader.end) {
+    NS_LOG_WARN("Ignoring stale or corrupt cache file " << file);
+    topology.nodes.clear();
+    topology.links.clear();
+    return false;
+  }
+  return true;
+}
+
+void
+RocketfuelMapReader::SaveCache(const std::string& file, const std::string& key,
+                               const Topology& topology)
+{
+  // written aside and renamed, so that concurrent runs never map a partial file
+  std::string tmpFile = file + "." + boost::lexical_cast<string>(::getpid()) + ".tmp";
+  ofstream os(tmpFile.c_str(), ios_base::out | ios_base::trunc | ios_base::binary);
+  if (!os.is_open()) {
+    NS_LOG_WARN("Cannot write cache file " << tmpFile);
+    return;
+  }
+
+  os.write(MAGIC, sizeof(MAGIC));
+  writeValue(os, FORMAT_VERSION);
+  writeString(os, key);
+  writeValue(os, static_cast<uint8_t>(topology.hasBackboneRandomVariable));
+
+  writeValue(os, static_cast<uint32_t>(topology.nodes.size()));
+  for (const Topology::NodeInfo& node : topology.nodes) {
+    writeString(os, node.name);
+    writeValue(os, static_cast<uint8_t>(node.type));
+    writeString(os, node.color);
+  }
+
+  writeValue(os, static_cast<uint32_t>(topology.links.size()));
+  for (const Topology::LinkInfo& link : topology.links) {
+    writeValue(os, link.from);
+    writeValue(os, link.to);
+    writeString(os, link.dataRate);
+    writeString(os, link.metric);
+    writeString(os, link.delay);
+    writeString(os, link.maxPackets);
+  }
+
+  os.close();
+  if (!os || std::rename(tmpFile.c_str(), file.c_str()) != 0) {
+    NS_LOG_WARN("Cannot write cache file " << file);
+    std::remove(tmpFile.c_str());
+  }
 }
 
 const NodeContainer&
@@ -658,7 +992,7 @@ RocketfuelMapReader::KeepOnlyBiggestConnectedComponent()
   }
 }
 
-void
+bool
 RocketfuelMapReader::ConnectBackboneRouters()
 {
   // not the tricky part.  we want backbone to be a fully connected component,
@@ -700,7 +1034,7 @@ RocketfuelMapReader::ConnectBackboneRouters()
   int num = connected_components(bbGraph, components);
   NS_LOG_DEBUG("Backbone has " << num << " components");
   if (num == 1)
-    return; // nothing to do
+    return false; // nothing to do
 
   vector<vector<graph_traits<BbGraph>::vertex_descriptor>> subgraphs(num);
   for (tie(bb, endBb) = vertices(bbGraph); bb != endBb; bb++) {
@@ -709,6 +1043,9 @@ RocketfuelMapReader::ConnectBackboneRouters()
   }
 
   Ptr<UniformRandomVariable> randVar = CreateObject<UniformRandomVariable>();
+  if (m_stream >= 0) {
+    randVar->SetStream(m_stream + 1);
+  }
 
   for (int i = 1; i < num; i++) {
     int node1 = randVar->GetInteger(0, subgraphs[i - 1].size() - 1);
@@ -722,6 +1059,7 @@ RocketfuelMapReader::ConnectBackboneRouters()
 
     add_edge(v1, v2, m_graph);
   }
+  return true;
 }
 
 } /* namespace ns3 */
@@ -28,6 +28,7 @@
 #include "ns3/data-rate.h"
 
 #include <set>
+#include <vector>
 #include <boost/graph/adjacency_list.hpp>
 
 using namespace std;
@@ -76,6 +77,14 @@ struct RocketfuelParams {
  * As some of the .cch files do not give a connected network graph, this reader also allows to keep
  *only the largest connected
  * network graph component.
+ *
+ * Map lines are parsed by several threads.  With SetCacheDirectory(), the estimated topology
+ * (nodes with their roles, links with their bandwidth, metric, delay and queue) is also saved
+ * to a binary file keyed by the map contents, RocketfuelParams, Read() flags, OSPF reference
+ * rate, and RNG seed, run and the streams given to AssignStreams().  Later reads of the same
+ * topology map that file instead of parsing and estimating again, and build the same nodes and
+ * links.  Without AssignStreams(), link parameters depend on how many random variables the
+ * program created before, so the cache is not used.
  */
 class RocketfuelMapReader : public AnnotatedTopologyReader {
 public:
@@ -124,29 +133,115 @@ public:
   virtual void
   SaveGraphviz(const std::string& file);
 
+  /**
+   * @brief Assign fixed random variable streams to link estimation, starting at stream
+   *
+   * @return the number of streams used (2)
+   */
+  int64_t
+  AssignStreams(int64_t stream);
+
+  /**
+   * @brief Set the directory of topology cache files (empty: no cache, the default)
+   *
+   * Cache files are only used after AssignStreams()
+   */
+  void
+  SetCacheDirectory(const std::string& directory);
+
+  /**
+   * @brief Whether the last Read() used a cache file
+   */
+  bool
+  IsLoadedFromCache() const;
+
+  /**
+   * @brief Wall-clock seconds taken by the last Read(), including node and link creation
+   */
+  double
+  GetLoadTime() const;
+
 private:
   RocketfuelMapReader(const RocketfuelMapReader&);
   RocketfuelMapReader&
   operator=(const RocketfuelMapReader&);
 
-  // NodeContainer
+  enum node_type_t { UNKNOWN = 0, CLIENT = 1, GATEWAY = 2, BACKBONE = 3 };
+
+  /// estimated topology, as saved in cache files
+  struct Topology {
+    struct NodeInfo {
+      string name; // with the bb-, gw- or leaf- prefix
+      node_type_t type;
+      string color;
+    };
+
+    struct LinkInfo {
+      uint32_t from; // index in nodes
+      uint32_t to;
+      string dataRate;
+      string metric;
+      string delay;
+      string maxPackets;
+    };
+
+    vector<NodeInfo> nodes;
+    vector<LinkInfo> links;
+    bool hasBackboneRandomVariable; // whether ConnectBackboneRouters created one
+  };
+
+  /// range of link parameters, parsed once per Read()
+  struct LinkClass {
+    LinkClass(const string& minBw, const string& maxBw, const string& minDelay,
+              const string& maxDelay);
+
+    uint32_t minBitRate;
+    uint32_t maxBitRate;
+    double minDelayUs;
+    double maxDelayUs;
+  };
+
   void
-  GenerateFromMapsFile(int argc, char* argv[]);
+  ParseMap(const std::string& map);
 
   void
-  CreateLink(string nodeName1, string nodeName2, double averageRtt, const string& minBw,
-             const string& maxBw, const string& minDelay, const string& maxDelay);
+  AddMapNode(const string& uid, const vector<string>& neighbors);
+
+  void
+  EstimateLinks(const RocketfuelParams& params, Topology& topology);
+
+  Topology::LinkInfo
+  CreateLink(uint32_t from, uint32_t to, double averageRtt, const LinkClass& linkClass);
+
+  void
+  BuildTopology(const Topology& topology);
+
+  void
+  RestoreGraph(const Topology& topology);
+
+  string
+  GetCacheKey(const std::string& map, const RocketfuelParams& params, bool keepOneComponent,
+              bool connectBackbones) const;
+
+  static bool
+  LoadCache(const std::string& file, const std::string& key, Topology& topology);
+
+  static void
+  SaveCache(const std::string& file, const std::string& key, const Topology& topology);
+
   void
   KeepOnlyBiggestConnectedComponent();
 
   void
   AssignClients(uint32_t clientDegree, uint32_t gwDegree);
 
-  void
+  /// @return whether a random variable was created to connect backbone components
+  bool
   ConnectBackboneRouters();
 
 private:
   Ptr<UniformRandomVariable> m_randVar;
+  int64_t m_stream; // first assigned stream, -1 if none
 
   NodeContainer m_backboneRouters;
   NodeContainer m_gatewayRouters;
@@ -154,8 +249,6 @@ private:
 
   typedef boost::adjacency_list_traits<boost::setS, boost::setS, boost::undirectedS> Traits;
 
-  enum node_type_t { UNKNOWN = 0, CLIENT = 1, GATEWAY = 2, BACKBONE = 3 };
-
   typedef boost::
     property<boost::vertex_name_t, std::string,
              boost::property<boost::vertex_index_t, uint32_t,
@@ -176,6 +269,10 @@ private:
 
   const DataRate m_referenceOspfRate; // reference rate of OSPF metric calculation
 
+  std::string m_cacheDirectory;
+  bool m_isLoadedFromCache;
+  double m_loadTime;
+
 private:
   void
   assignGw(Traits::vertex_descriptor vertex, uint32_t degree, node_type_t nodeType);
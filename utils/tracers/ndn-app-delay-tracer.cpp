@@ -28,6 +28,7 @@
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
+#include "ns3/string.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
@@ -45,11 +46,17 @@ static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTrac
 void
 AppDelayTracer::Destroy()
 {
+  for (const auto& streamTracers : g_tracers) {
+    for (const Ptr<AppDelayTracer>& tracer : std::get<1>(streamTracers)) {
+      tracer->FlushAggregates();
+    }
+  }
   g_tracers.clear();
 }
 
 void
-AppDelayTracer::InstallAll(const std::string& file)
+AppDelayTracer::InstallAll(const std::string& file, Aggregation aggregation /* = AGGREGATE_NONE*/,
+                           Time period /* = Seconds(1.0)*/)
 {
   using namespace boost;
   using namespace std;
@@ -72,7 +79,7 @@ AppDelayTracer::InstallAll(const std::string& file)
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream, aggregation, period);
     tracers.push_back(trace);
   }
 
@@ -86,7 +93,9 @@ AppDelayTracer::InstallAll(const std::string& file)
 }
 
 void
-AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        Aggregation aggregation /* = AGGREGATE_NONE*/,
+                        Time period /* = Seconds(1.0)*/)
 {
   using namespace boost;
   using namespace std;
@@ -109,7 +118,7 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream, aggregation, period);
     tracers.push_back(trace);
   }
 
@@ -123,7 +132,9 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
 }
 
 void
-AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+AppDelayTracer::Install(Ptr<Node> node, const std::string& file,
+                        Aggregation aggregation /* = AGGREGATE_NONE*/,
+                        Time period /* = Seconds(1.0)*/)
 {
   using namespace boost;
   using namespace std;
@@ -145,7 +156,7 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
+  Ptr<AppDelayTracer> trace = Install(node, outputStream, aggregation, period);
   tracers.push_back(trace);
 
   if (tracers.size() > 0) {
@@ -158,11 +169,14 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
 }
 
 Ptr<AppDelayTracer>
-AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                        Aggregation aggregation /* = AGGREGATE_NONE*/,
+                        Time period /* = Seconds(1.0)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
   Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node);
+  trace->SetAggregation(aggregation, period);
 
   return trace;
 }
@@ -174,6 +188,7 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_aggregation(AGGREGATE_NONE)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,11 +203,29 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_aggregation(AGGREGATE_NONE)
 {
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  m_printEvent.Cancel();
+  m_flushEvent.Cancel();
+}
+
+void
+AppDelayTracer::SetAggregation(Aggregation aggregation, const Time& period)
+{
+  m_aggregation = aggregation;
+  m_period = period;
+  m_printEvent.Cancel();
+  m_flushEvent.Cancel();
+  if (m_aggregation != AGGREGATE_NONE) {
+    m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+    m_flushEvent = Simulator::ScheduleDestroy(&AppDelayTracer::PrintAggregates, this);
+  }
+}
 
 void
 AppDelayTracer::Connect()
@@ -209,6 +242,11 @@ AppDelayTracer::Connect()
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
+  if (m_aggregation != AGGREGATE_NONE) {
+    os << "Time\tNode\tGroup\tType\tCount\tMean\tMin\tP50\tP90\tP99\tMax";
+    return;
+  }
+
   os << "Time"
      << "\t"
      << "Node"
@@ -230,10 +268,93 @@ AppDelayTracer::PrintHeader(std::ostream& os) const
      << "";
 }
 
+AppDelayTracer::Group&
+AppDelayTracer::GetGroup(Ptr<App> app)
+{
+  auto i = m_appGroups.find(app->GetId());
+  if (i != m_appGroups.end())
+    return m_groups[i->second];
+
+  std::string name;
+  switch (m_aggregation) {
+  case AGGREGATE_PREFIX: {
+    StringValue prefix("-");
+    app->GetAttributeFailSafe("Prefix", prefix);
+    name = prefix.Get();
+    break;
+  }
+  case AGGREGATE_APP:
+    name = boost::lexical_cast<std::string>(app->GetId());
+    break;
+  default:
+    name = "all";
+    break;
+  }
+
+  size_t index = 0;
+  while (index < m_groups.size() && m_groups[index].name != name) {
+    ++index;
+  }
+  if (index == m_groups.size()) {
+    m_groups.emplace_back();
+    m_groups.back().name = name;
+  }
+  m_appGroups[app->GetId()] = index;
+  return m_groups[index];
+}
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  PrintAggregates();
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::FlushAggregates()
+{
+  // expired once Simulator::Destroy() has run it, and never scheduled without aggregation
+  if (m_flushEvent.IsExpired())
+    return;
+
+  m_printEvent.Cancel();
+  m_flushEvent.Cancel();
+  PrintAggregates();
+}
+
+void
+AppDelayTracer::PrintAggregates()
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+  auto print = [&] (const std::string& group, const char* type, LogHistogram& histogram,
+                    double scale) {
+    if (histogram.GetCount() == 0)
+      return;
+
+    *m_os << time << "\t" << m_node << "\t" << group << "\t" << type << "\t"
+          << histogram.GetCount() << "\t" << histogram.GetMean() * scale << "\t"
+          << histogram.GetMin() * scale << "\t" << histogram.GetPercentile(50) * scale << "\t"
+          << histogram.GetPercentile(90) * scale << "\t"
+          << histogram.GetPercentile(99) * scale << "\t" << histogram.GetMax() * scale << "\n";
+    histogram.Reset();
+  };
+
+  for (Group& group : m_groups) {
+    print(group.name, "LastDelayUS", group.lastDelay, 0.001);
+    print(group.name, "FullDelayUS", group.fullDelay, 0.001);
+    print(group.name, "HopCount", group.hopCount, 1.0);
+  }
+}
+
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  if (m_aggregation != AGGREGATE_NONE) {
+    GetGroup(app).lastDelay.Record(std::max<int64_t>(delay.GetNanoSeconds(), 0));
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -245,6 +366,13 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  if (m_aggregation != AGGREGATE_NONE) {
+    Group& group = GetGroup(app);
+    group.fullDelay.Record(std::max<int64_t>(delay.GetNanoSeconds(), 0));
+    group.hopCount.Record(std::max<int32_t>(hopCount, 0));
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
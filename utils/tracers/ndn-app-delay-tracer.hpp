@@ -21,6 +21,7 @@
 #define CCNX_APP_DELAY_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-log-histogram.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -30,6 +31,8 @@
 
 #include <tuple>
 #include <list>
+#include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -43,53 +46,72 @@ class App;
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to obtain application-level delays
+ *
+ * By default the tracer writes a line per retrieved Data.  With aggregation, it instead
+ * records the delays and hop counts into LogHistograms and, every period, writes a line
+ * per group and quantity with the count, mean and percentiles (delays in microseconds).
+ * The statistics of the last (partial) period are written by Destroy(), or by
+ * Simulator::Destroy() for tracers that are still alive.
  */
 class AppDelayTracer : public SimpleRefCount<AppDelayTracer> {
 public:
+  enum Aggregation {
+    AGGREGATE_NONE,   ///< a line per retrieved Data
+    AGGREGATE_NODE,   ///< histograms of all applications of the node together
+    AGGREGATE_PREFIX, ///< histograms per application Prefix attribute
+    AGGREGATE_APP     ///< histograms per application
+  };
+
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param aggregation How to group retrieved Data
+   * @param period How often aggregated statistics are written (not used without aggregation)
    */
   static void
-  InstallAll(const std::string& file);
+  InstallAll(const std::string& file, Aggregation aggregation = AGGREGATE_NONE,
+             Time period = Seconds(1.0));
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param aggregation How to group retrieved Data
+   * @param period How often aggregated statistics are written (not used without aggregation)
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file);
+  Install(const NodeContainer& nodes, const std::string& file,
+          Aggregation aggregation = AGGREGATE_NONE, Time period = Seconds(1.0));
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   * @param averagingPeriod How often data will be written into the trace file (default, every half
-   *        second)
+   * @param aggregation How to group retrieved Data
+   * @param period How often aggregated statistics are written (not used without aggregation)
    */
   static void
-  Install(Ptr<Node> node, const std::string& file);
+  Install(Ptr<Node> node, const std::string& file, Aggregation aggregation = AGGREGATE_NONE,
+          Time period = Seconds(1.0));
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
    * @param outputStream Smart pointer to a stream
-   * @param averagingPeriod How often data will be written into the trace file (default, every half
-   *        second)
+   * @param aggregation How to group retrieved Data
+   * @param period How often aggregated statistics are written (not used without aggregation)
    *
    * @returns a tuple of reference to output stream and list of tracers.
    *          !!! Attention !!! This tuple needs to be preserved for the lifetime of simulation,
    *          otherwise SEGFAULTs are inevitable
    */
   static Ptr<AppDelayTracer>
-  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
+  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+          Aggregation aggregation = AGGREGATE_NONE, Time period = Seconds(1.0));
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -128,9 +150,35 @@ public:
   PrintHeader(std::ostream& os) const;
 
 private:
+  struct Group {
+    std::string name;
+    LogHistogram lastDelay; // nanoseconds
+    LogHistogram fullDelay; // nanoseconds
+    LogHistogram hopCount;
+  };
+
   void
   Connect();
 
+  void
+  SetAggregation(Aggregation aggregation, const Time& period);
+
+  Group&
+  GetGroup(Ptr<App> app);
+
+  void
+  PeriodicPrinter();
+
+  void
+  PrintAggregates();
+
+  /**
+   * @brief Write the statistics of the last (partial) period, unless Simulator::Destroy()
+   *        already did
+   */
+  void
+  FlushAggregates();
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -143,6 +191,13 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+
+  Aggregation m_aggregation;
+  Time m_period;
+  EventId m_printEvent;
+  EventId m_flushEvent; // PrintAggregates() from Simulator::Destroy()
+  std::vector<Group> m_groups;
+  std::map<uint32_t, size_t> m_appGroups; // application id => index in m_groups
 };
 
 } // namespace ndn
@@ -28,7 +28,9 @@
 
 #include "daemon/table/pit-entry.hpp"
 
+#include <cstring>
 #include <fstream>
+#include <map>
 #include <boost/lexical_cast.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
@@ -46,13 +48,14 @@ L3RateTracer::Destroy()
 }
 
 void
-L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                         Format format /* = FORMAT_TSV*/)
 {
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
 
     if (!os->is_open()) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
@@ -66,11 +69,14 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod, format);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (format == FORMAT_BINARY) {
+    WriteBinaryHeader(*outputStream);
+  }
+  else if (tracers.size() > 0) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -81,7 +87,7 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 
 void
 L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/, Format format /* = FORMAT_TSV*/)
 {
   using namespace boost;
   using namespace std;
@@ -90,7 +96,7 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
 
     if (!os->is_open()) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
@@ -104,11 +110,14 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod, format);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (format == FORMAT_BINARY) {
+    WriteBinaryHeader(*outputStream);
+  }
+  else if (tracers.size() > 0) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -119,7 +128,7 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
 
 void
 L3RateTracer::Install(Ptr<Node> node, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/, Format format /* = FORMAT_TSV*/)
 {
   using namespace boost;
   using namespace std;
@@ -128,7 +137,7 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
 
     if (!os->is_open()) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
@@ -141,10 +150,13 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
+  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod, format);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  if (format == FORMAT_BINARY) {
+    WriteBinaryHeader(*outputStream);
+  }
+  else if (tracers.size() > 0) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -155,11 +167,12 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
 
 Ptr<L3RateTracer>
 L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/, Format format /* = FORMAT_TSV*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
   Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node);
+  trace->m_format = format;
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
@@ -168,6 +181,8 @@ L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
+  , m_format(FORMAT_TSV)
+  , m_stats(1)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -175,6 +190,8 @@ L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
   , m_os(os)
+  , m_format(FORMAT_TSV)
+  , m_stats(1)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -184,6 +201,48 @@ L3RateTracer::~L3RateTracer()
   m_printEvent.Cancel();
 }
 
+L3RateTracer::FaceStats::FaceStats()
+  : m_isActive(false)
+  , m_isDescribed(false)
+  , m_faceId(nfd::INVALID_FACEID)
+{
+  for (Stats& stats : m_stats) {
+    stats.Reset();
+  }
+}
+
+L3RateTracer::FaceStats&
+L3RateTracer::GetStats(const Face& face)
+{
+  nfd::FaceId faceId = face.getId();
+  FaceStats* stats = nullptr;
+  if (faceId > nfd::FACEID_RESERVED_MAX) {
+    size_t slot = static_cast<size_t>(faceId - nfd::FACEID_RESERVED_MAX);
+    if (slot >= m_stats.size())
+      m_stats.resize(slot + 1);
+    stats = &m_stats[slot];
+  }
+  else {
+    for (FaceStats& other : m_otherStats) {
+      if (other.m_faceId == faceId) {
+        stats = &other;
+        break;
+      }
+    }
+    if (stats == nullptr) {
+      m_otherStats.emplace_back();
+      stats = &m_otherStats.back();
+    }
+  }
+
+  if (!stats->m_isActive) {
+    stats->m_isActive = true;
+    stats->m_faceId = faceId;
+    stats->m_description = face.getLocalUri().toString();
+  }
+  return *stats;
+}
+
 void
 L3RateTracer::SetAveragingPeriod(const Time& period)
 {
@@ -195,14 +254,20 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  UpdateRates();
+  if (m_format == FORMAT_BINARY)
+    WriteBinary(*m_os);
+  else
+    Print(*m_os);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
+namespace {
+
 void
-L3RateTracer::PrintHeader(std::ostream& os) const
+printTsvHeader(std::ostream& os)
 {
   os << "Time"
      << "\t"
@@ -225,135 +290,354 @@ L3RateTracer::PrintHeader(std::ostream& os) const
      << "KilobytesRaw";
 }
 
+} // namespace
+
+void
+L3RateTracer::PrintHeader(std::ostream& os) const
+{
+  printTsvHeader(os);
+}
+
+const L3RateTracer::Column L3RateTracer::FACE_COLUMNS[8] = {
+  {"InInterests", &Stats::m_inInterests},
+  {"OutInterests", &Stats::m_outInterests},
+
+  {"InData", &Stats::m_inData},
+  {"OutData", &Stats::m_outData},
+
+  {"InSatisfiedInterests", &Stats::m_satisfiedInterests},
+  {"InTimedOutInterests", &Stats::m_timedOutInterests},
+
+  {"OutSatisfiedInterests", &Stats::m_outSatisfiedInterests},
+  {"OutTimedOutInterests", &Stats::m_outTimedOutInterests}
+};
+
+const L3RateTracer::Column L3RateTracer::NODE_COLUMNS[2] = {
+  {"SatisfiedInterests", &Stats::m_satisfiedInterests},
+  {"TimedOutInterests", &Stats::m_timedOutInterests}
+};
+
 void
 L3RateTracer::Reset()
 {
   for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+    stats.m_stats[PACKETS].Reset();
+    stats.m_stats[BYTES].Reset();
+  }
+  for (auto& stats : m_otherStats) {
+    stats.m_stats[PACKETS].Reset();
+    stats.m_stats[BYTES].Reset();
   }
 }
 
 const double alpha = 0.8;
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
-
-#define PRINTER(printName, fieldName)                                                              \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
-                                                                                                   \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nullptr) {                                                                    \
-    os << stats.first->getId() << "\t" << stats.first->getLocalUri() << "\t";                      \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+void
+L3RateTracer::UpdateRates()
+{
+  double period = m_period.ToDouble(Time::S);
+  auto update = [period] (FaceStats& faceStats) {
+    Stats* stats = faceStats.m_stats;
+    for (const Column& column : FACE_COLUMNS) {
+      double Stats::*field = column.field;
+      stats[PACKET_RATE].*field = /*new value*/ alpha * (stats[PACKETS].*field / period)
+                                  + /*old value*/ (1 - alpha) * stats[PACKET_RATE].*field;
+      stats[KILOBYTE_RATE].*field = /*new value*/ alpha * (stats[BYTES].*field / period) / 1024.0
+                                    + /*old value*/ (1 - alpha) * stats[KILOBYTE_RATE].*field;
+    }
+  };
+
+  for (auto& stats : m_stats) {
+    update(stats);
+  }
+  for (auto& stats : m_otherStats) {
+    update(stats);
+  }
+}
+
+void
+L3RateTracer::PrintRows(std::ostream& os, double time, const std::string& node,
+                        nfd::FaceId faceId, const std::string& description,
+                        const Column* columns, size_t nColumns, const Stats (&stats)[4])
+{
+  for (size_t i = 0; i < nColumns; i++) {
+    double Stats::*field = columns[i].field;
+    os << time << "\t" << node << "\t" << faceId << "\t" << description << "\t"
+       << columns[i].type << "\t" << stats[PACKET_RATE].*field << "\t"
+       << stats[KILOBYTE_RATE].*field << "\t" << stats[PACKETS].*field << "\t"
+       << stats[BYTES].*field / 1024.0 << "\n";
+  }
+}
 
 void
 L3RateTracer::Print(std::ostream& os) const
 {
-  Time time = Simulator::Now();
+  double time = Simulator::Now().ToDouble(Time::S);
 
-  for (auto& stats : m_stats) {
-    if (stats.first == nullptr)
-      continue;
+  for (size_t slot = 1; slot < m_stats.size(); slot++) {
+    const FaceStats& stats = m_stats[slot];
+    if (stats.m_isActive) {
+      PrintRows(os, time, m_node, stats.m_faceId, stats.m_description, FACE_COLUMNS, 8,
+                stats.m_stats);
+    }
+  }
+  for (const FaceStats& stats : m_otherStats) {
+    PrintRows(os, time, m_node, stats.m_faceId, stats.m_description, FACE_COLUMNS, 8,
+              stats.m_stats);
+  }
+
+  if (m_stats[0].m_isActive) {
+    PrintRows(os, time, m_node, -1, "all", NODE_COLUMNS, 2, m_stats[0].m_stats);
+  }
+}
+
+namespace {
+
+// A binary trace is MAGIC and FORMAT_VERSION followed by records of two kinds:
+//  - FACE_RECORD: node, FaceId and description of a face, written before its first snapshot
+//  - SNAPSHOT_RECORD: time, node, number of faces and whether the node row follows, then
+//    the FaceId column and, for each counter and statistic (averaged packets/s, averaged
+//    kilobytes/s, packets, bytes), a column with one value per face, then the node row
+// Strings are a uint32_t length followed by the characters; numbers are in host order.
+const char MAGIC[8] = {'L', '3', 'R', 'A', 'T', 'E', 'S', '\0'};
+const uint32_t FORMAT_VERSION = 1;
+
+const uint8_t FACE_RECORD = 1;
+const uint8_t SNAPSHOT_RECORD = 2;
+
+template<typename T>
+void
+writeValue(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+writeString(std::ostream& os, const std::string& str)
+{
+  writeValue(os, static_cast<uint32_t>(str.size()));
+  os.write(str.data(), str.size());
+}
+
+template<typename T>
+bool
+readValue(std::istream& is, T& value)
+{
+  return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+bool
+readString(std::istream& is, std::string& str)
+{
+  uint32_t size;
+  if (!readValue(is, size))
+    return false;
+  str.resize(size);
+  return size == 0 || static_cast<bool>(is.read(&str[0], size));
+}
+
+} // namespace
 
-    PRINTER("InInterests", m_inInterests);
-    PRINTER("OutInterests", m_outInterests);
+void
+L3RateTracer::WriteBinaryHeader(std::ostream& os)
+{
+  os.write(MAGIC, sizeof(MAGIC));
+  writeValue(os, FORMAT_VERSION);
+}
 
-    PRINTER("InData", m_inData);
-    PRINTER("OutData", m_outData);
+void
+L3RateTracer::WriteBinary(std::ostream& os)
+{
+  std::vector<FaceStats*> faces;
+  for (size_t slot = 1; slot < m_stats.size(); slot++) {
+    if (m_stats[slot].m_isActive)
+      faces.push_back(&m_stats[slot]);
+  }
+  for (FaceStats& stats : m_otherStats) {
+    faces.push_back(&stats);
+  }
 
-    PRINTER("InSatisfiedInterests", m_satisfiedInterests);
-    PRINTER("InTimedOutInterests", m_timedOutInterests);
+  std::vector<int32_t> faceIds;
+  faceIds.reserve(faces.size());
+  for (FaceStats* stats : faces) {
+    if (!stats->m_isDescribed) {
+      writeValue(os, FACE_RECORD);
+      writeString(os, m_node);
+      writeValue(os, static_cast<int32_t>(stats->m_faceId));
+      writeString(os, stats->m_description);
+      stats->m_isDescribed = true;
+    }
+    faceIds.push_back(stats->m_faceId);
+  }
 
-    PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
-    PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
+  writeValue(os, SNAPSHOT_RECORD);
+  writeValue(os, Simulator::Now().ToDouble(Time::S));
+  writeString(os, m_node);
+  writeValue(os, static_cast<uint32_t>(faces.size()));
+  writeValue(os, static_cast<uint8_t>(m_stats[0].m_isActive));
+  os.write(reinterpret_cast<const char*>(faceIds.data()), faceIds.size() * sizeof(int32_t));
+
+  std::vector<double> column(faces.size());
+  for (const Column& counter : FACE_COLUMNS) {
+    for (int statistic = PACKET_RATE; statistic <= BYTES; statistic++) {
+      for (size_t i = 0; i < faces.size(); i++) {
+        column[i] = faces[i]->m_stats[statistic].*counter.field;
+      }
+      os.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(double));
+    }
   }
 
-  {
-    auto i = m_stats.find(nullptr);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
+  if (m_stats[0].m_isActive) {
+    for (const Column& counter : NODE_COLUMNS) {
+      for (int statistic = PACKET_RATE; statistic <= BYTES; statistic++) {
+        writeValue(os, m_stats[0].m_stats[statistic].*counter.field);
+      }
+    }
+  }
+}
+
+bool
+L3RateTracer::ConvertToTsv(std::istream& is, std::ostream& os)
+{
+  char magic[sizeof(MAGIC)];
+  uint32_t version;
+  if (!is.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      !readValue(is, version) || version != FORMAT_VERSION) {
+    return false;
+  }
+
+  printTsvHeader(os);
+  os << "\n";
+
+  std::map<std::pair<std::string, nfd::FaceId>, std::string> descriptions;
+  std::string node;
+  std::vector<int32_t> faceIds;
+  std::vector<FaceStats> faces;
+  std::vector<double> column;
+  uint8_t kind;
+  while (readValue(is, kind)) {
+    if (kind == FACE_RECORD) {
+      int32_t faceId;
+      std::string description;
+      if (!readString(is, node) || !readValue(is, faceId) || !readString(is, description))
+        return false;
+      descriptions[std::make_pair(node, faceId)] = description;
+      continue;
+    }
+    if (kind != SNAPSHOT_RECORD)
+      return false;
+
+    double time;
+    uint32_t nFaces;
+    uint8_t hasNodeRow;
+    if (!readValue(is, time) || !readString(is, node) || !readValue(is, nFaces) ||
+        !readValue(is, hasNodeRow))
+      return false;
+
+    faceIds.resize(nFaces);
+    if (!is.read(reinterpret_cast<char*>(faceIds.data()), nFaces * sizeof(int32_t)))
+      return false;
+
+    faces.assign(nFaces + 1, FaceStats()); // the last one is the node row
+    column.resize(nFaces);
+    for (const Column& counter : FACE_COLUMNS) {
+      for (int statistic = PACKET_RATE; statistic <= BYTES; statistic++) {
+        if (!is.read(reinterpret_cast<char*>(column.data()), nFaces * sizeof(double)))
+          return false;
+        for (size_t i = 0; i < nFaces; i++) {
+          faces[i].m_stats[statistic].*counter.field = column[i];
+        }
+      }
+    }
+
+    for (size_t i = 0; i < nFaces; i++) {
+      PrintRows(os, time, node, faceIds[i], descriptions[std::make_pair(node, faceIds[i])],
+                FACE_COLUMNS, 8, faces[i].m_stats);
+    }
+
+    if (hasNodeRow) {
+      FaceStats& nodeStats = faces[nFaces];
+      for (const Column& counter : NODE_COLUMNS) {
+        for (int statistic = PACKET_RATE; statistic <= BYTES; statistic++) {
+          if (!readValue(is, nodeStats.m_stats[statistic].*counter.field))
+            return false;
+        }
+      }
+      PrintRows(os, time, node, -1, "all", NODE_COLUMNS, 2, nodeStats.m_stats);
     }
   }
+  return true;
 }
 
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_outInterests++;
+  FaceStats& stats = GetStats(face);
+  stats.m_stats[PACKETS].m_outInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_outInterests +=
-      interest.wireEncode().size();
+    stats.m_stats[BYTES].m_outInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_inInterests++;
+  FaceStats& stats = GetStats(face);
+  stats.m_stats[PACKETS].m_inInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_inInterests +=
-      interest.wireEncode().size();
+    stats.m_stats[BYTES].m_inInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_outData++;
+  FaceStats& stats = GetStats(face);
+  stats.m_stats[PACKETS].m_outData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_outData +=
-      data.wireEncode().size();
+    stats.m_stats[BYTES].m_outData += data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_inData++;
+  FaceStats& stats = GetStats(face);
+  stats.m_stats[PACKETS].m_inData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_inData +=
-      data.wireEncode().size();
+    stats.m_stats[BYTES].m_inData += data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nullptr]).m_satisfiedInterests++;
+  m_stats[0].m_isActive = true;
+  m_stats[0].m_stats[PACKETS].m_satisfiedInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    std::get<0>(m_stats[in.getFace()]).m_satisfiedInterests ++;
+    GetStats(*in.getFace()).m_stats[PACKETS].m_satisfiedInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    std::get<0>(m_stats[out.getFace()]).m_outSatisfiedInterests ++;
+    GetStats(*out.getFace()).m_stats[PACKETS].m_outSatisfiedInterests++;
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nullptr]).m_timedOutInterests++;
+  m_stats[0].m_isActive = true;
+  m_stats[0].m_stats[PACKETS].m_timedOutInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    std::get<0>(m_stats[in.getFace()]).m_timedOutInterests++;
+    GetStats(*in.getFace()).m_stats[PACKETS].m_timedOutInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    std::get<0>(m_stats[out.getFace()]).m_outTimedOutInterests++;
+    GetStats(*out.getFace()).m_stats[PACKETS].m_outTimedOutInterests++;
   }
 }
 
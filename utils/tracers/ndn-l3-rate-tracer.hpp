@@ -31,6 +31,7 @@
 #include <tuple>
 #include <map>
 #include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -38,9 +39,18 @@ namespace ndn {
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
+ *
+ * Counters are kept in a dense per-face array indexed by FaceId.  Every averaging period
+ * the tracer either prints them as TSV rows or appends them to a binary, column-oriented
+ * trace, which ConvertToTsv() turns into the same TSV afterwards.
  */
 class L3RateTracer : public L3Tracer {
 public:
+  enum Format {
+    FORMAT_TSV,   ///< tab-separated text, one row per face and counter type
+    FORMAT_BINARY ///< one block of columns per node and averaging period
+  };
+
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
@@ -48,9 +58,11 @@ public:
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             Format format = FORMAT_TSV);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -59,9 +71,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          Format format = FORMAT_TSV);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -70,9 +84,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file
    */
   static void
-  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          Format format = FORMAT_TSV);
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -116,7 +132,23 @@ public:
    */
   static Ptr<L3RateTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
-          Time averagingPeriod = Seconds(0.5));
+          Time averagingPeriod = Seconds(0.5), Format format = FORMAT_TSV);
+
+  /**
+   * @brief Write the file header of a binary trace
+   *
+   * Install methods taking a file name do this themselves.
+   */
+  static void
+  WriteBinaryHeader(std::ostream& os);
+
+  /**
+   * @brief Convert a binary trace into the TSV trace (including its header) the same
+   *        tracers would have printed
+   * @return false if @p is does not contain a binary L3 rate trace
+   */
+  static bool
+  ConvertToTsv(std::istream& is, std::ostream& os);
 
   // from L3Tracer
   virtual void
@@ -125,6 +157,12 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Append the current averages and counters to a binary trace
+   */
+  void
+  WriteBinary(std::ostream& os);
+
 protected:
   // from L3Tracer
   virtual void
@@ -146,21 +184,62 @@ protected:
   TimedOutInterests(const nfd::pit::Entry&);
 
 private:
+  struct FaceStats {
+    FaceStats();
+
+    bool m_isActive;    ///< whether anything was counted for the face
+    bool m_isDescribed; ///< whether the binary trace has the description of the face
+    nfd::FaceId m_faceId;
+    std::string m_description;
+    Stats m_stats[4]; ///< averaged packets/s, averaged kilobytes/s, packets, bytes
+  };
+
+  enum {
+    PACKET_RATE,
+    KILOBYTE_RATE,
+    PACKETS,
+    BYTES
+  };
+
+  /// counter printed as one TSV row
+  struct Column {
+    const char* type;
+    double Stats::*field;
+  };
+
+  FaceStats&
+  GetStats(const Face& face);
+
   void
   SetAveragingPeriod(const Time& period);
 
   void
   PeriodicPrinter();
 
+  void
+  UpdateRates();
+
   void
   Reset();
 
+  static void
+  PrintRows(std::ostream& os, double time, const std::string& node, nfd::FaceId faceId,
+            const std::string& description, const Column* columns, size_t nColumns,
+            const Stats (&stats)[4]);
+
 private:
   shared_ptr<std::ostream> m_os;
   Time m_period;
   EventId m_printEvent;
+  Format m_format;
+
+  // [0] counts Interests of the whole node, [faceId - FACEID_RESERVED_MAX] those of a face
+  std::vector<FaceStats> m_stats;
+  // faces with reserved or invalid FaceIds, which ndnSIM does not normally trace
+  std::vector<FaceStats> m_otherStats;
 
-  mutable std::map<shared_ptr<const Face>, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
+  static const Column FACE_COLUMNS[8];
+  static const Column NODE_COLUMNS[2];
 };
 
 } // namespace ndn
@@ -0,0 +1,337 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-sit-event-log.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <boost/algorithm/string.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SitEventLog");
+
+namespace ns3 {
+namespace ndn {
+
+static_assert(sizeof(SitEventLog::Event) == 32, "SitEventLog::Event must be 32 bytes");
+
+namespace {
+
+const char MAGIC[8] = {'S', 'I', 'T', 'E', 'V', 'L', 'O', 'G'};
+const uint32_t FORMAT_VERSION = 1;
+
+const char* const EVENT_NAMES[SitEventLog::N_EVENT_TYPES] = {
+  "cs-hit", "cs-miss", "data-out", "forward-fib", "forward-sit", "reject"
+};
+
+struct Buffer {
+  std::vector<SitEventLog::Event> events;
+};
+
+// everything but the thread-local buffer pointers is guarded by mutex
+struct LogFile {
+  std::mutex mutex;
+  std::ofstream os;
+  size_t bufferSize = 0;
+  std::vector<std::unique_ptr<Buffer>> buffers;
+  std::atomic<uint64_t> generation{0}; // changes whenever the file is opened or closed
+};
+
+LogFile&
+getLogFile()
+{
+  static LogFile logFile;
+  return logFile;
+}
+
+thread_local Buffer* t_buffer = nullptr;
+thread_local uint64_t t_generation = 0;
+
+void
+writeBuffer(LogFile& logFile, Buffer& buffer)
+{
+  logFile.os.write(reinterpret_cast<const char*>(buffer.events.data()),
+                   buffer.events.size() * sizeof(SitEventLog::Event));
+  buffer.events.clear();
+}
+
+void
+closeLocked(LogFile& logFile)
+{
+  if (!logFile.os.is_open())
+    return;
+
+  for (auto& buffer : logFile.buffers) {
+    writeBuffer(logFile, *buffer);
+  }
+  logFile.buffers.clear();
+  logFile.os.close();
+  ++logFile.generation;
+}
+
+/// @return the buffer of this thread, or nullptr if the log is closed
+Buffer*
+getBuffer(LogFile& logFile)
+{
+  if (t_buffer != nullptr && t_generation == logFile.generation.load(std::memory_order_acquire))
+    return t_buffer;
+
+  std::lock_guard<std::mutex> lock(logFile.mutex);
+  t_buffer = nullptr;
+  if (!logFile.os.is_open())
+    return nullptr;
+
+  logFile.buffers.emplace_back(new Buffer);
+  t_buffer = logFile.buffers.back().get();
+  t_buffer->events.reserve(logFile.bufferSize);
+  t_generation = logFile.generation;
+  return t_buffer;
+}
+
+} // namespace
+
+std::atomic<uint32_t> SitEventLog::s_enabled(0);
+
+void
+SitEventLog::Open(const std::string& file, size_t bufferSize)
+{
+  LogFile& logFile = getLogFile();
+  std::lock_guard<std::mutex> lock(logFile.mutex);
+  closeLocked(logFile);
+
+  logFile.os.open(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!logFile.os.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Event log disabled");
+    return;
+  }
+
+  uint32_t header[2] = {FORMAT_VERSION, sizeof(Event)};
+  logFile.os.write(MAGIC, sizeof(MAGIC));
+  logFile.os.write(reinterpret_cast<const char*>(header), sizeof(header));
+  logFile.bufferSize = std::max<size_t>(bufferSize, 1);
+  ++logFile.generation;
+}
+
+void
+SitEventLog::Close()
+{
+  LogFile& logFile = getLogFile();
+  std::lock_guard<std::mutex> lock(logFile.mutex);
+  closeLocked(logFile);
+}
+
+void
+SitEventLog::Enable(EventType type)
+{
+  s_enabled |= 1u << type;
+}
+
+void
+SitEventLog::Disable(EventType type)
+{
+  s_enabled &= ~(1u << type);
+}
+
+bool
+SitEventLog::Enable(const std::string& types)
+{
+  std::vector<std::string> names;
+  boost::split(names, types, boost::is_any_of(","), boost::token_compress_on);
+
+  bool isValid = true;
+  for (const std::string& name : names) {
+    if (name.empty())
+      continue;
+
+    bool isFound = false;
+    for (int type = 0; type < N_EVENT_TYPES; type++) {
+      if (name == "all" || name == EVENT_NAMES[type]) {
+        Enable(static_cast<EventType>(type));
+        isFound = true;
+      }
+    }
+    if (!isFound) {
+      NS_LOG_ERROR("Unknown event type " << name);
+      isValid = false;
+    }
+  }
+  return isValid;
+}
+
+const char*
+SitEventLog::GetEventName(EventType type)
+{
+  return type < N_EVENT_TYPES ? EVENT_NAMES[type] : "unknown";
+}
+
+void
+SitEventLog::DoRecord(EventType type, const Name& name, uint32_t face, bool isLocalFace,
+                      bool destinationFlag, uint32_t floodFlag)
+{
+  LogFile& logFile = getLogFile();
+  Buffer* buffer = getBuffer(logFile);
+  if (buffer == nullptr)
+    return;
+
+  Event event;
+  event.time = Simulator::Now().GetNanoSeconds();
+  event.node = Simulator::GetContext();
+  event.producer = std::numeric_limits<uint32_t>::max();
+  event.seq = std::numeric_limits<uint64_t>::max();
+  if (name.size() == 3 && name.at(-2).isNumber() && name.at(-1).isSequenceNumber()) {
+    event.producer = static_cast<uint32_t>(name.at(-2).toNumber());
+    event.seq = name.at(-1).toSequenceNumber();
+  }
+  event.face = face;
+  event.floodFlag = static_cast<uint16_t>(std::min<uint32_t>(floodFlag, 0xFFFF));
+  event.type = static_cast<uint8_t>(type);
+  event.flags = (destinationFlag ? DESTINATION_FLAG : 0) | (isLocalFace ? LOCAL_FACE : 0);
+
+  buffer->events.push_back(event);
+  if (buffer->events.size() >= logFile.bufferSize) {
+    std::lock_guard<std::mutex> lock(logFile.mutex);
+    writeBuffer(logFile, *buffer);
+  }
+}
+
+bool
+SitEventLog::Read(std::istream& is, const std::function<void(const Event&)>& onEvent)
+{
+  char magic[sizeof(MAGIC)];
+  uint32_t header[2];
+  is.read(magic, sizeof(magic));
+  is.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!is || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || header[0] != FORMAT_VERSION ||
+      header[1] != sizeof(Event)) {
+    return false;
+  }
+
+  std::vector<Event> events(4096);
+  while (is) {
+    is.read(reinterpret_cast<char*>(events.data()), events.size() * sizeof(Event));
+    size_t nEvents = static_cast<size_t>(is.gcount()) / sizeof(Event);
+    for (size_t i = 0; i < nEvents; i++) {
+      onEvent(events[i]);
+    }
+  }
+  return true;
+}
+
+void
+SitEventLog::WriteCsvHeader(std::ostream& os)
+{
+  os << "Time,Node,Event,Producer,Seq,DF,FloodFlag,Face,Local\n";
+}
+
+void
+SitEventLog::WriteCsv(std::ostream& os, const Event& event)
+{
+  os << event.time << ',' << event.node << ','
+     << GetEventName(static_cast<EventType>(event.type)) << ',';
+  if (event.producer != std::numeric_limits<uint32_t>::max())
+    os << event.producer << ',' << event.seq;
+  else
+    os << ',';
+  os << ',' << ((event.flags & DESTINATION_FLAG) ? 1 : 0) << ',' << event.floodFlag << ','
+     << event.face << ',' << ((event.flags & LOCAL_FACE) ? 1 : 0) << '\n';
+}
+
+SitEventLog::Summary::Summary()
+  : m_hits{0, 0}
+  , m_misses{0, 0}
+  , m_deliveries(0)
+  , m_dataHops(0)
+{
+  std::fill(m_counts, m_counts + N_EVENT_TYPES, 0);
+}
+
+void
+SitEventLog::Summary::Add(const Event& event)
+{
+  if (event.type >= N_EVENT_TYPES)
+    return;
+
+  m_counts[event.type]++;
+  int df = (event.flags & DESTINATION_FLAG) ? 1 : 0;
+  switch (event.type) {
+  case CS_HIT:
+    m_hits[df]++;
+    break;
+  case CS_MISS:
+    m_misses[df]++;
+    break;
+  case DATA_OUT:
+    if (event.flags & LOCAL_FACE)
+      m_deliveries++;
+    else
+      m_dataHops++;
+    break;
+  default:
+    break;
+  }
+}
+
+uint64_t
+SitEventLog::Summary::GetCount(EventType type) const
+{
+  return m_counts[type];
+}
+
+double
+SitEventLog::Summary::GetHitRatio(bool destinationFlag) const
+{
+  uint64_t n = m_hits[destinationFlag] + m_misses[destinationFlag];
+  return n == 0 ? 0.0 : static_cast<double>(m_hits[destinationFlag]) / n;
+}
+
+double
+SitEventLog::Summary::GetDataHopsPerDelivery() const
+{
+  return m_deliveries == 0 ? 0.0 : static_cast<double>(m_dataHops) / m_deliveries;
+}
+
+double
+SitEventLog::Summary::GetInterestHopsPerDelivery() const
+{
+  return m_deliveries == 0 ? 0.0 : static_cast<double>(m_counts[FORWARD_FIB] +
+                                                       m_counts[FORWARD_SIT]) / m_deliveries;
+}
+
+void
+SitEventLog::Summary::Print(std::ostream& os) const
+{
+  for (int type = 0; type < N_EVENT_TYPES; type++) {
+    os << EVENT_NAMES[type] << " " << m_counts[type] << "\n";
+  }
+  os << "hit-ratio-df0 " << GetHitRatio(false) << "\n"
+     << "hit-ratio-df1 " << GetHitRatio(true) << "\n"
+     << "deliveries " << m_deliveries << "\n"
+     << "data-hops-per-delivery " << GetDataHopsPerDelivery() << "\n"
+     << "interest-hops-per-delivery " << GetInterestHopsPerDelivery() << "\n";
+}
+
+} // namespace ndn
+} // namespace ns3
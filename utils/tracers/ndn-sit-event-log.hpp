@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SIT_EVENT_LOG_H
+#define NDN_SIT_EVENT_LOG_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <atomic>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Binary log of SIT forwarding events
+ *
+ * Forwarder and the SIT strategies report cache hits, Data transmissions and forwarding
+ * decisions as fixed-size Events instead of formatted log lines. Each thread appends to its
+ * own buffer, and full buffers are written to one file, which ndn-sit-event-log-reader turns
+ * into CSV and aggregate statistics.
+ *
+ * Recording is off for every event type until enabled with Enable(), so a disabled event
+ * costs one load and one test at the call site.
+ */
+class SitEventLog {
+public:
+  enum EventType {
+    CS_HIT,      ///< Interest satisfied from the Content Store
+    CS_MISS,     ///< Interest not found in the Content Store
+    DATA_OUT,    ///< Data sent to a face
+    FORWARD_FIB, ///< Interest forwarded to a FIB next hop (DF 0)
+    FORWARD_SIT, ///< Interest forwarded to a SIT next hop
+    REJECT,      ///< Interest with DF 0 that had no eligible FIB next hop
+    N_EVENT_TYPES
+  };
+
+  enum Flags {
+    DESTINATION_FLAG = 1, ///< the Interest or PIT entry had its Destination Flag set
+    LOCAL_FACE = 2        ///< the face is a local (application) face
+  };
+
+  /**
+   * @brief On-disk record, 32 bytes in host byte order
+   *
+   * Producer and seq are the last two components of /<prefix>/<producer>/<seq> names, and are
+   * all ones for other names.
+   */
+  struct Event {
+    int64_t time; ///< simulation time, in nanoseconds
+    uint64_t seq;
+    uint32_t node; ///< ns-3 node id
+    uint32_t producer;
+    uint32_t face;
+    uint16_t floodFlag; ///< saturated at 0xFFFF
+    uint8_t type;       ///< EventType
+    uint8_t flags;      ///< Flags
+  };
+
+  /**
+   * @brief Start writing events to a file, replacing its content
+   * @param file name of the file
+   * @param bufferSize number of events each thread buffers before writing them
+   */
+  static void
+  Open(const std::string& file, size_t bufferSize = 65536);
+
+  /**
+   * @brief Write out all buffered events and close the file
+   *
+   * Must not race with Record() on other threads.
+   */
+  static void
+  Close();
+
+  static void
+  Enable(EventType type);
+
+  static void
+  Disable(EventType type);
+
+  /**
+   * @brief Enable the event types in a comma-separated list of names
+   *
+   * Names are those of GetEventName(), and "all" enables every type.
+   * @return false if the list has an unknown name
+   */
+  static bool
+  Enable(const std::string& types);
+
+  static bool
+  IsEnabled(EventType type);
+
+  static const char*
+  GetEventName(EventType type);
+
+  /**
+   * @brief Record an event about a Data or Interest with the given name
+   */
+  static void
+  Record(EventType type, const Name& name, uint32_t face, bool isLocalFace,
+         bool destinationFlag, uint32_t floodFlag);
+
+  /**
+   * @brief Read a log file written by SitEventLog
+   * @return false if the file is not a SitEventLog file
+   */
+  static bool
+  Read(std::istream& is, const std::function<void(const Event&)>& onEvent);
+
+  /**
+   * @brief Aggregate statistics of a log
+   */
+  class Summary {
+  public:
+    Summary();
+
+    void
+    Add(const Event& event);
+
+    /**
+     * @brief Print event counts, hit ratios and hops per delivered Data
+     */
+    void
+    Print(std::ostream& os) const;
+
+    uint64_t
+    GetCount(EventType type) const;
+
+    /**
+     * @brief Content Store hit ratio of Interests with the given Destination Flag
+     */
+    double
+    GetHitRatio(bool destinationFlag) const;
+
+    /**
+     * @brief Data transmissions between forwarders per Data delivered to an application
+     */
+    double
+    GetDataHopsPerDelivery() const;
+
+    /**
+     * @brief Interest transmissions per Data delivered to an application
+     */
+    double
+    GetInterestHopsPerDelivery() const;
+
+  private:
+    uint64_t m_counts[N_EVENT_TYPES];
+    uint64_t m_hits[2];   // by Destination Flag
+    uint64_t m_misses[2]; // by Destination Flag
+    uint64_t m_deliveries;
+    uint64_t m_dataHops;
+  };
+
+  /**
+   * @brief Write the CSV header line
+   */
+  static void
+  WriteCsvHeader(std::ostream& os);
+
+  /**
+   * @brief Write one event as a CSV line
+   */
+  static void
+  WriteCsv(std::ostream& os, const Event& event);
+
+private:
+  static void
+  DoRecord(EventType type, const Name& name, uint32_t face, bool isLocalFace,
+           bool destinationFlag, uint32_t floodFlag);
+
+private:
+  static std::atomic<uint32_t> s_enabled; // bit per EventType
+};
+
+inline bool
+SitEventLog::IsEnabled(EventType type)
+{
+  return (s_enabled.load(std::memory_order_relaxed) >> type) & 1;
+}
+
+inline void
+SitEventLog::Record(EventType type, const Name& name, uint32_t face, bool isLocalFace,
+                    bool destinationFlag, uint32_t floodFlag)
+{
+  if (IsEnabled(type))
+    DoRecord(type, name, face, isLocalFace, destinationFlag, floodFlag);
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SIT_EVENT_LOG_H
@@ -55,6 +55,12 @@ struct inherit_with_base : Super, Value {
     Super::update(item);
   }
 
+  bool
+  admit()
+  {
+    return Value::value_.admit() && Super::admit();
+  }
+
   bool
   insert(typename Base::iterator item)
   {
@@ -103,6 +109,11 @@ struct empty_policy_wrap {
   {
   }
   bool
+  admit()
+  {
+    return true;
+  }
+  bool
   insert(typename Base::iterator item)
   {
     return true;
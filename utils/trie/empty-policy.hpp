@@ -54,6 +54,10 @@ struct empty_policy_traits {
       inline void update(typename Container::iterator)
       {
       }
+      inline bool admit()
+      {
+        return true;
+      }
       inline bool insert(typename Container::iterator)
       {
         return true;
@@ -71,6 +71,12 @@ struct fifo_policy_traits {
         // do nothing
       }
 
+      inline bool
+      admit()
+      {
+        return true;
+      }
+
       inline bool
       insert(typename parent_trie::iterator item)
       {
@@ -99,6 +99,12 @@ struct lfu_policy_traits {
         policy_container::insert(*item);
       }
 
+      inline bool
+      admit()
+      {
+        return true;
+      }
+
       inline bool
       insert(typename parent_trie::iterator item)
       {
@@ -72,6 +72,12 @@ struct lru_policy_traits {
                                  policy_container::s_iterator_to(*item));
       }
 
+      inline bool
+      admit()
+      {
+        return true;
+      }
+
       inline bool
       insert(typename parent_trie::iterator item)
       {
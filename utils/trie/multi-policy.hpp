@@ -96,6 +96,12 @@ struct multi_policy_traits {
         policy_container::update(item);
       }
 
+      inline bool
+      admit()
+      {
+        return policy_container::admit();
+      }
+
       inline bool
       insert(typename parent_trie::iterator item)
       {
@@ -66,6 +66,12 @@ struct payload_policy_traits {
                                  policy_container::s_iterator_to(*item));
       }
 
+      inline bool
+      admit()
+      {
+        return true;
+      }
+
       inline bool
       insert(typename parent_trie::iterator item)
       {
@@ -44,7 +44,7 @@ public:
   inline std::pair<iterator, bool>
   insert(typename iterator payload)
   {
-    bool ok = policy_.insert(s_iterator_to(item.first));
+    bool ok = policy_.admit() && policy_.insert(s_iterator_to(item.first));
     if (!ok) {
       item.first->erase(); // cannot insert
       return std::make_pair(end(), false);
@@ -74,6 +74,12 @@ struct persistent_policy_traits {
         // do nothing
       }
 
+      inline bool
+      admit()
+      {
+        return true;
+      }
+
       inline bool
       insert(typename parent_trie::iterator item)
       {
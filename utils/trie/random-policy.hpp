@@ -102,6 +102,12 @@ struct random_policy_traits {
         // do nothing. it's random policy
       }
 
+      inline bool
+      admit()
+      {
+        return true;
+      }
+
       inline bool
       insert(typename parent_trie::iterator item)
       {
@@ -41,8 +41,8 @@ public:
                     typename PolicyTraits::template container_hook<parent_trie>::type>::type
       policy_container;
 
-  inline trie_with_policy(size_t bucketSize = 1, size_t bucketIncrement = 1)
-    : trie_(name::Component(), bucketSize, bucketIncrement)
+  inline trie_with_policy()
+    : trie_(name::Component())
     , policy_(*this)
   {
   }
@@ -54,7 +54,7 @@ public:
 
     if (item.second) // real insert
     {
-      bool ok = policy_.insert(s_iterator_to(item.first));
+      bool ok = policy_.admit() && policy_.insert(s_iterator_to(item.first));
       if (!ok) {
         item.first->erase(); // cannot insert
         return std::make_pair(end(), false);
@@ -67,6 +67,34 @@ public:
     return item;
   }
 
+  /**
+   * @brief Insert the payload returned by makePayload(iterator), if key has no payload yet and
+   *        the policy admits a new entry
+   *
+   * Unlike insert(), nothing is created for a key that is already there or for an entry that
+   * the policy rejects.
+   */
+  template<class MakePayload>
+  inline std::pair<iterator, bool>
+  insert_if_admitted(const FullKey& key, MakePayload makePayload)
+  {
+    std::pair<iterator, bool> item = trie_.insert(key, PayloadTraits::empty_payload);
+    if (!item.second)
+      return std::make_pair(s_iterator_to(item.first), false);
+
+    if (!policy_.admit()) {
+      item.first->prune(); // drop the nodes created for key
+      return std::make_pair(end(), false);
+    }
+
+    item.first->set_payload(makePayload(item.first));
+    if (!policy_.insert(s_iterator_to(item.first))) {
+      item.first->erase(); // cannot insert
+      return std::make_pair(end(), false);
+    }
+    return item;
+  }
+
   inline void
   erase(const FullKey& key)
   {
@@ -26,15 +26,18 @@
 
 #include "ns3/ptr.h"
 
-#include <boost/intrusive/unordered_set.hpp>
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/functional/hash.hpp>
-#include <boost/interprocess/smart_ptr/unique_ptr.hpp>
+#include <boost/noncopyable.hpp>
 #include <tuple>
 #include <boost/foreach.hpp>
 #include <boost/mpl/if.hpp>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
@@ -108,14 +111,79 @@ template<typename FullKey, typename PayloadTraits, typename PolicyHook>
 inline std::ostream&
 operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
-bool
-operator==(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-           const trie<FullKey, PayloadTraits, PolicyHook>& b);
+////////////////////////////////////////////////////
+// node storage
+//
+/**
+ * @brief Storage for objects of type Node, such as the nodes of one trie (owned by its root)
+ *
+ * Blocks of sizeof(Node) are carved from chunks of CHUNK_SIZE blocks, and freed blocks are
+ * reused before the next chunk is allocated.  Chunks are released when the pool is destroyed.
+ */
+template<class Node>
+class trie_node_pool : boost::noncopyable {
+public:
+  static const size_t CHUNK_SIZE = 256;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
-std::size_t
-hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+  trie_node_pool()
+    : free_(nullptr)
+    , next_(nullptr)
+    , end_(nullptr)
+  {
+  }
+
+  ~trie_node_pool()
+  {
+    for (char* chunk : chunks_) {
+      ::operator delete(chunk);
+    }
+  }
+
+  void*
+  allocate()
+  {
+    if (free_ != nullptr) {
+      free_node* node = free_;
+      free_ = node->next;
+      return node;
+    }
+
+    if (next_ == end_) {
+      chunks_.push_back(static_cast<char*>(::operator new(CHUNK_SIZE * node_size())));
+      next_ = chunks_.back();
+      end_ = next_ + CHUNK_SIZE * node_size();
+    }
+    void* node = next_;
+    next_ += node_size();
+    return node;
+  }
+
+  void
+  deallocate(void* p)
+  {
+    free_node* node = static_cast<free_node*>(p);
+    node->next = free_;
+    free_ = node;
+  }
+
+private:
+  struct free_node {
+    free_node* next;
+  };
+
+  static size_t
+  node_size()
+  {
+    static_assert(sizeof(Node) >= sizeof(free_node), "trie node is too small");
+    return (sizeof(Node) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+  }
+
+private:
+  std::vector<char*> chunks_;
+  free_node* free_;
+  char* next_; // unused part of the last chunk
+  char* end_;
+};
 
 ///////////////////////////////////////////////////
 // actual definition
@@ -126,6 +194,13 @@ class trie_iterator;
 template<class T>
 class trie_point_iterator;
 
+/**
+ * @brief Name trie
+ *
+ * Children of a node are kept in a flat array of pointers: sorted by key while there are at
+ * most MAX_SORTED_CHILDREN of them, and otherwise as a hash table with linear probing, at
+ * most half full.  Nodes are allocated from a pool owned by the root.
+ */
 template<typename FullKey, typename PayloadTraits, typename PolicyHook>
 class trie {
 public:
@@ -142,30 +217,40 @@ public:
 
   typedef PayloadTraits payload_traits;
 
-  inline trie(const Key& key, size_t bucketSize = 1, size_t bucketIncrement = 1)
+  static const size_t MAX_SORTED_CHILDREN = 16;
+
+  /**
+   * @brief Create the root of a trie
+   */
+  inline explicit trie(const Key& key)
     : key_(key)
-    , initialBucketSize_(bucketSize)
-    , bucketIncrement_(bucketIncrement)
-    , bucketSize_(initialBucketSize_)
-    , buckets_(new bucket_type[bucketSize_]) // cannot use normal pointer, because lifetime of
-                                             // buckets should be larger than lifetime of the
-                                             // container
-    , children_(bucket_traits(buckets_.get(), bucketSize_))
-    , payload_(PayloadTraits::empty_payload)
+    , hash_(hash_key(key))
     , parent_(nullptr)
+    , slot_(0)
+    , isHashed_(false)
+    , nChildren_(0)
+    , payload_(PayloadTraits::empty_payload)
+    , ownPool_(new trie_node_pool<trie>)
+    , pool_(ownPool_.get())
   {
   }
 
   inline ~trie()
   {
     payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
-    children_.clear_and_dispose(trie_delete_disposer());
+    clear();
   }
 
   void
   clear()
   {
-    children_.clear_and_dispose(trie_delete_disposer());
+    for (trie* child : children_) {
+      if (child != nullptr)
+        dispose(child);
+    }
+    children_.clear();
+    nChildren_ = 0;
+    isHashed_ = false;
   }
 
   template<class Predicate>
@@ -183,41 +268,19 @@ public:
     }
   }
 
-  // actual entry
-  friend bool operator==<>(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-                           const trie<FullKey, PayloadTraits, PolicyHook>& b);
-
-  friend std::size_t
-  hash_value<>(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
-
   inline std::pair<iterator, bool>
   insert(const FullKey& key, typename PayloadTraits::insert_type payload)
   {
     trie* trieNode = this;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
-        trie* newNode = new trie(subkey, initialBucketSize_, bucketIncrement_);
-        // std::cout << "new " << newNode << "\n";
-        newNode->parent_ = trieNode;
-
-        if (trieNode->children_.size() >= trieNode->bucketSize_) {
-          trieNode->bucketSize_ += trieNode->bucketIncrement_;
-          trieNode->bucketIncrement_ *= 2; // increase bucketIncrement exponentially
-
-          buckets_array newBuckets(new bucket_type[trieNode->bucketSize_]);
-          trieNode->children_.rehash(bucket_traits(newBuckets.get(), trieNode->bucketSize_));
-          trieNode->buckets_.swap(newBuckets);
-        }
-
-        std::pair<typename unordered_set::iterator, bool> ret =
-          trieNode->children_.insert(*newNode);
-
-        trieNode = &(*ret.first);
+      trie* child = trieNode->find_child(subkey);
+      if (child == nullptr) {
+        child = new (pool_->allocate()) trie(subkey, pool_);
+        child->parent_ = trieNode;
+        trieNode->add_child(child);
       }
-      else
-        trieNode = &(*item);
+      trieNode = child;
     }
 
     if (trieNode->payload_ == PayloadTraits::empty_payload) {
@@ -244,14 +307,13 @@ public:
   inline iterator
   prune()
   {
-    if (payload_ == PayloadTraits::empty_payload && children_.size() == 0) {
+    if (payload_ == PayloadTraits::empty_payload && nChildren_ == 0) {
       if (parent_ == 0)
         return this;
 
       trie* parent = parent_;
-      parent->children_
-        .erase_and_dispose(*this,
-                           trie_delete_disposer()); // delete this; basically, committing a suicide
+      parent->remove_child(this);
+      dispose(this); // basically, committing a suicide
 
       return parent->prune();
     }
@@ -264,23 +326,15 @@ public:
   inline void
   prune_node()
   {
-    if (payload_ == PayloadTraits::empty_payload && children_.size() == 0) {
+    if (payload_ == PayloadTraits::empty_payload && nChildren_ == 0) {
       if (parent_ == 0)
         return;
 
-      trie* parent = parent_;
-      parent->children_
-        .erase_and_dispose(*this,
-                           trie_delete_disposer()); // delete this; basically, committing a suicide
+      parent_->remove_child(this);
+      dispose(this); // basically, committing a suicide
     }
   }
 
-  // inline std::tuple<const iterator, bool, const iterator>
-  // find (const FullKey &key) const
-  // {
-  //   return const_cast<trie*> (this)->find (key);
-  // }
-
   /**
    * @brief Perform the longest prefix match
    * @param key the key for which to perform the longest prefix match
@@ -295,13 +349,13 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
+      trie* child = trieNode->find_child(subkey);
+      if (child == nullptr) {
         reachLast = false;
         break;
       }
       else {
-        trieNode = &(*item);
+        trieNode = child;
 
         if (trieNode->payload_ != PayloadTraits::empty_payload)
           foundNode = trieNode;
@@ -326,13 +380,13 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
+      trie* child = trieNode->find_child(subkey);
+      if (child == nullptr) {
         reachLast = false;
         break;
       }
       else {
-        trieNode = &(*item);
+        trieNode = child;
 
         if (trieNode->payload_ != PayloadTraits::empty_payload && pred(trieNode->payload_)) {
           foundNode = trieNode;
@@ -354,11 +408,10 @@ public:
     if (payload_ != PayloadTraits::empty_payload)
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++)
-    // BOOST_FOREACH (trie &subnode, children_)
-    {
+    for (trie* subnode : children_) {
+      if (subnode == nullptr)
+        continue;
+
       iterator value = subnode->find();
       if (value != 0)
         return value;
@@ -380,11 +433,10 @@ public:
     if (payload_ != PayloadTraits::empty_payload && pred(payload_))
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++)
-    // BOOST_FOREACH (const trie &subnode, children_)
-    {
+    for (trie* subnode : children_) {
+      if (subnode == nullptr)
+        continue;
+
       iterator value = subnode->find_if(pred);
       if (value != 0)
         return value;
@@ -406,10 +458,8 @@ public:
   inline const iterator
   find_if_next_level(Predicate pred)
   {
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++) {
-      if (pred(subnode->key())) {
+    for (trie* subnode : children_) {
+      if (subnode != nullptr && pred(subnode->key())) {
         return subnode->find();
       }
     }
@@ -457,23 +507,181 @@ public:
   PrintStat(std::ostream& os) const;
 
 private:
-  // The disposer object function
-  struct trie_delete_disposer {
-    void
-    operator()(trie* delete_this)
+  // creates a non-root node
+  trie(const Key& key, trie_node_pool<trie>* pool)
+    : key_(key)
+    , hash_(hash_key(key))
+    , parent_(nullptr)
+    , slot_(0)
+    , isHashed_(false)
+    , nChildren_(0)
+    , payload_(PayloadTraits::empty_payload)
+    , pool_(pool)
+  {
+  }
+
+  static std::size_t
+  hash_key(const Key& key)
+  {
+    return boost::hash_value(key);
+  }
+
+  static void
+  dispose(trie* node)
+  {
+    trie_node_pool<trie>* pool = node->pool_;
+    node->~trie();
+    pool->deallocate(node);
+  }
+
+  struct key_less {
+    bool
+    operator()(const trie* node, const Key& key) const
     {
-      delete delete_this;
+      return node->key_ < key;
     }
   };
 
-  template<class D>
-  struct array_disposer {
-    void
-    operator()(D* array)
-    {
-      delete[] array;
+  trie*
+  find_child(const Key& key) const
+  {
+    if (!isHashed_) {
+      typename std::vector<trie*>::const_iterator child =
+        std::lower_bound(children_.begin(), children_.end(), key, key_less());
+      if (child != children_.end() && !(key < (*child)->key_))
+        return *child;
+      return nullptr;
     }
-  };
+
+    std::size_t hash = hash_key(key);
+    std::size_t mask = children_.size() - 1;
+    for (std::size_t slot = hash & mask; children_[slot] != nullptr; slot = (slot + 1) & mask) {
+      if (children_[slot]->hash_ == hash && children_[slot]->key_ == key)
+        return children_[slot];
+    }
+    return nullptr;
+  }
+
+  // child must not be in the array yet
+  void
+  add_child(trie* child)
+  {
+    if (!isHashed_) {
+      if (nChildren_ < MAX_SORTED_CHILDREN) {
+        typename std::vector<trie*>::iterator position =
+          std::lower_bound(children_.begin(), children_.end(), child->key_, key_less());
+        size_t slot = position - children_.begin();
+        children_.insert(position, child);
+        ++nChildren_;
+        renumber(slot);
+        return;
+      }
+
+      isHashed_ = true;
+      rehash(MAX_SORTED_CHILDREN * 4);
+    }
+    else if ((nChildren_ + 1) * 2 > children_.size()) {
+      rehash(children_.size() * 2);
+    }
+    hash_insert(child);
+  }
+
+  void
+  remove_child(trie* child)
+  {
+    if (!isHashed_) {
+      children_.erase(children_.begin() + child->slot_);
+      --nChildren_;
+      renumber(child->slot_);
+      return;
+    }
+
+    // backward shift deletion keeps every child reachable from its home slot
+    std::size_t mask = children_.size() - 1;
+    std::size_t hole = child->slot_;
+    children_[hole] = nullptr;
+    --nChildren_;
+    for (std::size_t slot = (hole + 1) & mask; children_[slot] != nullptr;
+         slot = (slot + 1) & mask) {
+      std::size_t home = children_[slot]->hash_ & mask;
+      if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+        children_[hole] = children_[slot];
+        children_[hole]->slot_ = hole;
+        children_[slot] = nullptr;
+        hole = slot;
+      }
+    }
+
+    if (nChildren_ <= MAX_SORTED_CHILDREN / 2) {
+      std::vector<trie*> sorted;
+      sorted.reserve(nChildren_);
+      for (trie* node : children_) {
+        if (node != nullptr)
+          sorted.push_back(node);
+      }
+      std::sort(sorted.begin(), sorted.end(),
+                [] (const trie* a, const trie* b) { return a->key_ < b->key_; });
+      children_.swap(sorted);
+      isHashed_ = false;
+      renumber(0);
+    }
+  }
+
+  // capacity must be a power of two
+  void
+  rehash(size_t capacity)
+  {
+    std::vector<trie*> nodes(capacity, nullptr);
+    nodes.swap(children_);
+    nChildren_ = 0;
+    for (trie* node : nodes) {
+      if (node != nullptr)
+        hash_insert(node);
+    }
+  }
+
+  void
+  hash_insert(trie* child)
+  {
+    std::size_t mask = children_.size() - 1;
+    std::size_t slot = child->hash_ & mask;
+    while (children_[slot] != nullptr) {
+      slot = (slot + 1) & mask;
+    }
+    children_[slot] = child;
+    child->slot_ = slot;
+    ++nChildren_;
+  }
+
+  // updates slot_ of sorted children starting from the given one
+  void
+  renumber(size_t from)
+  {
+    for (size_t slot = from; slot < children_.size(); ++slot) {
+      children_[slot]->slot_ = slot;
+    }
+  }
+
+  trie*
+  first_child() const
+  {
+    for (trie* child : children_) {
+      if (child != nullptr)
+        return child;
+    }
+    return nullptr;
+  }
+
+  trie*
+  next_sibling() const
+  {
+    const std::vector<trie*>& siblings = parent_->children_;
+    for (size_t slot = slot_ + 1; slot < siblings.size(); ++slot) {
+      if (siblings[slot] != nullptr)
+        return siblings[slot];
+    }
+    return nullptr;
+  }
 
   friend std::ostream& operator<<<>(std::ostream& os, const trie& trie_node);
 
@@ -481,17 +689,6 @@ public:
   PolicyHook policy_hook_;
 
 private:
-  boost::intrusive::unordered_set_member_hook<> unordered_set_member_hook_;
-
-  // necessary typedefs
-  typedef trie self_type;
-  typedef boost::intrusive::member_hook<trie, boost::intrusive::unordered_set_member_hook<>,
-                                        &trie::unordered_set_member_hook_> member_hook;
-
-  typedef boost::intrusive::unordered_set<trie, member_hook> unordered_set;
-  typedef typename unordered_set::bucket_type bucket_type;
-  typedef typename unordered_set::bucket_traits bucket_traits;
-
   template<class T, class NonConstT>
   friend class trie_iterator;
 
@@ -503,17 +700,19 @@ private:
   ////////////////////////////////////////////////
 
   Key key_; ///< name component
+  std::size_t hash_; ///< hash of key_, to (re)place this node in the parent's hash table
 
-  size_t initialBucketSize_;
-  size_t bucketIncrement_;
+  trie* parent_; // to make cleaning effective
+  size_t slot_;  ///< index in parent_->children_
 
-  size_t bucketSize_;
-  typedef boost::interprocess::unique_ptr<bucket_type, array_disposer<bucket_type>> buckets_array;
-  buckets_array buckets_;
-  unordered_set children_;
+  bool isHashed_;
+  std::vector<trie*> children_; ///< sorted by key, or a hash table with empty slots
+  size_t nChildren_;
 
   typename PayloadTraits::storage_type payload_;
-  trie* parent_; // to make cleaning effective
+
+  std::unique_ptr<trie_node_pool<trie>> ownPool_; ///< only in the root
+  trie_node_pool<trie>* pool_;
 };
 
 template<typename FullKey, typename PayloadTraits, typename PolicyHook>
@@ -524,21 +723,21 @@ operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& tri
      << std::endl;
   typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
 
-  for (typename trie::unordered_set::const_iterator subnode = trie_node.children_.begin();
-       subnode != trie_node.children_.end(); subnode++)
-  // BOOST_FOREACH (const trie &subnode, trie_node.children_)
-  {
+  for (const trie* subnode : trie_node.children_) {
+    if (subnode == nullptr)
+      continue;
+
     os << "\"" << &trie_node << "\""
        << " [label=\"" << trie_node.key_
        << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]\n";
-    os << "\"" << &(*subnode) << "\""
+    os << "\"" << subnode << "\""
        << " [label=\"" << subnode->key_
        << ((subnode->payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]"
                                                                               "\n";
 
     os << "\"" << &trie_node << "\""
        << " -> "
-       << "\"" << &(*subnode) << "\""
+       << "\"" << subnode << "\""
        << "\n";
     os << *subnode;
   }
@@ -551,36 +750,17 @@ inline void
 trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
 {
   os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload) ? "*" : "") << ": "
-     << children_.size() << " children" << std::endl;
-  for (size_t bucket = 0, maxbucket = children_.bucket_count(); bucket < maxbucket; bucket++) {
-    os << " " << children_.bucket_size(bucket);
-  }
-  os << "\n";
+     << nChildren_ << " children";
+  if (isHashed_)
+    os << " in " << children_.size() << " hash slots";
+  os << std::endl;
 
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-  for (typename trie::unordered_set::const_iterator subnode = children_.begin();
-       subnode != children_.end(); subnode++)
-  // BOOST_FOREACH (const trie &subnode, children_)
-  {
-    subnode->PrintStat(os);
+  for (const trie* subnode : children_) {
+    if (subnode != nullptr)
+      subnode->PrintStat(os);
   }
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
-inline bool
-operator==(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-           const trie<FullKey, PayloadTraits, PolicyHook>& b)
-{
-  return a.key_ == b.key_;
-}
-
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
-inline std::size_t
-hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
-{
-  return boost::hash_value(trie_node.key_);
-}
-
 template<class Trie, class NonConstTrie> // hack for boost < 1.47
 class trie_iterator {
 public:
@@ -637,8 +817,9 @@ public:
   trie_iterator<Trie, NonConstTrie>&
   operator++(int)
   {
-    if (trie_->children_.size() > 0)
-      trie_ = &(*trie_->children_.begin());
+    Trie* child = trie_->first_child();
+    if (child != 0)
+      trie_ = child;
     else
       trie_ = goUp();
     return *this;
@@ -652,28 +833,16 @@ public:
   }
 
 private:
-  typedef typename boost::mpl::if_<boost::is_same<Trie, NonConstTrie>,
-                                   typename Trie::unordered_set::iterator,
-                                   typename Trie::unordered_set::const_iterator>::type set_iterator;
-
   Trie*
   goUp()
   {
-    if (trie_->parent_ != 0) {
-      // typename Trie::unordered_set::iterator item =
-      set_iterator item = const_cast<NonConstTrie*>(trie_)
-                            ->parent_->children_.iterator_to(const_cast<NonConstTrie&>(*trie_));
-      item++;
-      if (item != trie_->parent_->children_.end()) {
-        return &(*item);
-      }
-      else {
-        trie_ = trie_->parent_;
-        return goUp();
-      }
+    while (trie_->parent_ != 0) {
+      Trie* sibling = trie_->next_sibling();
+      if (sibling != 0)
+        return sibling;
+      trie_ = trie_->parent_;
     }
-    else
-      return 0;
+    return 0;
   }
 
 private:
@@ -682,11 +851,6 @@ private:
 
 template<class Trie>
 class trie_point_iterator {
-private:
-  typedef typename boost::mpl::if_<boost::is_same<Trie, const Trie>,
-                                   typename Trie::unordered_set::const_iterator,
-                                   typename Trie::unordered_set::iterator>::type set_iterator;
-
 public:
   trie_point_iterator()
     : trie_(0)
@@ -697,11 +861,8 @@ public:
   {
   }
   trie_point_iterator(Trie& item)
+    : trie_(item.first_child())
   {
-    if (item.children_.size() != 0)
-      trie_ = &*item.children_.begin();
-    else
-      trie_ = 0;
   }
 
   Trie& operator*()
@@ -744,17 +905,10 @@ public:
   trie_point_iterator<Trie>&
   operator++(int)
   {
-    if (trie_->parent_ != 0) {
-      set_iterator item = trie_->parent_->children_.iterator_to(*trie_);
-      item++;
-      if (item == trie_->parent_->children_.end())
-        trie_ = 0;
-      else
-        trie_ = &*item;
-    }
-    else {
+    if (trie_->parent_ != 0)
+      trie_ = trie_->next_sibling();
+    else
       trie_ = 0;
-    }
     return *this;
   }
 